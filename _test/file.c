@@ -0,0 +1,125 @@
+#include "../fus/file.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* FUS typedefs */
+typedef struct lexer lexer_t;
+typedef struct writer writer_t;
+typedef struct any any_t;
+typedef struct type type_t;
+typedef struct io_file io_file_t;
+
+/* FUS enums */
+enum types {
+    TYPE_ANY,
+    TYPE_TYPE,
+    TYPE_IO_FILE,
+    TYPES
+};
+
+/* FUS structs */
+struct any {
+    type_t *type;
+    int weakref: 1;
+    union {
+        char c; /* byte */
+        bool b; /* bool */
+        int i; /* int, err */
+        const char *s; /* string */
+        void (*fp)(); /* func */
+        void *p; /* everything else */
+    } u;
+};
+struct type {
+    const char *name;
+    /* TODO: tag and union with type's details, e.g. fields */
+    void (*cleanup)(void *it);
+    int (*parse)(void *it, lexer_t *lexer);
+    int (*write)(void *it, writer_t *writer);
+};
+struct io_file {
+    FILE* data;
+};
+
+/* FUS types */
+extern type_t types[TYPES]; /* Indexed by: enum types */
+
+/* FUS function prototypes */
+void any_cleanup(any_t *it);
+void any_cleanup_voidstar(void *it);
+int any_parse(any_t *it, lexer_t *lexer);
+int any_parse_voidstar(void *it, lexer_t *lexer);
+int any_write(any_t *it, writer_t *writer);
+int any_write_voidstar(void *it, writer_t *writer);
+#define type_cleanup (void)
+#define type_cleanup_voidstar (void)
+int type_parse(type_t *it, lexer_t *lexer);
+int type_parse_voidstar(void *it, lexer_t *lexer);
+int type_write(type_t *it, writer_t *writer);
+int type_write_voidstar(void *it, writer_t *writer);
+void io_file_cleanup(io_file_t *it);
+void io_file_cleanup_voidstar(void *it);
+int io_file_parse(io_file_t *it, lexer_t *lexer);
+int io_file_parse_voidstar(void *it, lexer_t *lexer);
+int io_file_write(io_file_t *it, writer_t *writer);
+int io_file_write_voidstar(void *it, writer_t *writer);
+
+/* FUS types */
+type_t types[TYPES] = { /* Indexed by: enum types */
+    {
+        .name = "any",
+        .cleanup = &any_cleanup_voidstar,
+        .parse = &any_parse_voidstar,
+        .write = &any_write_voidstar,
+    }
+    ,{
+        .name = "type",
+        .cleanup = NULL,
+        .parse = &type_parse_voidstar,
+        .write = &type_write_voidstar,
+    }
+    ,{
+        .name = "io_file",
+        .cleanup = &io_file_cleanup_voidstar,
+        .parse = &io_file_parse_voidstar,
+        .write = &io_file_write_voidstar,
+    }
+};
+
+/* FUS function definitions */
+void any_cleanup(any_t *it) {
+    if (!it->type || !it->type->cleanup) return;
+    /* NOTE: we can safely use it->u.p, because types which have
+    a cleanup function are guaranteed to use pointers. */
+    it->type->cleanup(it->u.p);
+}
+void any_cleanup_voidstar(void *it) { any_cleanup((any_t *) it); }
+int any_parse(any_t *it, lexer_t *lexer) {
+}
+int any_parse_voidstar(void *it, lexer_t *lexer) { return any_parse((any_t *) it, lexer); }
+int any_write(any_t *it, writer_t *writer) {
+}
+int any_write_voidstar(void *it, writer_t *writer) { return any_write((any_t *) it, writer); }
+int type_parse(type_t *it, lexer_t *lexer) {
+}
+int type_parse_voidstar(void *it, lexer_t *lexer) { return type_parse((type_t *) it, lexer); }
+int type_write(type_t *it, writer_t *writer) {
+}
+int type_write_voidstar(void *it, writer_t *writer) { return type_write((type_t *) it, writer); }
+void io_file_cleanup(io_file_t *it) {
+    IO_FILE_EXTRA_CLEANUP;
+    memset(it, 0, sizeof(*it));
+}
+void io_file_cleanup_voidstar(void *it) { io_file_cleanup((io_file_t *) it); }
+int io_file_parse(io_file_t *it, lexer_t *lexer) {
+}
+int io_file_parse_voidstar(void *it, lexer_t *lexer) { return io_file_parse((io_file_t *) it, lexer); }
+int io_file_write(io_file_t *it, writer_t *writer) {
+}
+int io_file_write_voidstar(void *it, writer_t *writer) { return io_file_write((io_file_t *) it, writer); }
+
+/* Dummy main */
+int main(int n_args, char **args) { return 0; }
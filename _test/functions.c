@@ -0,0 +1,453 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* FUS typedefs */
+typedef struct lexer lexer_t;
+typedef struct writer writer_t;
+typedef struct any any_t;
+typedef struct type type_t;
+typedef struct functions_dup_ret functions_dup_ret_t;
+typedef functions_dup_ret_t* functions_dup_t(any_t x);
+typedef struct functions_swap_pair functions_swap_pair_t;
+typedef functions_swap_pair_t* functions_swap_t(functions_swap_pair_t* pair);
+typedef struct functions_visit_pair_pair functions_visit_pair_pair_t;
+typedef int /* err */ functions_visit_pair_action_t(functions_visit_pair_pair_t* pair);
+typedef int /* err */ functions_visit_pair_t(functions_visit_pair_pair_t* pair, functions_visit_pair_action_t* action);
+typedef struct functions_grid_cells_elem functions_grid_cells_elem_t;
+typedef struct arrayof_inplace_functions_grid_cells_elem arrayof_inplace_functions_grid_cells_elem_t;
+typedef struct arrayof_arrayof_inplace_functions_grid_cells_elem arrayof_arrayof_inplace_functions_grid_cells_elem_t;
+typedef struct functions_grid functions_grid_t;
+typedef functions_grid_cells_elem_t* functions_grid_get_cell_t(int x, int y);
+typedef int /* err */ functions_grid_get_cell_out_t(int x, int y, functions_grid_cells_elem_t* *cell);
+typedef int /* err */ functions_action_t(const char * name, int i);
+
+/* FUS enums */
+enum types {
+    TYPE_ANY,
+    TYPE_TYPE,
+    TYPE_FUNCTIONS_DUP_RET,
+    TYPE_FUNCTIONS_DUP,
+    TYPE_FUNCTIONS_SWAP_PAIR,
+    TYPE_FUNCTIONS_SWAP,
+    TYPE_FUNCTIONS_VISIT_PAIR_PAIR,
+    TYPE_FUNCTIONS_VISIT_PAIR_ACTION,
+    TYPE_FUNCTIONS_VISIT_PAIR,
+    TYPE_FUNCTIONS_GRID_CELLS_ELEM,
+    TYPE_ARRAYOF_INPLACE_FUNCTIONS_GRID_CELLS_ELEM,
+    TYPE_ARRAYOF_ARRAYOF_INPLACE_FUNCTIONS_GRID_CELLS_ELEM,
+    TYPE_FUNCTIONS_GRID,
+    TYPE_FUNCTIONS_GRID_GET_CELL,
+    TYPE_FUNCTIONS_GRID_GET_CELL_OUT,
+    TYPE_FUNCTIONS_ACTION,
+    TYPES
+};
+
+/* FUS structs */
+struct any {
+    type_t *type;
+    int weakref: 1;
+    union {
+        char c; /* byte */
+        bool b; /* bool */
+        int i; /* int, err */
+        const char *s; /* string */
+        void (*fp)(); /* func */
+        void *p; /* everything else */
+    } u;
+};
+struct type {
+    const char *name;
+    /* TODO: tag and union with type's details, e.g. fields */
+    void (*cleanup)(void *it);
+    int (*parse)(void *it, lexer_t *lexer);
+    int (*write)(void *it, writer_t *writer);
+};
+struct functions_dup_ret {
+    any_t x;
+    any_t y;
+};
+struct functions_swap_pair {
+    any_t x;
+    any_t y;
+};
+struct functions_visit_pair_pair {
+    any_t x;
+    any_t y;
+};
+struct functions_grid_cells_elem {
+    any_t data;
+};
+struct arrayof_inplace_functions_grid_cells_elem {
+    size_t size;
+    size_t len;
+    functions_grid_cells_elem_t *elems;
+};
+struct arrayof_arrayof_inplace_functions_grid_cells_elem {
+    size_t size;
+    size_t len;
+    arrayof_inplace_functions_grid_cells_elem_t *elems;
+};
+struct functions_grid {
+    int w;
+    int h;
+    arrayof_arrayof_inplace_functions_grid_cells_elem_t cells;
+    functions_grid_get_cell_t* get_cell;
+    functions_grid_get_cell_out_t* get_cell_out;
+    functions_action_t* custom_action;
+};
+
+/* FUS types */
+extern type_t types[TYPES]; /* Indexed by: enum types */
+
+/* FUS function prototypes */
+void any_cleanup(any_t *it);
+void any_cleanup_voidstar(void *it);
+int any_parse(any_t *it, lexer_t *lexer);
+int any_parse_voidstar(void *it, lexer_t *lexer);
+int any_write(any_t *it, writer_t *writer);
+int any_write_voidstar(void *it, writer_t *writer);
+#define type_cleanup (void)
+#define type_cleanup_voidstar (void)
+int type_parse(type_t *it, lexer_t *lexer);
+int type_parse_voidstar(void *it, lexer_t *lexer);
+int type_write(type_t *it, writer_t *writer);
+int type_write_voidstar(void *it, writer_t *writer);
+void functions_dup_ret_cleanup(functions_dup_ret_t *it);
+void functions_dup_ret_cleanup_voidstar(void *it);
+int functions_dup_ret_parse(functions_dup_ret_t *it, lexer_t *lexer);
+int functions_dup_ret_parse_voidstar(void *it, lexer_t *lexer);
+int functions_dup_ret_write(functions_dup_ret_t *it, writer_t *writer);
+int functions_dup_ret_write_voidstar(void *it, writer_t *writer);
+#define functions_dup_cleanup (void)
+#define functions_dup_cleanup_voidstar (void)
+int functions_dup_parse(functions_dup_t *it, lexer_t *lexer);
+int functions_dup_parse_voidstar(void *it, lexer_t *lexer);
+int functions_dup_write(functions_dup_t *it, writer_t *writer);
+int functions_dup_write_voidstar(void *it, writer_t *writer);
+void functions_swap_pair_cleanup(functions_swap_pair_t *it);
+void functions_swap_pair_cleanup_voidstar(void *it);
+int functions_swap_pair_parse(functions_swap_pair_t *it, lexer_t *lexer);
+int functions_swap_pair_parse_voidstar(void *it, lexer_t *lexer);
+int functions_swap_pair_write(functions_swap_pair_t *it, writer_t *writer);
+int functions_swap_pair_write_voidstar(void *it, writer_t *writer);
+#define functions_swap_cleanup (void)
+#define functions_swap_cleanup_voidstar (void)
+int functions_swap_parse(functions_swap_t *it, lexer_t *lexer);
+int functions_swap_parse_voidstar(void *it, lexer_t *lexer);
+int functions_swap_write(functions_swap_t *it, writer_t *writer);
+int functions_swap_write_voidstar(void *it, writer_t *writer);
+void functions_visit_pair_pair_cleanup(functions_visit_pair_pair_t *it);
+void functions_visit_pair_pair_cleanup_voidstar(void *it);
+int functions_visit_pair_pair_parse(functions_visit_pair_pair_t *it, lexer_t *lexer);
+int functions_visit_pair_pair_parse_voidstar(void *it, lexer_t *lexer);
+int functions_visit_pair_pair_write(functions_visit_pair_pair_t *it, writer_t *writer);
+int functions_visit_pair_pair_write_voidstar(void *it, writer_t *writer);
+#define functions_visit_pair_action_cleanup (void)
+#define functions_visit_pair_action_cleanup_voidstar (void)
+int functions_visit_pair_action_parse(functions_visit_pair_action_t *it, lexer_t *lexer);
+int functions_visit_pair_action_parse_voidstar(void *it, lexer_t *lexer);
+int functions_visit_pair_action_write(functions_visit_pair_action_t *it, writer_t *writer);
+int functions_visit_pair_action_write_voidstar(void *it, writer_t *writer);
+#define functions_visit_pair_cleanup (void)
+#define functions_visit_pair_cleanup_voidstar (void)
+int functions_visit_pair_parse(functions_visit_pair_t *it, lexer_t *lexer);
+int functions_visit_pair_parse_voidstar(void *it, lexer_t *lexer);
+int functions_visit_pair_write(functions_visit_pair_t *it, writer_t *writer);
+int functions_visit_pair_write_voidstar(void *it, writer_t *writer);
+void functions_grid_cells_elem_cleanup(functions_grid_cells_elem_t *it);
+void functions_grid_cells_elem_cleanup_voidstar(void *it);
+int functions_grid_cells_elem_parse(functions_grid_cells_elem_t *it, lexer_t *lexer);
+int functions_grid_cells_elem_parse_voidstar(void *it, lexer_t *lexer);
+int functions_grid_cells_elem_write(functions_grid_cells_elem_t *it, writer_t *writer);
+int functions_grid_cells_elem_write_voidstar(void *it, writer_t *writer);
+void arrayof_inplace_functions_grid_cells_elem_cleanup(arrayof_inplace_functions_grid_cells_elem_t *it);
+void arrayof_inplace_functions_grid_cells_elem_cleanup_voidstar(void *it);
+int arrayof_inplace_functions_grid_cells_elem_parse(arrayof_inplace_functions_grid_cells_elem_t *it, lexer_t *lexer);
+int arrayof_inplace_functions_grid_cells_elem_parse_voidstar(void *it, lexer_t *lexer);
+int arrayof_inplace_functions_grid_cells_elem_write(arrayof_inplace_functions_grid_cells_elem_t *it, writer_t *writer);
+int arrayof_inplace_functions_grid_cells_elem_write_voidstar(void *it, writer_t *writer);
+void arrayof_arrayof_inplace_functions_grid_cells_elem_cleanup(arrayof_arrayof_inplace_functions_grid_cells_elem_t *it);
+void arrayof_arrayof_inplace_functions_grid_cells_elem_cleanup_voidstar(void *it);
+int arrayof_arrayof_inplace_functions_grid_cells_elem_parse(arrayof_arrayof_inplace_functions_grid_cells_elem_t *it, lexer_t *lexer);
+int arrayof_arrayof_inplace_functions_grid_cells_elem_parse_voidstar(void *it, lexer_t *lexer);
+int arrayof_arrayof_inplace_functions_grid_cells_elem_write(arrayof_arrayof_inplace_functions_grid_cells_elem_t *it, writer_t *writer);
+int arrayof_arrayof_inplace_functions_grid_cells_elem_write_voidstar(void *it, writer_t *writer);
+void functions_grid_cleanup(functions_grid_t *it);
+void functions_grid_cleanup_voidstar(void *it);
+int functions_grid_parse(functions_grid_t *it, lexer_t *lexer);
+int functions_grid_parse_voidstar(void *it, lexer_t *lexer);
+int functions_grid_write(functions_grid_t *it, writer_t *writer);
+int functions_grid_write_voidstar(void *it, writer_t *writer);
+#define functions_grid_get_cell_cleanup (void)
+#define functions_grid_get_cell_cleanup_voidstar (void)
+int functions_grid_get_cell_parse(functions_grid_get_cell_t *it, lexer_t *lexer);
+int functions_grid_get_cell_parse_voidstar(void *it, lexer_t *lexer);
+int functions_grid_get_cell_write(functions_grid_get_cell_t *it, writer_t *writer);
+int functions_grid_get_cell_write_voidstar(void *it, writer_t *writer);
+#define functions_grid_get_cell_out_cleanup (void)
+#define functions_grid_get_cell_out_cleanup_voidstar (void)
+int functions_grid_get_cell_out_parse(functions_grid_get_cell_out_t *it, lexer_t *lexer);
+int functions_grid_get_cell_out_parse_voidstar(void *it, lexer_t *lexer);
+int functions_grid_get_cell_out_write(functions_grid_get_cell_out_t *it, writer_t *writer);
+int functions_grid_get_cell_out_write_voidstar(void *it, writer_t *writer);
+#define functions_action_cleanup (void)
+#define functions_action_cleanup_voidstar (void)
+int functions_action_parse(functions_action_t *it, lexer_t *lexer);
+int functions_action_parse_voidstar(void *it, lexer_t *lexer);
+int functions_action_write(functions_action_t *it, writer_t *writer);
+int functions_action_write_voidstar(void *it, writer_t *writer);
+
+/* FUS types */
+type_t types[TYPES] = { /* Indexed by: enum types */
+    {
+        .name = "any",
+        .cleanup = &any_cleanup_voidstar,
+        .parse = &any_parse_voidstar,
+        .write = &any_write_voidstar,
+    }
+    ,{
+        .name = "type",
+        .cleanup = NULL,
+        .parse = &type_parse_voidstar,
+        .write = &type_write_voidstar,
+    }
+    ,{
+        .name = "functions_dup_ret",
+        .cleanup = &functions_dup_ret_cleanup_voidstar,
+        .parse = &functions_dup_ret_parse_voidstar,
+        .write = &functions_dup_ret_write_voidstar,
+    }
+    ,{
+        .name = "functions_dup",
+        .cleanup = NULL,
+        .parse = &functions_dup_parse_voidstar,
+        .write = &functions_dup_write_voidstar,
+    }
+    ,{
+        .name = "functions_swap_pair",
+        .cleanup = &functions_swap_pair_cleanup_voidstar,
+        .parse = &functions_swap_pair_parse_voidstar,
+        .write = &functions_swap_pair_write_voidstar,
+    }
+    ,{
+        .name = "functions_swap",
+        .cleanup = NULL,
+        .parse = &functions_swap_parse_voidstar,
+        .write = &functions_swap_write_voidstar,
+    }
+    ,{
+        .name = "functions_visit_pair_pair",
+        .cleanup = &functions_visit_pair_pair_cleanup_voidstar,
+        .parse = &functions_visit_pair_pair_parse_voidstar,
+        .write = &functions_visit_pair_pair_write_voidstar,
+    }
+    ,{
+        .name = "functions_visit_pair_action",
+        .cleanup = NULL,
+        .parse = &functions_visit_pair_action_parse_voidstar,
+        .write = &functions_visit_pair_action_write_voidstar,
+    }
+    ,{
+        .name = "functions_visit_pair",
+        .cleanup = NULL,
+        .parse = &functions_visit_pair_parse_voidstar,
+        .write = &functions_visit_pair_write_voidstar,
+    }
+    ,{
+        .name = "functions_grid_cells_elem",
+        .cleanup = &functions_grid_cells_elem_cleanup_voidstar,
+        .parse = &functions_grid_cells_elem_parse_voidstar,
+        .write = &functions_grid_cells_elem_write_voidstar,
+    }
+    ,{
+        .name = "arrayof_inplace_functions_grid_cells_elem",
+        .cleanup = &arrayof_inplace_functions_grid_cells_elem_cleanup_voidstar,
+        .parse = &arrayof_inplace_functions_grid_cells_elem_parse_voidstar,
+        .write = &arrayof_inplace_functions_grid_cells_elem_write_voidstar,
+    }
+    ,{
+        .name = "arrayof_arrayof_inplace_functions_grid_cells_elem",
+        .cleanup = &arrayof_arrayof_inplace_functions_grid_cells_elem_cleanup_voidstar,
+        .parse = &arrayof_arrayof_inplace_functions_grid_cells_elem_parse_voidstar,
+        .write = &arrayof_arrayof_inplace_functions_grid_cells_elem_write_voidstar,
+    }
+    ,{
+        .name = "functions_grid",
+        .cleanup = &functions_grid_cleanup_voidstar,
+        .parse = &functions_grid_parse_voidstar,
+        .write = &functions_grid_write_voidstar,
+    }
+    ,{
+        .name = "functions_grid_get_cell",
+        .cleanup = NULL,
+        .parse = &functions_grid_get_cell_parse_voidstar,
+        .write = &functions_grid_get_cell_write_voidstar,
+    }
+    ,{
+        .name = "functions_grid_get_cell_out",
+        .cleanup = NULL,
+        .parse = &functions_grid_get_cell_out_parse_voidstar,
+        .write = &functions_grid_get_cell_out_write_voidstar,
+    }
+    ,{
+        .name = "functions_action",
+        .cleanup = NULL,
+        .parse = &functions_action_parse_voidstar,
+        .write = &functions_action_write_voidstar,
+    }
+};
+
+/* FUS function definitions */
+void any_cleanup(any_t *it) {
+    if (!it->type || !it->type->cleanup) return;
+    /* NOTE: we can safely use it->u.p, because types which have
+    a cleanup function are guaranteed to use pointers. */
+    it->type->cleanup(it->u.p);
+}
+void any_cleanup_voidstar(void *it) { any_cleanup((any_t *) it); }
+int any_parse(any_t *it, lexer_t *lexer) {
+}
+int any_parse_voidstar(void *it, lexer_t *lexer) { return any_parse((any_t *) it, lexer); }
+int any_write(any_t *it, writer_t *writer) {
+}
+int any_write_voidstar(void *it, writer_t *writer) { return any_write((any_t *) it, writer); }
+int type_parse(type_t *it, lexer_t *lexer) {
+}
+int type_parse_voidstar(void *it, lexer_t *lexer) { return type_parse((type_t *) it, lexer); }
+int type_write(type_t *it, writer_t *writer) {
+}
+int type_write_voidstar(void *it, writer_t *writer) { return type_write((type_t *) it, writer); }
+void functions_dup_ret_cleanup(functions_dup_ret_t *it) {
+    any_cleanup(&it->x);
+    any_cleanup(&it->y);
+    memset(it, 0, sizeof(*it));
+}
+void functions_dup_ret_cleanup_voidstar(void *it) { functions_dup_ret_cleanup((functions_dup_ret_t *) it); }
+int functions_dup_ret_parse(functions_dup_ret_t *it, lexer_t *lexer) {
+}
+int functions_dup_ret_parse_voidstar(void *it, lexer_t *lexer) { return functions_dup_ret_parse((functions_dup_ret_t *) it, lexer); }
+int functions_dup_ret_write(functions_dup_ret_t *it, writer_t *writer) {
+}
+int functions_dup_ret_write_voidstar(void *it, writer_t *writer) { return functions_dup_ret_write((functions_dup_ret_t *) it, writer); }
+int functions_dup_parse(functions_dup_t *it, lexer_t *lexer) {
+}
+int functions_dup_parse_voidstar(void *it, lexer_t *lexer) { return functions_dup_parse((functions_dup_t *) it, lexer); }
+int functions_dup_write(functions_dup_t *it, writer_t *writer) {
+}
+int functions_dup_write_voidstar(void *it, writer_t *writer) { return functions_dup_write((functions_dup_t *) it, writer); }
+void functions_swap_pair_cleanup(functions_swap_pair_t *it) {
+    any_cleanup(&it->x);
+    any_cleanup(&it->y);
+    memset(it, 0, sizeof(*it));
+}
+void functions_swap_pair_cleanup_voidstar(void *it) { functions_swap_pair_cleanup((functions_swap_pair_t *) it); }
+int functions_swap_pair_parse(functions_swap_pair_t *it, lexer_t *lexer) {
+}
+int functions_swap_pair_parse_voidstar(void *it, lexer_t *lexer) { return functions_swap_pair_parse((functions_swap_pair_t *) it, lexer); }
+int functions_swap_pair_write(functions_swap_pair_t *it, writer_t *writer) {
+}
+int functions_swap_pair_write_voidstar(void *it, writer_t *writer) { return functions_swap_pair_write((functions_swap_pair_t *) it, writer); }
+int functions_swap_parse(functions_swap_t *it, lexer_t *lexer) {
+}
+int functions_swap_parse_voidstar(void *it, lexer_t *lexer) { return functions_swap_parse((functions_swap_t *) it, lexer); }
+int functions_swap_write(functions_swap_t *it, writer_t *writer) {
+}
+int functions_swap_write_voidstar(void *it, writer_t *writer) { return functions_swap_write((functions_swap_t *) it, writer); }
+void functions_visit_pair_pair_cleanup(functions_visit_pair_pair_t *it) {
+    any_cleanup(&it->x);
+    any_cleanup(&it->y);
+    memset(it, 0, sizeof(*it));
+}
+void functions_visit_pair_pair_cleanup_voidstar(void *it) { functions_visit_pair_pair_cleanup((functions_visit_pair_pair_t *) it); }
+int functions_visit_pair_pair_parse(functions_visit_pair_pair_t *it, lexer_t *lexer) {
+}
+int functions_visit_pair_pair_parse_voidstar(void *it, lexer_t *lexer) { return functions_visit_pair_pair_parse((functions_visit_pair_pair_t *) it, lexer); }
+int functions_visit_pair_pair_write(functions_visit_pair_pair_t *it, writer_t *writer) {
+}
+int functions_visit_pair_pair_write_voidstar(void *it, writer_t *writer) { return functions_visit_pair_pair_write((functions_visit_pair_pair_t *) it, writer); }
+int functions_visit_pair_action_parse(functions_visit_pair_action_t *it, lexer_t *lexer) {
+}
+int functions_visit_pair_action_parse_voidstar(void *it, lexer_t *lexer) { return functions_visit_pair_action_parse((functions_visit_pair_action_t *) it, lexer); }
+int functions_visit_pair_action_write(functions_visit_pair_action_t *it, writer_t *writer) {
+}
+int functions_visit_pair_action_write_voidstar(void *it, writer_t *writer) { return functions_visit_pair_action_write((functions_visit_pair_action_t *) it, writer); }
+int functions_visit_pair_parse(functions_visit_pair_t *it, lexer_t *lexer) {
+}
+int functions_visit_pair_parse_voidstar(void *it, lexer_t *lexer) { return functions_visit_pair_parse((functions_visit_pair_t *) it, lexer); }
+int functions_visit_pair_write(functions_visit_pair_t *it, writer_t *writer) {
+}
+int functions_visit_pair_write_voidstar(void *it, writer_t *writer) { return functions_visit_pair_write((functions_visit_pair_t *) it, writer); }
+void functions_grid_cells_elem_cleanup(functions_grid_cells_elem_t *it) {
+    any_cleanup(&it->data);
+    memset(it, 0, sizeof(*it));
+}
+void functions_grid_cells_elem_cleanup_voidstar(void *it) { functions_grid_cells_elem_cleanup((functions_grid_cells_elem_t *) it); }
+int functions_grid_cells_elem_parse(functions_grid_cells_elem_t *it, lexer_t *lexer) {
+}
+int functions_grid_cells_elem_parse_voidstar(void *it, lexer_t *lexer) { return functions_grid_cells_elem_parse((functions_grid_cells_elem_t *) it, lexer); }
+int functions_grid_cells_elem_write(functions_grid_cells_elem_t *it, writer_t *writer) {
+}
+int functions_grid_cells_elem_write_voidstar(void *it, writer_t *writer) { return functions_grid_cells_elem_write((functions_grid_cells_elem_t *) it, writer); }
+void arrayof_inplace_functions_grid_cells_elem_cleanup(arrayof_inplace_functions_grid_cells_elem_t *it) {
+    for (int i = 0; i < it->len; i++) {
+        functions_grid_cells_elem_cleanup(&it->elems[i]);
+    }
+    free(it->elems);
+    memset(it, 0, sizeof(*it));
+}
+void arrayof_inplace_functions_grid_cells_elem_cleanup_voidstar(void *it) { arrayof_inplace_functions_grid_cells_elem_cleanup((arrayof_inplace_functions_grid_cells_elem_t *) it); }
+int arrayof_inplace_functions_grid_cells_elem_parse(arrayof_inplace_functions_grid_cells_elem_t *it, lexer_t *lexer) {
+}
+int arrayof_inplace_functions_grid_cells_elem_parse_voidstar(void *it, lexer_t *lexer) { return arrayof_inplace_functions_grid_cells_elem_parse((arrayof_inplace_functions_grid_cells_elem_t *) it, lexer); }
+int arrayof_inplace_functions_grid_cells_elem_write(arrayof_inplace_functions_grid_cells_elem_t *it, writer_t *writer) {
+}
+int arrayof_inplace_functions_grid_cells_elem_write_voidstar(void *it, writer_t *writer) { return arrayof_inplace_functions_grid_cells_elem_write((arrayof_inplace_functions_grid_cells_elem_t *) it, writer); }
+void arrayof_arrayof_inplace_functions_grid_cells_elem_cleanup(arrayof_arrayof_inplace_functions_grid_cells_elem_t *it) {
+    for (int i = 0; i < it->len; i++) {
+        arrayof_inplace_functions_grid_cells_elem_cleanup(&it->elems[i]);
+    }
+    free(it->elems);
+    memset(it, 0, sizeof(*it));
+}
+void arrayof_arrayof_inplace_functions_grid_cells_elem_cleanup_voidstar(void *it) { arrayof_arrayof_inplace_functions_grid_cells_elem_cleanup((arrayof_arrayof_inplace_functions_grid_cells_elem_t *) it); }
+int arrayof_arrayof_inplace_functions_grid_cells_elem_parse(arrayof_arrayof_inplace_functions_grid_cells_elem_t *it, lexer_t *lexer) {
+}
+int arrayof_arrayof_inplace_functions_grid_cells_elem_parse_voidstar(void *it, lexer_t *lexer) { return arrayof_arrayof_inplace_functions_grid_cells_elem_parse((arrayof_arrayof_inplace_functions_grid_cells_elem_t *) it, lexer); }
+int arrayof_arrayof_inplace_functions_grid_cells_elem_write(arrayof_arrayof_inplace_functions_grid_cells_elem_t *it, writer_t *writer) {
+}
+int arrayof_arrayof_inplace_functions_grid_cells_elem_write_voidstar(void *it, writer_t *writer) { return arrayof_arrayof_inplace_functions_grid_cells_elem_write((arrayof_arrayof_inplace_functions_grid_cells_elem_t *) it, writer); }
+void functions_grid_cleanup(functions_grid_t *it) {
+    arrayof_arrayof_inplace_functions_grid_cells_elem_cleanup(&it->cells);
+    memset(it, 0, sizeof(*it));
+}
+void functions_grid_cleanup_voidstar(void *it) { functions_grid_cleanup((functions_grid_t *) it); }
+int functions_grid_parse(functions_grid_t *it, lexer_t *lexer) {
+}
+int functions_grid_parse_voidstar(void *it, lexer_t *lexer) { return functions_grid_parse((functions_grid_t *) it, lexer); }
+int functions_grid_write(functions_grid_t *it, writer_t *writer) {
+}
+int functions_grid_write_voidstar(void *it, writer_t *writer) { return functions_grid_write((functions_grid_t *) it, writer); }
+int functions_grid_get_cell_parse(functions_grid_get_cell_t *it, lexer_t *lexer) {
+}
+int functions_grid_get_cell_parse_voidstar(void *it, lexer_t *lexer) { return functions_grid_get_cell_parse((functions_grid_get_cell_t *) it, lexer); }
+int functions_grid_get_cell_write(functions_grid_get_cell_t *it, writer_t *writer) {
+}
+int functions_grid_get_cell_write_voidstar(void *it, writer_t *writer) { return functions_grid_get_cell_write((functions_grid_get_cell_t *) it, writer); }
+int functions_grid_get_cell_out_parse(functions_grid_get_cell_out_t *it, lexer_t *lexer) {
+}
+int functions_grid_get_cell_out_parse_voidstar(void *it, lexer_t *lexer) { return functions_grid_get_cell_out_parse((functions_grid_get_cell_out_t *) it, lexer); }
+int functions_grid_get_cell_out_write(functions_grid_get_cell_out_t *it, writer_t *writer) {
+}
+int functions_grid_get_cell_out_write_voidstar(void *it, writer_t *writer) { return functions_grid_get_cell_out_write((functions_grid_get_cell_out_t *) it, writer); }
+int functions_action_parse(functions_action_t *it, lexer_t *lexer) {
+}
+int functions_action_parse_voidstar(void *it, lexer_t *lexer) { return functions_action_parse((functions_action_t *) it, lexer); }
+int functions_action_write(functions_action_t *it, writer_t *writer) {
+}
+int functions_action_write_voidstar(void *it, writer_t *writer) { return functions_action_write((functions_action_t *) it, writer); }
+
+/* Dummy main */
+int main(int n_args, char **args) { return 0; }
@@ -0,0 +1,1638 @@
+#include "../fus/geom.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* FUS typedefs */
+typedef struct lexer lexer_t;
+typedef struct writer writer_t;
+typedef struct any any_t;
+typedef struct type type_t;
+typedef _vec_t vec_t;
+typedef _boundbox_t boundbox_t;
+typedef bool flip_t;
+typedef int rot_t;
+typedef struct trf trf_t;
+typedef struct vecspace vecspace_t;
+typedef char /* void */ vecspace_vec_rot_t(vec_t* v, rot_t r);
+typedef char /* void */ vecspace_vec_flip_t(vec_t* v, rot_t r);
+typedef char /* void */ vecspace_vec_render_t(vec_t* v, int *x, int *y);
+typedef struct arrayof_palette_entry arrayof_palette_entry_t;
+typedef struct palette palette_t;
+typedef struct arrayof_palette_entry_keyframe arrayof_palette_entry_keyframe_t;
+typedef struct palette_entry palette_entry_t;
+typedef struct palette_entry_keyframe palette_entry_keyframe_t;
+typedef struct arrayof_prismel_image arrayof_prismel_image_t;
+typedef struct prismel prismel_t;
+typedef struct arrayof_prismel_image_line arrayof_prismel_image_line_t;
+typedef struct prismel_image prismel_image_t;
+typedef struct prismel_image_line prismel_image_line_t;
+typedef struct arrayof_font arrayof_font_t;
+typedef struct arrayof_geomfont arrayof_geomfont_t;
+typedef struct arrayof_prismel arrayof_prismel_t;
+typedef struct arrayof_prismelmapper arrayof_prismelmapper_t;
+typedef struct arrayof_palettemapper arrayof_palettemapper_t;
+typedef struct prismelrenderer prismelrenderer_t;
+typedef struct font font_t;
+typedef struct geomfont geomfont_t;
+typedef struct arrayof_prismelmapper_entry arrayof_prismelmapper_entry_t;
+typedef struct prismelmapper prismelmapper_t;
+typedef struct arrayof_byte arrayof_byte_t;
+typedef struct arrayof_palettemapper_pmapplication arrayof_palettemapper_pmapplication_t;
+typedef struct arrayof_palettemapper_application arrayof_palettemapper_application_t;
+typedef struct palettemapper palettemapper_t;
+typedef struct prismelmapper_entry prismelmapper_entry_t;
+typedef struct arrayof_rendergraph_child arrayof_rendergraph_child_t;
+typedef struct arrayof_rendergraph_frame arrayof_rendergraph_frame_t;
+typedef struct arrayof_rendergraph_bitmap arrayof_rendergraph_bitmap_t;
+typedef struct rendergraph rendergraph_t;
+typedef struct prismelmapper_application prismelmapper_application_t;
+typedef struct prismelmapper_mapplication prismelmapper_mapplication_t;
+typedef struct palettemapper_pmapplication palettemapper_pmapplication_t;
+typedef struct palettemapper_application palettemapper_application_t;
+typedef struct rendergraph_child_type rendergraph_child_type_t;
+typedef struct rendergraph_child rendergraph_child_t;
+typedef struct rendergraph_child_type_prismel rendergraph_child_type_prismel_t;
+typedef struct rendergraph_child_type_rgraph rendergraph_child_type_rgraph_t;
+typedef struct rendergraph_child_type_label rendergraph_child_type_label_t;
+typedef struct arrayof_rendergraph_label arrayof_rendergraph_label_t;
+typedef struct rendergraph_frame rendergraph_frame_t;
+typedef struct rendergraph_label rendergraph_label_t;
+typedef struct rendergraph_bitmap rendergraph_bitmap_t;
+
+/* FUS enums */
+enum types {
+    TYPE_ANY,
+    TYPE_TYPE,
+    TYPE_VEC,
+    TYPE_BOUNDBOX,
+    TYPE_FLIP,
+    TYPE_ROT,
+    TYPE_TRF,
+    TYPE_VECSPACE,
+    TYPE_VECSPACE_VEC_ROT,
+    TYPE_VECSPACE_VEC_FLIP,
+    TYPE_VECSPACE_VEC_RENDER,
+    TYPE_ARRAYOF_PALETTE_ENTRY,
+    TYPE_PALETTE,
+    TYPE_ARRAYOF_PALETTE_ENTRY_KEYFRAME,
+    TYPE_PALETTE_ENTRY,
+    TYPE_PALETTE_ENTRY_KEYFRAME,
+    TYPE_ARRAYOF_PRISMEL_IMAGE,
+    TYPE_PRISMEL,
+    TYPE_ARRAYOF_PRISMEL_IMAGE_LINE,
+    TYPE_PRISMEL_IMAGE,
+    TYPE_PRISMEL_IMAGE_LINE,
+    TYPE_ARRAYOF_FONT,
+    TYPE_ARRAYOF_GEOMFONT,
+    TYPE_ARRAYOF_PRISMEL,
+    TYPE_ARRAYOF_PRISMELMAPPER,
+    TYPE_ARRAYOF_PALETTEMAPPER,
+    TYPE_PRISMELRENDERER,
+    TYPE_FONT,
+    TYPE_GEOMFONT,
+    TYPE_ARRAYOF_PRISMELMAPPER_ENTRY,
+    TYPE_PRISMELMAPPER,
+    TYPE_ARRAYOF_BYTE,
+    TYPE_ARRAYOF_PALETTEMAPPER_PMAPPLICATION,
+    TYPE_ARRAYOF_PALETTEMAPPER_APPLICATION,
+    TYPE_PALETTEMAPPER,
+    TYPE_PRISMELMAPPER_ENTRY,
+    TYPE_ARRAYOF_RENDERGRAPH_CHILD,
+    TYPE_ARRAYOF_RENDERGRAPH_FRAME,
+    TYPE_ARRAYOF_RENDERGRAPH_BITMAP,
+    TYPE_RENDERGRAPH,
+    TYPE_PRISMELMAPPER_APPLICATION,
+    TYPE_PRISMELMAPPER_MAPPLICATION,
+    TYPE_PALETTEMAPPER_PMAPPLICATION,
+    TYPE_PALETTEMAPPER_APPLICATION,
+    TYPE_RENDERGRAPH_CHILD_TYPE,
+    TYPE_RENDERGRAPH_CHILD,
+    TYPE_RENDERGRAPH_CHILD_TYPE_PRISMEL,
+    TYPE_RENDERGRAPH_CHILD_TYPE_RGRAPH,
+    TYPE_RENDERGRAPH_CHILD_TYPE_LABEL,
+    TYPE_ARRAYOF_RENDERGRAPH_LABEL,
+    TYPE_RENDERGRAPH_FRAME,
+    TYPE_RENDERGRAPH_LABEL,
+    TYPE_RENDERGRAPH_BITMAP,
+    TYPES
+};
+enum rendergraph_child_type_tag {
+    RENDERGRAPH_CHILD_TYPE_TAG_PRISMEL,
+    RENDERGRAPH_CHILD_TYPE_TAG_RGRAPH,
+    RENDERGRAPH_CHILD_TYPE_TAG_LABEL,
+    RENDERGRAPH_CHILD_TYPE_TAGS
+};
+
+/* FUS structs */
+struct any {
+    type_t *type;
+    int weakref: 1;
+    union {
+        char c; /* byte */
+        bool b; /* bool */
+        int i; /* int, err */
+        const char *s; /* string */
+        void (*fp)(); /* func */
+        void *p; /* everything else */
+    } u;
+};
+struct type {
+    const char *name;
+    /* TODO: tag and union with type's details, e.g. fields */
+    void (*cleanup)(void *it);
+    int (*parse)(void *it, lexer_t *lexer);
+    int (*write)(void *it, writer_t *writer);
+};
+struct trf {
+    flip_t flip;
+    rot_t rot;
+    vec_t add;
+};
+struct vecspace {
+    int dims;
+    int rot_max;
+    vecspace_vec_rot_t* vec_rot;
+    vecspace_vec_flip_t* vec_flip;
+    vecspace_vec_render_t* vec_render;
+};
+struct arrayof_palette_entry {
+    size_t size;
+    size_t len;
+    palette_entry_t* *elems;
+};
+struct palette {
+    const char * name;
+    arrayof_palette_entry_t entries;
+};
+struct arrayof_palette_entry_keyframe {
+    size_t size;
+    size_t len;
+    palette_entry_keyframe_t* *elems;
+};
+struct palette_entry {
+    int frame_i;
+    int n_frames;
+    int frame_offset;
+    arrayof_palette_entry_keyframe_t keyframes;
+};
+struct palette_entry_keyframe {
+    SDL_Color color;
+    int n_frames;
+};
+struct arrayof_prismel_image {
+    size_t size;
+    size_t len;
+    prismel_image_t* *elems;
+};
+struct prismel {
+    const char * name;
+    arrayof_prismel_image_t images;
+};
+struct arrayof_prismel_image_line {
+    size_t size;
+    size_t len;
+    prismel_image_line_t* *elems;
+};
+struct prismel_image {
+    arrayof_prismel_image_line_t lines;
+};
+struct prismel_image_line {
+    int x;
+    int y;
+    int w;
+};
+struct arrayof_font {
+    size_t size;
+    size_t len;
+    font_t* *elems;
+};
+struct arrayof_geomfont {
+    size_t size;
+    size_t len;
+    geomfont_t* *elems;
+};
+struct arrayof_prismel {
+    size_t size;
+    size_t len;
+    prismel_t* *elems;
+};
+struct arrayof_prismelmapper {
+    size_t size;
+    size_t len;
+    prismelmapper_t* *elems;
+};
+struct arrayof_palettemapper {
+    size_t size;
+    size_t len;
+    palettemapper_t* *elems;
+};
+struct prismelrenderer {
+    bool cache_bitmaps;
+    arrayof_font_t fonts;
+    arrayof_geomfont_t geomfonts;
+    arrayof_prismel_t prismels;
+    arrayof_prismelmapper_t mappers;
+    arrayof_palettemapper_t palmappers;
+    stringstore_t filename_store;
+    stringstore_t name_store;
+    vecspace_t* space;
+};
+struct font {
+    const char * name;
+};
+struct geomfont {
+    const char * name;
+};
+struct arrayof_prismelmapper_entry {
+    size_t size;
+    size_t len;
+    prismelmapper_entry_t* *elems;
+};
+struct prismelmapper {
+    const char * name;
+    vecspace_t* space;
+    vec_t unit;
+    bool solid;
+    arrayof_prismelmapper_entry_t entries;
+    prismelmapper_application_t* applications;
+    prismelmapper_mapplication_t* mapplications;
+};
+struct arrayof_byte {
+    size_t size;
+    size_t len;
+    char *elems;
+};
+struct arrayof_palettemapper_pmapplication {
+    size_t size;
+    size_t len;
+    palettemapper_pmapplication_t* *elems;
+};
+struct arrayof_palettemapper_application {
+    size_t size;
+    size_t len;
+    palettemapper_application_t* *elems;
+};
+struct palettemapper {
+    const char * name;
+    arrayof_byte_t table;
+    arrayof_palettemapper_pmapplication_t pmapplications;
+    arrayof_palettemapper_application_t applications;
+};
+struct prismelmapper_entry {
+    prismel_t* prismel;
+    rendergraph_t* rendergraph;
+};
+struct arrayof_rendergraph_child {
+    size_t size;
+    size_t len;
+    rendergraph_child_t* *elems;
+};
+struct arrayof_rendergraph_frame {
+    size_t size;
+    size_t len;
+    rendergraph_frame_t* *elems;
+};
+struct arrayof_rendergraph_bitmap {
+    size_t size;
+    size_t len;
+    rendergraph_bitmap_t* *elems;
+};
+struct rendergraph {
+    const char * name;
+    arrayof_rendergraph_child_t children;
+    int n_frames;
+    arrayof_rendergraph_frame_t frames;
+    bool labels_calculated;
+    int n_bitmaps;
+    arrayof_rendergraph_bitmap_t bitmaps;
+    boundbox_t boundbox;
+    prismelrenderer_t* prend;
+    vecspace_t* space;
+    const char * animation_type;
+    palettemapper_t* palmapper;
+    rendergraph_t* copy_of;
+};
+struct prismelmapper_application {
+    rendergraph_t* mapped_rgraph;
+    rendergraph_t* resulting_rgraph;
+};
+struct prismelmapper_mapplication {
+    prismelmapper_t* mapped_mapper;
+    prismelmapper_t* resulting_mapper;
+};
+struct palettemapper_pmapplication {
+    palettemapper_t* mapped_mapper;
+    palettemapper_t* resulting_mapper;
+};
+struct palettemapper_application {
+    rendergraph_t* mapped_rgraph;
+    rendergraph_t* resulting_rgraph;
+};
+struct rendergraph_child_type {
+    int tag; /* enum rendergraph_child_type_tag */
+    union {
+        rendergraph_child_type_prismel_t* prismel;
+        rendergraph_child_type_rgraph_t* rgraph;
+        rendergraph_child_type_label_t* label;
+    } u;
+};
+struct rendergraph_child {
+    trf_t trf;
+    int frame_start;
+    int frame_len;
+    rendergraph_child_type_t type;
+};
+struct rendergraph_child_type_prismel {
+    Uint8* color;
+    prismel_t* prismel;
+};
+struct rendergraph_child_type_rgraph {
+    int frame_i;
+    bool frame_i_additive;
+    bool frame_i_reversed;
+    int palmapper_n_applications;
+    rendergraph_t* rendergraph;
+    palettemapper_t* palmapper;
+};
+struct rendergraph_child_type_label {
+    const char * name;
+};
+struct arrayof_rendergraph_label {
+    size_t size;
+    size_t len;
+    rendergraph_label_t* *elems;
+};
+struct rendergraph_frame {
+    arrayof_rendergraph_label_t labels;
+};
+struct rendergraph_label {
+    const char * name;
+    trf_t trf;
+};
+struct rendergraph_bitmap {
+    bool pbox_calculated;
+    position_box_t pbox;
+    SDL_Surface* surface;
+};
+
+/* FUS types */
+extern type_t types[TYPES]; /* Indexed by: enum types */
+
+/* FUS function prototypes */
+void any_cleanup(any_t *it);
+void any_cleanup_voidstar(void *it);
+int any_parse(any_t *it, lexer_t *lexer);
+int any_parse_voidstar(void *it, lexer_t *lexer);
+int any_write(any_t *it, writer_t *writer);
+int any_write_voidstar(void *it, writer_t *writer);
+#define type_cleanup (void)
+#define type_cleanup_voidstar (void)
+int type_parse(type_t *it, lexer_t *lexer);
+int type_parse_voidstar(void *it, lexer_t *lexer);
+int type_write(type_t *it, writer_t *writer);
+int type_write_voidstar(void *it, writer_t *writer);
+#define vec_cleanup (void)
+#define vec_cleanup_voidstar (void)
+int vec_parse(vec_t *it, lexer_t *lexer);
+int vec_parse_voidstar(void *it, lexer_t *lexer);
+int vec_write(vec_t *it, writer_t *writer);
+int vec_write_voidstar(void *it, writer_t *writer);
+#define boundbox_cleanup (void)
+#define boundbox_cleanup_voidstar (void)
+int boundbox_parse(boundbox_t *it, lexer_t *lexer);
+int boundbox_parse_voidstar(void *it, lexer_t *lexer);
+int boundbox_write(boundbox_t *it, writer_t *writer);
+int boundbox_write_voidstar(void *it, writer_t *writer);
+#define flip_cleanup (void)
+#define flip_cleanup_voidstar (void)
+int flip_parse(flip_t *it, lexer_t *lexer);
+int flip_parse_voidstar(void *it, lexer_t *lexer);
+int flip_write(flip_t *it, writer_t *writer);
+int flip_write_voidstar(void *it, writer_t *writer);
+#define rot_cleanup (void)
+#define rot_cleanup_voidstar (void)
+int rot_parse(rot_t *it, lexer_t *lexer);
+int rot_parse_voidstar(void *it, lexer_t *lexer);
+int rot_write(rot_t *it, writer_t *writer);
+int rot_write_voidstar(void *it, writer_t *writer);
+void trf_cleanup(trf_t *it);
+void trf_cleanup_voidstar(void *it);
+int trf_parse(trf_t *it, lexer_t *lexer);
+int trf_parse_voidstar(void *it, lexer_t *lexer);
+int trf_write(trf_t *it, writer_t *writer);
+int trf_write_voidstar(void *it, writer_t *writer);
+void vecspace_cleanup(vecspace_t *it);
+void vecspace_cleanup_voidstar(void *it);
+int vecspace_parse(vecspace_t *it, lexer_t *lexer);
+int vecspace_parse_voidstar(void *it, lexer_t *lexer);
+int vecspace_write(vecspace_t *it, writer_t *writer);
+int vecspace_write_voidstar(void *it, writer_t *writer);
+#define vecspace_vec_rot_cleanup (void)
+#define vecspace_vec_rot_cleanup_voidstar (void)
+int vecspace_vec_rot_parse(vecspace_vec_rot_t *it, lexer_t *lexer);
+int vecspace_vec_rot_parse_voidstar(void *it, lexer_t *lexer);
+int vecspace_vec_rot_write(vecspace_vec_rot_t *it, writer_t *writer);
+int vecspace_vec_rot_write_voidstar(void *it, writer_t *writer);
+#define vecspace_vec_flip_cleanup (void)
+#define vecspace_vec_flip_cleanup_voidstar (void)
+int vecspace_vec_flip_parse(vecspace_vec_flip_t *it, lexer_t *lexer);
+int vecspace_vec_flip_parse_voidstar(void *it, lexer_t *lexer);
+int vecspace_vec_flip_write(vecspace_vec_flip_t *it, writer_t *writer);
+int vecspace_vec_flip_write_voidstar(void *it, writer_t *writer);
+#define vecspace_vec_render_cleanup (void)
+#define vecspace_vec_render_cleanup_voidstar (void)
+int vecspace_vec_render_parse(vecspace_vec_render_t *it, lexer_t *lexer);
+int vecspace_vec_render_parse_voidstar(void *it, lexer_t *lexer);
+int vecspace_vec_render_write(vecspace_vec_render_t *it, writer_t *writer);
+int vecspace_vec_render_write_voidstar(void *it, writer_t *writer);
+void arrayof_palette_entry_cleanup(arrayof_palette_entry_t *it);
+void arrayof_palette_entry_cleanup_voidstar(void *it);
+int arrayof_palette_entry_parse(arrayof_palette_entry_t *it, lexer_t *lexer);
+int arrayof_palette_entry_parse_voidstar(void *it, lexer_t *lexer);
+int arrayof_palette_entry_write(arrayof_palette_entry_t *it, writer_t *writer);
+int arrayof_palette_entry_write_voidstar(void *it, writer_t *writer);
+void palette_cleanup(palette_t *it);
+void palette_cleanup_voidstar(void *it);
+int palette_parse(palette_t *it, lexer_t *lexer);
+int palette_parse_voidstar(void *it, lexer_t *lexer);
+int palette_write(palette_t *it, writer_t *writer);
+int palette_write_voidstar(void *it, writer_t *writer);
+void arrayof_palette_entry_keyframe_cleanup(arrayof_palette_entry_keyframe_t *it);
+void arrayof_palette_entry_keyframe_cleanup_voidstar(void *it);
+int arrayof_palette_entry_keyframe_parse(arrayof_palette_entry_keyframe_t *it, lexer_t *lexer);
+int arrayof_palette_entry_keyframe_parse_voidstar(void *it, lexer_t *lexer);
+int arrayof_palette_entry_keyframe_write(arrayof_palette_entry_keyframe_t *it, writer_t *writer);
+int arrayof_palette_entry_keyframe_write_voidstar(void *it, writer_t *writer);
+void palette_entry_cleanup(palette_entry_t *it);
+void palette_entry_cleanup_voidstar(void *it);
+int palette_entry_parse(palette_entry_t *it, lexer_t *lexer);
+int palette_entry_parse_voidstar(void *it, lexer_t *lexer);
+int palette_entry_write(palette_entry_t *it, writer_t *writer);
+int palette_entry_write_voidstar(void *it, writer_t *writer);
+void palette_entry_keyframe_cleanup(palette_entry_keyframe_t *it);
+void palette_entry_keyframe_cleanup_voidstar(void *it);
+int palette_entry_keyframe_parse(palette_entry_keyframe_t *it, lexer_t *lexer);
+int palette_entry_keyframe_parse_voidstar(void *it, lexer_t *lexer);
+int palette_entry_keyframe_write(palette_entry_keyframe_t *it, writer_t *writer);
+int palette_entry_keyframe_write_voidstar(void *it, writer_t *writer);
+void arrayof_prismel_image_cleanup(arrayof_prismel_image_t *it);
+void arrayof_prismel_image_cleanup_voidstar(void *it);
+int arrayof_prismel_image_parse(arrayof_prismel_image_t *it, lexer_t *lexer);
+int arrayof_prismel_image_parse_voidstar(void *it, lexer_t *lexer);
+int arrayof_prismel_image_write(arrayof_prismel_image_t *it, writer_t *writer);
+int arrayof_prismel_image_write_voidstar(void *it, writer_t *writer);
+void prismel_cleanup(prismel_t *it);
+void prismel_cleanup_voidstar(void *it);
+int prismel_parse(prismel_t *it, lexer_t *lexer);
+int prismel_parse_voidstar(void *it, lexer_t *lexer);
+int prismel_write(prismel_t *it, writer_t *writer);
+int prismel_write_voidstar(void *it, writer_t *writer);
+void arrayof_prismel_image_line_cleanup(arrayof_prismel_image_line_t *it);
+void arrayof_prismel_image_line_cleanup_voidstar(void *it);
+int arrayof_prismel_image_line_parse(arrayof_prismel_image_line_t *it, lexer_t *lexer);
+int arrayof_prismel_image_line_parse_voidstar(void *it, lexer_t *lexer);
+int arrayof_prismel_image_line_write(arrayof_prismel_image_line_t *it, writer_t *writer);
+int arrayof_prismel_image_line_write_voidstar(void *it, writer_t *writer);
+void prismel_image_cleanup(prismel_image_t *it);
+void prismel_image_cleanup_voidstar(void *it);
+int prismel_image_parse(prismel_image_t *it, lexer_t *lexer);
+int prismel_image_parse_voidstar(void *it, lexer_t *lexer);
+int prismel_image_write(prismel_image_t *it, writer_t *writer);
+int prismel_image_write_voidstar(void *it, writer_t *writer);
+void prismel_image_line_cleanup(prismel_image_line_t *it);
+void prismel_image_line_cleanup_voidstar(void *it);
+int prismel_image_line_parse(prismel_image_line_t *it, lexer_t *lexer);
+int prismel_image_line_parse_voidstar(void *it, lexer_t *lexer);
+int prismel_image_line_write(prismel_image_line_t *it, writer_t *writer);
+int prismel_image_line_write_voidstar(void *it, writer_t *writer);
+void arrayof_font_cleanup(arrayof_font_t *it);
+void arrayof_font_cleanup_voidstar(void *it);
+int arrayof_font_parse(arrayof_font_t *it, lexer_t *lexer);
+int arrayof_font_parse_voidstar(void *it, lexer_t *lexer);
+int arrayof_font_write(arrayof_font_t *it, writer_t *writer);
+int arrayof_font_write_voidstar(void *it, writer_t *writer);
+void arrayof_geomfont_cleanup(arrayof_geomfont_t *it);
+void arrayof_geomfont_cleanup_voidstar(void *it);
+int arrayof_geomfont_parse(arrayof_geomfont_t *it, lexer_t *lexer);
+int arrayof_geomfont_parse_voidstar(void *it, lexer_t *lexer);
+int arrayof_geomfont_write(arrayof_geomfont_t *it, writer_t *writer);
+int arrayof_geomfont_write_voidstar(void *it, writer_t *writer);
+void arrayof_prismel_cleanup(arrayof_prismel_t *it);
+void arrayof_prismel_cleanup_voidstar(void *it);
+int arrayof_prismel_parse(arrayof_prismel_t *it, lexer_t *lexer);
+int arrayof_prismel_parse_voidstar(void *it, lexer_t *lexer);
+int arrayof_prismel_write(arrayof_prismel_t *it, writer_t *writer);
+int arrayof_prismel_write_voidstar(void *it, writer_t *writer);
+void arrayof_prismelmapper_cleanup(arrayof_prismelmapper_t *it);
+void arrayof_prismelmapper_cleanup_voidstar(void *it);
+int arrayof_prismelmapper_parse(arrayof_prismelmapper_t *it, lexer_t *lexer);
+int arrayof_prismelmapper_parse_voidstar(void *it, lexer_t *lexer);
+int arrayof_prismelmapper_write(arrayof_prismelmapper_t *it, writer_t *writer);
+int arrayof_prismelmapper_write_voidstar(void *it, writer_t *writer);
+void arrayof_palettemapper_cleanup(arrayof_palettemapper_t *it);
+void arrayof_palettemapper_cleanup_voidstar(void *it);
+int arrayof_palettemapper_parse(arrayof_palettemapper_t *it, lexer_t *lexer);
+int arrayof_palettemapper_parse_voidstar(void *it, lexer_t *lexer);
+int arrayof_palettemapper_write(arrayof_palettemapper_t *it, writer_t *writer);
+int arrayof_palettemapper_write_voidstar(void *it, writer_t *writer);
+void prismelrenderer_cleanup(prismelrenderer_t *it);
+void prismelrenderer_cleanup_voidstar(void *it);
+int prismelrenderer_parse(prismelrenderer_t *it, lexer_t *lexer);
+int prismelrenderer_parse_voidstar(void *it, lexer_t *lexer);
+int prismelrenderer_write(prismelrenderer_t *it, writer_t *writer);
+int prismelrenderer_write_voidstar(void *it, writer_t *writer);
+void font_cleanup(font_t *it);
+void font_cleanup_voidstar(void *it);
+int font_parse(font_t *it, lexer_t *lexer);
+int font_parse_voidstar(void *it, lexer_t *lexer);
+int font_write(font_t *it, writer_t *writer);
+int font_write_voidstar(void *it, writer_t *writer);
+void geomfont_cleanup(geomfont_t *it);
+void geomfont_cleanup_voidstar(void *it);
+int geomfont_parse(geomfont_t *it, lexer_t *lexer);
+int geomfont_parse_voidstar(void *it, lexer_t *lexer);
+int geomfont_write(geomfont_t *it, writer_t *writer);
+int geomfont_write_voidstar(void *it, writer_t *writer);
+void arrayof_prismelmapper_entry_cleanup(arrayof_prismelmapper_entry_t *it);
+void arrayof_prismelmapper_entry_cleanup_voidstar(void *it);
+int arrayof_prismelmapper_entry_parse(arrayof_prismelmapper_entry_t *it, lexer_t *lexer);
+int arrayof_prismelmapper_entry_parse_voidstar(void *it, lexer_t *lexer);
+int arrayof_prismelmapper_entry_write(arrayof_prismelmapper_entry_t *it, writer_t *writer);
+int arrayof_prismelmapper_entry_write_voidstar(void *it, writer_t *writer);
+void prismelmapper_cleanup(prismelmapper_t *it);
+void prismelmapper_cleanup_voidstar(void *it);
+int prismelmapper_parse(prismelmapper_t *it, lexer_t *lexer);
+int prismelmapper_parse_voidstar(void *it, lexer_t *lexer);
+int prismelmapper_write(prismelmapper_t *it, writer_t *writer);
+int prismelmapper_write_voidstar(void *it, writer_t *writer);
+void arrayof_byte_cleanup(arrayof_byte_t *it);
+void arrayof_byte_cleanup_voidstar(void *it);
+int arrayof_byte_parse(arrayof_byte_t *it, lexer_t *lexer);
+int arrayof_byte_parse_voidstar(void *it, lexer_t *lexer);
+int arrayof_byte_write(arrayof_byte_t *it, writer_t *writer);
+int arrayof_byte_write_voidstar(void *it, writer_t *writer);
+void arrayof_palettemapper_pmapplication_cleanup(arrayof_palettemapper_pmapplication_t *it);
+void arrayof_palettemapper_pmapplication_cleanup_voidstar(void *it);
+int arrayof_palettemapper_pmapplication_parse(arrayof_palettemapper_pmapplication_t *it, lexer_t *lexer);
+int arrayof_palettemapper_pmapplication_parse_voidstar(void *it, lexer_t *lexer);
+int arrayof_palettemapper_pmapplication_write(arrayof_palettemapper_pmapplication_t *it, writer_t *writer);
+int arrayof_palettemapper_pmapplication_write_voidstar(void *it, writer_t *writer);
+void arrayof_palettemapper_application_cleanup(arrayof_palettemapper_application_t *it);
+void arrayof_palettemapper_application_cleanup_voidstar(void *it);
+int arrayof_palettemapper_application_parse(arrayof_palettemapper_application_t *it, lexer_t *lexer);
+int arrayof_palettemapper_application_parse_voidstar(void *it, lexer_t *lexer);
+int arrayof_palettemapper_application_write(arrayof_palettemapper_application_t *it, writer_t *writer);
+int arrayof_palettemapper_application_write_voidstar(void *it, writer_t *writer);
+void palettemapper_cleanup(palettemapper_t *it);
+void palettemapper_cleanup_voidstar(void *it);
+int palettemapper_parse(palettemapper_t *it, lexer_t *lexer);
+int palettemapper_parse_voidstar(void *it, lexer_t *lexer);
+int palettemapper_write(palettemapper_t *it, writer_t *writer);
+int palettemapper_write_voidstar(void *it, writer_t *writer);
+void prismelmapper_entry_cleanup(prismelmapper_entry_t *it);
+void prismelmapper_entry_cleanup_voidstar(void *it);
+int prismelmapper_entry_parse(prismelmapper_entry_t *it, lexer_t *lexer);
+int prismelmapper_entry_parse_voidstar(void *it, lexer_t *lexer);
+int prismelmapper_entry_write(prismelmapper_entry_t *it, writer_t *writer);
+int prismelmapper_entry_write_voidstar(void *it, writer_t *writer);
+void arrayof_rendergraph_child_cleanup(arrayof_rendergraph_child_t *it);
+void arrayof_rendergraph_child_cleanup_voidstar(void *it);
+int arrayof_rendergraph_child_parse(arrayof_rendergraph_child_t *it, lexer_t *lexer);
+int arrayof_rendergraph_child_parse_voidstar(void *it, lexer_t *lexer);
+int arrayof_rendergraph_child_write(arrayof_rendergraph_child_t *it, writer_t *writer);
+int arrayof_rendergraph_child_write_voidstar(void *it, writer_t *writer);
+void arrayof_rendergraph_frame_cleanup(arrayof_rendergraph_frame_t *it);
+void arrayof_rendergraph_frame_cleanup_voidstar(void *it);
+int arrayof_rendergraph_frame_parse(arrayof_rendergraph_frame_t *it, lexer_t *lexer);
+int arrayof_rendergraph_frame_parse_voidstar(void *it, lexer_t *lexer);
+int arrayof_rendergraph_frame_write(arrayof_rendergraph_frame_t *it, writer_t *writer);
+int arrayof_rendergraph_frame_write_voidstar(void *it, writer_t *writer);
+void arrayof_rendergraph_bitmap_cleanup(arrayof_rendergraph_bitmap_t *it);
+void arrayof_rendergraph_bitmap_cleanup_voidstar(void *it);
+int arrayof_rendergraph_bitmap_parse(arrayof_rendergraph_bitmap_t *it, lexer_t *lexer);
+int arrayof_rendergraph_bitmap_parse_voidstar(void *it, lexer_t *lexer);
+int arrayof_rendergraph_bitmap_write(arrayof_rendergraph_bitmap_t *it, writer_t *writer);
+int arrayof_rendergraph_bitmap_write_voidstar(void *it, writer_t *writer);
+void rendergraph_cleanup(rendergraph_t *it);
+void rendergraph_cleanup_voidstar(void *it);
+int rendergraph_parse(rendergraph_t *it, lexer_t *lexer);
+int rendergraph_parse_voidstar(void *it, lexer_t *lexer);
+int rendergraph_write(rendergraph_t *it, writer_t *writer);
+int rendergraph_write_voidstar(void *it, writer_t *writer);
+void prismelmapper_application_cleanup(prismelmapper_application_t *it);
+void prismelmapper_application_cleanup_voidstar(void *it);
+int prismelmapper_application_parse(prismelmapper_application_t *it, lexer_t *lexer);
+int prismelmapper_application_parse_voidstar(void *it, lexer_t *lexer);
+int prismelmapper_application_write(prismelmapper_application_t *it, writer_t *writer);
+int prismelmapper_application_write_voidstar(void *it, writer_t *writer);
+void prismelmapper_mapplication_cleanup(prismelmapper_mapplication_t *it);
+void prismelmapper_mapplication_cleanup_voidstar(void *it);
+int prismelmapper_mapplication_parse(prismelmapper_mapplication_t *it, lexer_t *lexer);
+int prismelmapper_mapplication_parse_voidstar(void *it, lexer_t *lexer);
+int prismelmapper_mapplication_write(prismelmapper_mapplication_t *it, writer_t *writer);
+int prismelmapper_mapplication_write_voidstar(void *it, writer_t *writer);
+void palettemapper_pmapplication_cleanup(palettemapper_pmapplication_t *it);
+void palettemapper_pmapplication_cleanup_voidstar(void *it);
+int palettemapper_pmapplication_parse(palettemapper_pmapplication_t *it, lexer_t *lexer);
+int palettemapper_pmapplication_parse_voidstar(void *it, lexer_t *lexer);
+int palettemapper_pmapplication_write(palettemapper_pmapplication_t *it, writer_t *writer);
+int palettemapper_pmapplication_write_voidstar(void *it, writer_t *writer);
+void palettemapper_application_cleanup(palettemapper_application_t *it);
+void palettemapper_application_cleanup_voidstar(void *it);
+int palettemapper_application_parse(palettemapper_application_t *it, lexer_t *lexer);
+int palettemapper_application_parse_voidstar(void *it, lexer_t *lexer);
+int palettemapper_application_write(palettemapper_application_t *it, writer_t *writer);
+int palettemapper_application_write_voidstar(void *it, writer_t *writer);
+static const char *rendergraph_child_type_tag_string(int tag /* enum rendergraph_child_type_tag */) {
+    switch (tag) {
+        case RENDERGRAPH_CHILD_TYPE_TAG_PRISMEL: return "RENDERGRAPH_CHILD_TYPE_TAG_PRISMEL";
+        case RENDERGRAPH_CHILD_TYPE_TAG_RGRAPH: return "RENDERGRAPH_CHILD_TYPE_TAG_RGRAPH";
+        case RENDERGRAPH_CHILD_TYPE_TAG_LABEL: return "RENDERGRAPH_CHILD_TYPE_TAG_LABEL";
+        default: return "__unknown__";
+    }
+}
+void rendergraph_child_type_cleanup(rendergraph_child_type_t *it);
+void rendergraph_child_type_cleanup_voidstar(void *it);
+int rendergraph_child_type_parse(rendergraph_child_type_t *it, lexer_t *lexer);
+int rendergraph_child_type_parse_voidstar(void *it, lexer_t *lexer);
+int rendergraph_child_type_write(rendergraph_child_type_t *it, writer_t *writer);
+int rendergraph_child_type_write_voidstar(void *it, writer_t *writer);
+void rendergraph_child_cleanup(rendergraph_child_t *it);
+void rendergraph_child_cleanup_voidstar(void *it);
+int rendergraph_child_parse(rendergraph_child_t *it, lexer_t *lexer);
+int rendergraph_child_parse_voidstar(void *it, lexer_t *lexer);
+int rendergraph_child_write(rendergraph_child_t *it, writer_t *writer);
+int rendergraph_child_write_voidstar(void *it, writer_t *writer);
+void rendergraph_child_type_prismel_cleanup(rendergraph_child_type_prismel_t *it);
+void rendergraph_child_type_prismel_cleanup_voidstar(void *it);
+int rendergraph_child_type_prismel_parse(rendergraph_child_type_prismel_t *it, lexer_t *lexer);
+int rendergraph_child_type_prismel_parse_voidstar(void *it, lexer_t *lexer);
+int rendergraph_child_type_prismel_write(rendergraph_child_type_prismel_t *it, writer_t *writer);
+int rendergraph_child_type_prismel_write_voidstar(void *it, writer_t *writer);
+void rendergraph_child_type_rgraph_cleanup(rendergraph_child_type_rgraph_t *it);
+void rendergraph_child_type_rgraph_cleanup_voidstar(void *it);
+int rendergraph_child_type_rgraph_parse(rendergraph_child_type_rgraph_t *it, lexer_t *lexer);
+int rendergraph_child_type_rgraph_parse_voidstar(void *it, lexer_t *lexer);
+int rendergraph_child_type_rgraph_write(rendergraph_child_type_rgraph_t *it, writer_t *writer);
+int rendergraph_child_type_rgraph_write_voidstar(void *it, writer_t *writer);
+void rendergraph_child_type_label_cleanup(rendergraph_child_type_label_t *it);
+void rendergraph_child_type_label_cleanup_voidstar(void *it);
+int rendergraph_child_type_label_parse(rendergraph_child_type_label_t *it, lexer_t *lexer);
+int rendergraph_child_type_label_parse_voidstar(void *it, lexer_t *lexer);
+int rendergraph_child_type_label_write(rendergraph_child_type_label_t *it, writer_t *writer);
+int rendergraph_child_type_label_write_voidstar(void *it, writer_t *writer);
+void arrayof_rendergraph_label_cleanup(arrayof_rendergraph_label_t *it);
+void arrayof_rendergraph_label_cleanup_voidstar(void *it);
+int arrayof_rendergraph_label_parse(arrayof_rendergraph_label_t *it, lexer_t *lexer);
+int arrayof_rendergraph_label_parse_voidstar(void *it, lexer_t *lexer);
+int arrayof_rendergraph_label_write(arrayof_rendergraph_label_t *it, writer_t *writer);
+int arrayof_rendergraph_label_write_voidstar(void *it, writer_t *writer);
+void rendergraph_frame_cleanup(rendergraph_frame_t *it);
+void rendergraph_frame_cleanup_voidstar(void *it);
+int rendergraph_frame_parse(rendergraph_frame_t *it, lexer_t *lexer);
+int rendergraph_frame_parse_voidstar(void *it, lexer_t *lexer);
+int rendergraph_frame_write(rendergraph_frame_t *it, writer_t *writer);
+int rendergraph_frame_write_voidstar(void *it, writer_t *writer);
+void rendergraph_label_cleanup(rendergraph_label_t *it);
+void rendergraph_label_cleanup_voidstar(void *it);
+int rendergraph_label_parse(rendergraph_label_t *it, lexer_t *lexer);
+int rendergraph_label_parse_voidstar(void *it, lexer_t *lexer);
+int rendergraph_label_write(rendergraph_label_t *it, writer_t *writer);
+int rendergraph_label_write_voidstar(void *it, writer_t *writer);
+void rendergraph_bitmap_cleanup(rendergraph_bitmap_t *it);
+void rendergraph_bitmap_cleanup_voidstar(void *it);
+int rendergraph_bitmap_parse(rendergraph_bitmap_t *it, lexer_t *lexer);
+int rendergraph_bitmap_parse_voidstar(void *it, lexer_t *lexer);
+int rendergraph_bitmap_write(rendergraph_bitmap_t *it, writer_t *writer);
+int rendergraph_bitmap_write_voidstar(void *it, writer_t *writer);
+
+/* FUS types */
+type_t types[TYPES] = { /* Indexed by: enum types */
+    {
+        .name = "any",
+        .cleanup = &any_cleanup_voidstar,
+        .parse = &any_parse_voidstar,
+        .write = &any_write_voidstar,
+    }
+    ,{
+        .name = "type",
+        .cleanup = NULL,
+        .parse = &type_parse_voidstar,
+        .write = &type_write_voidstar,
+    }
+    ,{
+        .name = "vec",
+        .cleanup = NULL,
+        .parse = &vec_parse_voidstar,
+        .write = &vec_write_voidstar,
+    }
+    ,{
+        .name = "boundbox",
+        .cleanup = NULL,
+        .parse = &boundbox_parse_voidstar,
+        .write = &boundbox_write_voidstar,
+    }
+    ,{
+        .name = "flip",
+        .cleanup = NULL,
+        .parse = &flip_parse_voidstar,
+        .write = &flip_write_voidstar,
+    }
+    ,{
+        .name = "rot",
+        .cleanup = NULL,
+        .parse = &rot_parse_voidstar,
+        .write = &rot_write_voidstar,
+    }
+    ,{
+        .name = "trf",
+        .cleanup = &trf_cleanup_voidstar,
+        .parse = &trf_parse_voidstar,
+        .write = &trf_write_voidstar,
+    }
+    ,{
+        .name = "vecspace",
+        .cleanup = &vecspace_cleanup_voidstar,
+        .parse = &vecspace_parse_voidstar,
+        .write = &vecspace_write_voidstar,
+    }
+    ,{
+        .name = "vecspace_vec_rot",
+        .cleanup = NULL,
+        .parse = &vecspace_vec_rot_parse_voidstar,
+        .write = &vecspace_vec_rot_write_voidstar,
+    }
+    ,{
+        .name = "vecspace_vec_flip",
+        .cleanup = NULL,
+        .parse = &vecspace_vec_flip_parse_voidstar,
+        .write = &vecspace_vec_flip_write_voidstar,
+    }
+    ,{
+        .name = "vecspace_vec_render",
+        .cleanup = NULL,
+        .parse = &vecspace_vec_render_parse_voidstar,
+        .write = &vecspace_vec_render_write_voidstar,
+    }
+    ,{
+        .name = "arrayof_palette_entry",
+        .cleanup = &arrayof_palette_entry_cleanup_voidstar,
+        .parse = &arrayof_palette_entry_parse_voidstar,
+        .write = &arrayof_palette_entry_write_voidstar,
+    }
+    ,{
+        .name = "palette",
+        .cleanup = &palette_cleanup_voidstar,
+        .parse = &palette_parse_voidstar,
+        .write = &palette_write_voidstar,
+    }
+    ,{
+        .name = "arrayof_palette_entry_keyframe",
+        .cleanup = &arrayof_palette_entry_keyframe_cleanup_voidstar,
+        .parse = &arrayof_palette_entry_keyframe_parse_voidstar,
+        .write = &arrayof_palette_entry_keyframe_write_voidstar,
+    }
+    ,{
+        .name = "palette_entry",
+        .cleanup = &palette_entry_cleanup_voidstar,
+        .parse = &palette_entry_parse_voidstar,
+        .write = &palette_entry_write_voidstar,
+    }
+    ,{
+        .name = "palette_entry_keyframe",
+        .cleanup = &palette_entry_keyframe_cleanup_voidstar,
+        .parse = &palette_entry_keyframe_parse_voidstar,
+        .write = &palette_entry_keyframe_write_voidstar,
+    }
+    ,{
+        .name = "arrayof_prismel_image",
+        .cleanup = &arrayof_prismel_image_cleanup_voidstar,
+        .parse = &arrayof_prismel_image_parse_voidstar,
+        .write = &arrayof_prismel_image_write_voidstar,
+    }
+    ,{
+        .name = "prismel",
+        .cleanup = &prismel_cleanup_voidstar,
+        .parse = &prismel_parse_voidstar,
+        .write = &prismel_write_voidstar,
+    }
+    ,{
+        .name = "arrayof_prismel_image_line",
+        .cleanup = &arrayof_prismel_image_line_cleanup_voidstar,
+        .parse = &arrayof_prismel_image_line_parse_voidstar,
+        .write = &arrayof_prismel_image_line_write_voidstar,
+    }
+    ,{
+        .name = "prismel_image",
+        .cleanup = &prismel_image_cleanup_voidstar,
+        .parse = &prismel_image_parse_voidstar,
+        .write = &prismel_image_write_voidstar,
+    }
+    ,{
+        .name = "prismel_image_line",
+        .cleanup = &prismel_image_line_cleanup_voidstar,
+        .parse = &prismel_image_line_parse_voidstar,
+        .write = &prismel_image_line_write_voidstar,
+    }
+    ,{
+        .name = "arrayof_font",
+        .cleanup = &arrayof_font_cleanup_voidstar,
+        .parse = &arrayof_font_parse_voidstar,
+        .write = &arrayof_font_write_voidstar,
+    }
+    ,{
+        .name = "arrayof_geomfont",
+        .cleanup = &arrayof_geomfont_cleanup_voidstar,
+        .parse = &arrayof_geomfont_parse_voidstar,
+        .write = &arrayof_geomfont_write_voidstar,
+    }
+    ,{
+        .name = "arrayof_prismel",
+        .cleanup = &arrayof_prismel_cleanup_voidstar,
+        .parse = &arrayof_prismel_parse_voidstar,
+        .write = &arrayof_prismel_write_voidstar,
+    }
+    ,{
+        .name = "arrayof_prismelmapper",
+        .cleanup = &arrayof_prismelmapper_cleanup_voidstar,
+        .parse = &arrayof_prismelmapper_parse_voidstar,
+        .write = &arrayof_prismelmapper_write_voidstar,
+    }
+    ,{
+        .name = "arrayof_palettemapper",
+        .cleanup = &arrayof_palettemapper_cleanup_voidstar,
+        .parse = &arrayof_palettemapper_parse_voidstar,
+        .write = &arrayof_palettemapper_write_voidstar,
+    }
+    ,{
+        .name = "prismelrenderer",
+        .cleanup = &prismelrenderer_cleanup_voidstar,
+        .parse = &prismelrenderer_parse_voidstar,
+        .write = &prismelrenderer_write_voidstar,
+    }
+    ,{
+        .name = "font",
+        .cleanup = &font_cleanup_voidstar,
+        .parse = &font_parse_voidstar,
+        .write = &font_write_voidstar,
+    }
+    ,{
+        .name = "geomfont",
+        .cleanup = &geomfont_cleanup_voidstar,
+        .parse = &geomfont_parse_voidstar,
+        .write = &geomfont_write_voidstar,
+    }
+    ,{
+        .name = "arrayof_prismelmapper_entry",
+        .cleanup = &arrayof_prismelmapper_entry_cleanup_voidstar,
+        .parse = &arrayof_prismelmapper_entry_parse_voidstar,
+        .write = &arrayof_prismelmapper_entry_write_voidstar,
+    }
+    ,{
+        .name = "prismelmapper",
+        .cleanup = &prismelmapper_cleanup_voidstar,
+        .parse = &prismelmapper_parse_voidstar,
+        .write = &prismelmapper_write_voidstar,
+    }
+    ,{
+        .name = "arrayof_byte",
+        .cleanup = &arrayof_byte_cleanup_voidstar,
+        .parse = &arrayof_byte_parse_voidstar,
+        .write = &arrayof_byte_write_voidstar,
+    }
+    ,{
+        .name = "arrayof_palettemapper_pmapplication",
+        .cleanup = &arrayof_palettemapper_pmapplication_cleanup_voidstar,
+        .parse = &arrayof_palettemapper_pmapplication_parse_voidstar,
+        .write = &arrayof_palettemapper_pmapplication_write_voidstar,
+    }
+    ,{
+        .name = "arrayof_palettemapper_application",
+        .cleanup = &arrayof_palettemapper_application_cleanup_voidstar,
+        .parse = &arrayof_palettemapper_application_parse_voidstar,
+        .write = &arrayof_palettemapper_application_write_voidstar,
+    }
+    ,{
+        .name = "palettemapper",
+        .cleanup = &palettemapper_cleanup_voidstar,
+        .parse = &palettemapper_parse_voidstar,
+        .write = &palettemapper_write_voidstar,
+    }
+    ,{
+        .name = "prismelmapper_entry",
+        .cleanup = &prismelmapper_entry_cleanup_voidstar,
+        .parse = &prismelmapper_entry_parse_voidstar,
+        .write = &prismelmapper_entry_write_voidstar,
+    }
+    ,{
+        .name = "arrayof_rendergraph_child",
+        .cleanup = &arrayof_rendergraph_child_cleanup_voidstar,
+        .parse = &arrayof_rendergraph_child_parse_voidstar,
+        .write = &arrayof_rendergraph_child_write_voidstar,
+    }
+    ,{
+        .name = "arrayof_rendergraph_frame",
+        .cleanup = &arrayof_rendergraph_frame_cleanup_voidstar,
+        .parse = &arrayof_rendergraph_frame_parse_voidstar,
+        .write = &arrayof_rendergraph_frame_write_voidstar,
+    }
+    ,{
+        .name = "arrayof_rendergraph_bitmap",
+        .cleanup = &arrayof_rendergraph_bitmap_cleanup_voidstar,
+        .parse = &arrayof_rendergraph_bitmap_parse_voidstar,
+        .write = &arrayof_rendergraph_bitmap_write_voidstar,
+    }
+    ,{
+        .name = "rendergraph",
+        .cleanup = &rendergraph_cleanup_voidstar,
+        .parse = &rendergraph_parse_voidstar,
+        .write = &rendergraph_write_voidstar,
+    }
+    ,{
+        .name = "prismelmapper_application",
+        .cleanup = &prismelmapper_application_cleanup_voidstar,
+        .parse = &prismelmapper_application_parse_voidstar,
+        .write = &prismelmapper_application_write_voidstar,
+    }
+    ,{
+        .name = "prismelmapper_mapplication",
+        .cleanup = &prismelmapper_mapplication_cleanup_voidstar,
+        .parse = &prismelmapper_mapplication_parse_voidstar,
+        .write = &prismelmapper_mapplication_write_voidstar,
+    }
+    ,{
+        .name = "palettemapper_pmapplication",
+        .cleanup = &palettemapper_pmapplication_cleanup_voidstar,
+        .parse = &palettemapper_pmapplication_parse_voidstar,
+        .write = &palettemapper_pmapplication_write_voidstar,
+    }
+    ,{
+        .name = "palettemapper_application",
+        .cleanup = &palettemapper_application_cleanup_voidstar,
+        .parse = &palettemapper_application_parse_voidstar,
+        .write = &palettemapper_application_write_voidstar,
+    }
+    ,{
+        .name = "rendergraph_child_type",
+        .cleanup = &rendergraph_child_type_cleanup_voidstar,
+        .parse = &rendergraph_child_type_parse_voidstar,
+        .write = &rendergraph_child_type_write_voidstar,
+    }
+    ,{
+        .name = "rendergraph_child",
+        .cleanup = &rendergraph_child_cleanup_voidstar,
+        .parse = &rendergraph_child_parse_voidstar,
+        .write = &rendergraph_child_write_voidstar,
+    }
+    ,{
+        .name = "rendergraph_child_type_prismel",
+        .cleanup = &rendergraph_child_type_prismel_cleanup_voidstar,
+        .parse = &rendergraph_child_type_prismel_parse_voidstar,
+        .write = &rendergraph_child_type_prismel_write_voidstar,
+    }
+    ,{
+        .name = "rendergraph_child_type_rgraph",
+        .cleanup = &rendergraph_child_type_rgraph_cleanup_voidstar,
+        .parse = &rendergraph_child_type_rgraph_parse_voidstar,
+        .write = &rendergraph_child_type_rgraph_write_voidstar,
+    }
+    ,{
+        .name = "rendergraph_child_type_label",
+        .cleanup = &rendergraph_child_type_label_cleanup_voidstar,
+        .parse = &rendergraph_child_type_label_parse_voidstar,
+        .write = &rendergraph_child_type_label_write_voidstar,
+    }
+    ,{
+        .name = "arrayof_rendergraph_label",
+        .cleanup = &arrayof_rendergraph_label_cleanup_voidstar,
+        .parse = &arrayof_rendergraph_label_parse_voidstar,
+        .write = &arrayof_rendergraph_label_write_voidstar,
+    }
+    ,{
+        .name = "rendergraph_frame",
+        .cleanup = &rendergraph_frame_cleanup_voidstar,
+        .parse = &rendergraph_frame_parse_voidstar,
+        .write = &rendergraph_frame_write_voidstar,
+    }
+    ,{
+        .name = "rendergraph_label",
+        .cleanup = &rendergraph_label_cleanup_voidstar,
+        .parse = &rendergraph_label_parse_voidstar,
+        .write = &rendergraph_label_write_voidstar,
+    }
+    ,{
+        .name = "rendergraph_bitmap",
+        .cleanup = &rendergraph_bitmap_cleanup_voidstar,
+        .parse = &rendergraph_bitmap_parse_voidstar,
+        .write = &rendergraph_bitmap_write_voidstar,
+    }
+};
+
+/* FUS function definitions */
+void any_cleanup(any_t *it) {
+    if (!it->type || !it->type->cleanup) return;
+    /* NOTE: we can safely use it->u.p, because types which have
+    a cleanup function are guaranteed to use pointers. */
+    it->type->cleanup(it->u.p);
+}
+void any_cleanup_voidstar(void *it) { any_cleanup((any_t *) it); }
+int any_parse(any_t *it, lexer_t *lexer) {
+}
+int any_parse_voidstar(void *it, lexer_t *lexer) { return any_parse((any_t *) it, lexer); }
+int any_write(any_t *it, writer_t *writer) {
+}
+int any_write_voidstar(void *it, writer_t *writer) { return any_write((any_t *) it, writer); }
+int type_parse(type_t *it, lexer_t *lexer) {
+}
+int type_parse_voidstar(void *it, lexer_t *lexer) { return type_parse((type_t *) it, lexer); }
+int type_write(type_t *it, writer_t *writer) {
+}
+int type_write_voidstar(void *it, writer_t *writer) { return type_write((type_t *) it, writer); }
+int vec_parse(vec_t *it, lexer_t *lexer) {
+}
+int vec_parse_voidstar(void *it, lexer_t *lexer) { return vec_parse((vec_t *) it, lexer); }
+int vec_write(vec_t *it, writer_t *writer) {
+}
+int vec_write_voidstar(void *it, writer_t *writer) { return vec_write((vec_t *) it, writer); }
+int boundbox_parse(boundbox_t *it, lexer_t *lexer) {
+}
+int boundbox_parse_voidstar(void *it, lexer_t *lexer) { return boundbox_parse((boundbox_t *) it, lexer); }
+int boundbox_write(boundbox_t *it, writer_t *writer) {
+}
+int boundbox_write_voidstar(void *it, writer_t *writer) { return boundbox_write((boundbox_t *) it, writer); }
+int flip_parse(flip_t *it, lexer_t *lexer) {
+}
+int flip_parse_voidstar(void *it, lexer_t *lexer) { return flip_parse((flip_t *) it, lexer); }
+int flip_write(flip_t *it, writer_t *writer) {
+}
+int flip_write_voidstar(void *it, writer_t *writer) { return flip_write((flip_t *) it, writer); }
+int rot_parse(rot_t *it, lexer_t *lexer) {
+}
+int rot_parse_voidstar(void *it, lexer_t *lexer) { return rot_parse((rot_t *) it, lexer); }
+int rot_write(rot_t *it, writer_t *writer) {
+}
+int rot_write_voidstar(void *it, writer_t *writer) { return rot_write((rot_t *) it, writer); }
+void trf_cleanup(trf_t *it) {
+    memset(it, 0, sizeof(*it));
+}
+void trf_cleanup_voidstar(void *it) { trf_cleanup((trf_t *) it); }
+int trf_parse(trf_t *it, lexer_t *lexer) {
+}
+int trf_parse_voidstar(void *it, lexer_t *lexer) { return trf_parse((trf_t *) it, lexer); }
+int trf_write(trf_t *it, writer_t *writer) {
+}
+int trf_write_voidstar(void *it, writer_t *writer) { return trf_write((trf_t *) it, writer); }
+void vecspace_cleanup(vecspace_t *it) {
+    memset(it, 0, sizeof(*it));
+}
+void vecspace_cleanup_voidstar(void *it) { vecspace_cleanup((vecspace_t *) it); }
+int vecspace_parse(vecspace_t *it, lexer_t *lexer) {
+}
+int vecspace_parse_voidstar(void *it, lexer_t *lexer) { return vecspace_parse((vecspace_t *) it, lexer); }
+int vecspace_write(vecspace_t *it, writer_t *writer) {
+}
+int vecspace_write_voidstar(void *it, writer_t *writer) { return vecspace_write((vecspace_t *) it, writer); }
+int vecspace_vec_rot_parse(vecspace_vec_rot_t *it, lexer_t *lexer) {
+}
+int vecspace_vec_rot_parse_voidstar(void *it, lexer_t *lexer) { return vecspace_vec_rot_parse((vecspace_vec_rot_t *) it, lexer); }
+int vecspace_vec_rot_write(vecspace_vec_rot_t *it, writer_t *writer) {
+}
+int vecspace_vec_rot_write_voidstar(void *it, writer_t *writer) { return vecspace_vec_rot_write((vecspace_vec_rot_t *) it, writer); }
+int vecspace_vec_flip_parse(vecspace_vec_flip_t *it, lexer_t *lexer) {
+}
+int vecspace_vec_flip_parse_voidstar(void *it, lexer_t *lexer) { return vecspace_vec_flip_parse((vecspace_vec_flip_t *) it, lexer); }
+int vecspace_vec_flip_write(vecspace_vec_flip_t *it, writer_t *writer) {
+}
+int vecspace_vec_flip_write_voidstar(void *it, writer_t *writer) { return vecspace_vec_flip_write((vecspace_vec_flip_t *) it, writer); }
+int vecspace_vec_render_parse(vecspace_vec_render_t *it, lexer_t *lexer) {
+}
+int vecspace_vec_render_parse_voidstar(void *it, lexer_t *lexer) { return vecspace_vec_render_parse((vecspace_vec_render_t *) it, lexer); }
+int vecspace_vec_render_write(vecspace_vec_render_t *it, writer_t *writer) {
+}
+int vecspace_vec_render_write_voidstar(void *it, writer_t *writer) { return vecspace_vec_render_write((vecspace_vec_render_t *) it, writer); }
+void arrayof_palette_entry_cleanup(arrayof_palette_entry_t *it) {
+    for (int i = 0; i < it->len; i++) {
+        palette_entry_cleanup(it->elems[i]);
+    }
+    free(it->elems);
+    memset(it, 0, sizeof(*it));
+}
+void arrayof_palette_entry_cleanup_voidstar(void *it) { arrayof_palette_entry_cleanup((arrayof_palette_entry_t *) it); }
+int arrayof_palette_entry_parse(arrayof_palette_entry_t *it, lexer_t *lexer) {
+}
+int arrayof_palette_entry_parse_voidstar(void *it, lexer_t *lexer) { return arrayof_palette_entry_parse((arrayof_palette_entry_t *) it, lexer); }
+int arrayof_palette_entry_write(arrayof_palette_entry_t *it, writer_t *writer) {
+}
+int arrayof_palette_entry_write_voidstar(void *it, writer_t *writer) { return arrayof_palette_entry_write((arrayof_palette_entry_t *) it, writer); }
+void palette_cleanup(palette_t *it) {
+    arrayof_palette_entry_cleanup(&it->entries);
+    memset(it, 0, sizeof(*it));
+}
+void palette_cleanup_voidstar(void *it) { palette_cleanup((palette_t *) it); }
+int palette_parse(palette_t *it, lexer_t *lexer) {
+}
+int palette_parse_voidstar(void *it, lexer_t *lexer) { return palette_parse((palette_t *) it, lexer); }
+int palette_write(palette_t *it, writer_t *writer) {
+}
+int palette_write_voidstar(void *it, writer_t *writer) { return palette_write((palette_t *) it, writer); }
+void arrayof_palette_entry_keyframe_cleanup(arrayof_palette_entry_keyframe_t *it) {
+    for (int i = 0; i < it->len; i++) {
+        palette_entry_keyframe_cleanup(it->elems[i]);
+    }
+    free(it->elems);
+    memset(it, 0, sizeof(*it));
+}
+void arrayof_palette_entry_keyframe_cleanup_voidstar(void *it) { arrayof_palette_entry_keyframe_cleanup((arrayof_palette_entry_keyframe_t *) it); }
+int arrayof_palette_entry_keyframe_parse(arrayof_palette_entry_keyframe_t *it, lexer_t *lexer) {
+}
+int arrayof_palette_entry_keyframe_parse_voidstar(void *it, lexer_t *lexer) { return arrayof_palette_entry_keyframe_parse((arrayof_palette_entry_keyframe_t *) it, lexer); }
+int arrayof_palette_entry_keyframe_write(arrayof_palette_entry_keyframe_t *it, writer_t *writer) {
+}
+int arrayof_palette_entry_keyframe_write_voidstar(void *it, writer_t *writer) { return arrayof_palette_entry_keyframe_write((arrayof_palette_entry_keyframe_t *) it, writer); }
+void palette_entry_cleanup(palette_entry_t *it) {
+    arrayof_palette_entry_keyframe_cleanup(&it->keyframes);
+    memset(it, 0, sizeof(*it));
+}
+void palette_entry_cleanup_voidstar(void *it) { palette_entry_cleanup((palette_entry_t *) it); }
+int palette_entry_parse(palette_entry_t *it, lexer_t *lexer) {
+}
+int palette_entry_parse_voidstar(void *it, lexer_t *lexer) { return palette_entry_parse((palette_entry_t *) it, lexer); }
+int palette_entry_write(palette_entry_t *it, writer_t *writer) {
+}
+int palette_entry_write_voidstar(void *it, writer_t *writer) { return palette_entry_write((palette_entry_t *) it, writer); }
+void palette_entry_keyframe_cleanup(palette_entry_keyframe_t *it) {
+    memset(it, 0, sizeof(*it));
+}
+void palette_entry_keyframe_cleanup_voidstar(void *it) { palette_entry_keyframe_cleanup((palette_entry_keyframe_t *) it); }
+int palette_entry_keyframe_parse(palette_entry_keyframe_t *it, lexer_t *lexer) {
+}
+int palette_entry_keyframe_parse_voidstar(void *it, lexer_t *lexer) { return palette_entry_keyframe_parse((palette_entry_keyframe_t *) it, lexer); }
+int palette_entry_keyframe_write(palette_entry_keyframe_t *it, writer_t *writer) {
+}
+int palette_entry_keyframe_write_voidstar(void *it, writer_t *writer) { return palette_entry_keyframe_write((palette_entry_keyframe_t *) it, writer); }
+void arrayof_prismel_image_cleanup(arrayof_prismel_image_t *it) {
+    for (int i = 0; i < it->len; i++) {
+        prismel_image_cleanup(it->elems[i]);
+    }
+    free(it->elems);
+    memset(it, 0, sizeof(*it));
+}
+void arrayof_prismel_image_cleanup_voidstar(void *it) { arrayof_prismel_image_cleanup((arrayof_prismel_image_t *) it); }
+int arrayof_prismel_image_parse(arrayof_prismel_image_t *it, lexer_t *lexer) {
+}
+int arrayof_prismel_image_parse_voidstar(void *it, lexer_t *lexer) { return arrayof_prismel_image_parse((arrayof_prismel_image_t *) it, lexer); }
+int arrayof_prismel_image_write(arrayof_prismel_image_t *it, writer_t *writer) {
+}
+int arrayof_prismel_image_write_voidstar(void *it, writer_t *writer) { return arrayof_prismel_image_write((arrayof_prismel_image_t *) it, writer); }
+void prismel_cleanup(prismel_t *it) {
+    arrayof_prismel_image_cleanup(&it->images);
+    memset(it, 0, sizeof(*it));
+}
+void prismel_cleanup_voidstar(void *it) { prismel_cleanup((prismel_t *) it); }
+int prismel_parse(prismel_t *it, lexer_t *lexer) {
+}
+int prismel_parse_voidstar(void *it, lexer_t *lexer) { return prismel_parse((prismel_t *) it, lexer); }
+int prismel_write(prismel_t *it, writer_t *writer) {
+}
+int prismel_write_voidstar(void *it, writer_t *writer) { return prismel_write((prismel_t *) it, writer); }
+void arrayof_prismel_image_line_cleanup(arrayof_prismel_image_line_t *it) {
+    for (int i = 0; i < it->len; i++) {
+        prismel_image_line_cleanup(it->elems[i]);
+    }
+    free(it->elems);
+    memset(it, 0, sizeof(*it));
+}
+void arrayof_prismel_image_line_cleanup_voidstar(void *it) { arrayof_prismel_image_line_cleanup((arrayof_prismel_image_line_t *) it); }
+int arrayof_prismel_image_line_parse(arrayof_prismel_image_line_t *it, lexer_t *lexer) {
+}
+int arrayof_prismel_image_line_parse_voidstar(void *it, lexer_t *lexer) { return arrayof_prismel_image_line_parse((arrayof_prismel_image_line_t *) it, lexer); }
+int arrayof_prismel_image_line_write(arrayof_prismel_image_line_t *it, writer_t *writer) {
+}
+int arrayof_prismel_image_line_write_voidstar(void *it, writer_t *writer) { return arrayof_prismel_image_line_write((arrayof_prismel_image_line_t *) it, writer); }
+void prismel_image_cleanup(prismel_image_t *it) {
+    arrayof_prismel_image_line_cleanup(&it->lines);
+    memset(it, 0, sizeof(*it));
+}
+void prismel_image_cleanup_voidstar(void *it) { prismel_image_cleanup((prismel_image_t *) it); }
+int prismel_image_parse(prismel_image_t *it, lexer_t *lexer) {
+}
+int prismel_image_parse_voidstar(void *it, lexer_t *lexer) { return prismel_image_parse((prismel_image_t *) it, lexer); }
+int prismel_image_write(prismel_image_t *it, writer_t *writer) {
+}
+int prismel_image_write_voidstar(void *it, writer_t *writer) { return prismel_image_write((prismel_image_t *) it, writer); }
+void prismel_image_line_cleanup(prismel_image_line_t *it) {
+    memset(it, 0, sizeof(*it));
+}
+void prismel_image_line_cleanup_voidstar(void *it) { prismel_image_line_cleanup((prismel_image_line_t *) it); }
+int prismel_image_line_parse(prismel_image_line_t *it, lexer_t *lexer) {
+}
+int prismel_image_line_parse_voidstar(void *it, lexer_t *lexer) { return prismel_image_line_parse((prismel_image_line_t *) it, lexer); }
+int prismel_image_line_write(prismel_image_line_t *it, writer_t *writer) {
+}
+int prismel_image_line_write_voidstar(void *it, writer_t *writer) { return prismel_image_line_write((prismel_image_line_t *) it, writer); }
+void arrayof_font_cleanup(arrayof_font_t *it) {
+    for (int i = 0; i < it->len; i++) {
+        font_cleanup(it->elems[i]);
+    }
+    free(it->elems);
+    memset(it, 0, sizeof(*it));
+}
+void arrayof_font_cleanup_voidstar(void *it) { arrayof_font_cleanup((arrayof_font_t *) it); }
+int arrayof_font_parse(arrayof_font_t *it, lexer_t *lexer) {
+}
+int arrayof_font_parse_voidstar(void *it, lexer_t *lexer) { return arrayof_font_parse((arrayof_font_t *) it, lexer); }
+int arrayof_font_write(arrayof_font_t *it, writer_t *writer) {
+}
+int arrayof_font_write_voidstar(void *it, writer_t *writer) { return arrayof_font_write((arrayof_font_t *) it, writer); }
+void arrayof_geomfont_cleanup(arrayof_geomfont_t *it) {
+    for (int i = 0; i < it->len; i++) {
+        geomfont_cleanup(it->elems[i]);
+    }
+    free(it->elems);
+    memset(it, 0, sizeof(*it));
+}
+void arrayof_geomfont_cleanup_voidstar(void *it) { arrayof_geomfont_cleanup((arrayof_geomfont_t *) it); }
+int arrayof_geomfont_parse(arrayof_geomfont_t *it, lexer_t *lexer) {
+}
+int arrayof_geomfont_parse_voidstar(void *it, lexer_t *lexer) { return arrayof_geomfont_parse((arrayof_geomfont_t *) it, lexer); }
+int arrayof_geomfont_write(arrayof_geomfont_t *it, writer_t *writer) {
+}
+int arrayof_geomfont_write_voidstar(void *it, writer_t *writer) { return arrayof_geomfont_write((arrayof_geomfont_t *) it, writer); }
+void arrayof_prismel_cleanup(arrayof_prismel_t *it) {
+    for (int i = 0; i < it->len; i++) {
+        prismel_cleanup(it->elems[i]);
+    }
+    free(it->elems);
+    memset(it, 0, sizeof(*it));
+}
+void arrayof_prismel_cleanup_voidstar(void *it) { arrayof_prismel_cleanup((arrayof_prismel_t *) it); }
+int arrayof_prismel_parse(arrayof_prismel_t *it, lexer_t *lexer) {
+}
+int arrayof_prismel_parse_voidstar(void *it, lexer_t *lexer) { return arrayof_prismel_parse((arrayof_prismel_t *) it, lexer); }
+int arrayof_prismel_write(arrayof_prismel_t *it, writer_t *writer) {
+}
+int arrayof_prismel_write_voidstar(void *it, writer_t *writer) { return arrayof_prismel_write((arrayof_prismel_t *) it, writer); }
+void arrayof_prismelmapper_cleanup(arrayof_prismelmapper_t *it) {
+    for (int i = 0; i < it->len; i++) {
+        prismelmapper_cleanup(it->elems[i]);
+    }
+    free(it->elems);
+    memset(it, 0, sizeof(*it));
+}
+void arrayof_prismelmapper_cleanup_voidstar(void *it) { arrayof_prismelmapper_cleanup((arrayof_prismelmapper_t *) it); }
+int arrayof_prismelmapper_parse(arrayof_prismelmapper_t *it, lexer_t *lexer) {
+}
+int arrayof_prismelmapper_parse_voidstar(void *it, lexer_t *lexer) { return arrayof_prismelmapper_parse((arrayof_prismelmapper_t *) it, lexer); }
+int arrayof_prismelmapper_write(arrayof_prismelmapper_t *it, writer_t *writer) {
+}
+int arrayof_prismelmapper_write_voidstar(void *it, writer_t *writer) { return arrayof_prismelmapper_write((arrayof_prismelmapper_t *) it, writer); }
+void arrayof_palettemapper_cleanup(arrayof_palettemapper_t *it) {
+    for (int i = 0; i < it->len; i++) {
+        palettemapper_cleanup(it->elems[i]);
+    }
+    free(it->elems);
+    memset(it, 0, sizeof(*it));
+}
+void arrayof_palettemapper_cleanup_voidstar(void *it) { arrayof_palettemapper_cleanup((arrayof_palettemapper_t *) it); }
+int arrayof_palettemapper_parse(arrayof_palettemapper_t *it, lexer_t *lexer) {
+}
+int arrayof_palettemapper_parse_voidstar(void *it, lexer_t *lexer) { return arrayof_palettemapper_parse((arrayof_palettemapper_t *) it, lexer); }
+int arrayof_palettemapper_write(arrayof_palettemapper_t *it, writer_t *writer) {
+}
+int arrayof_palettemapper_write_voidstar(void *it, writer_t *writer) { return arrayof_palettemapper_write((arrayof_palettemapper_t *) it, writer); }
+void prismelrenderer_cleanup(prismelrenderer_t *it) {
+    arrayof_font_cleanup(&it->fonts);
+    arrayof_geomfont_cleanup(&it->geomfonts);
+    arrayof_prismel_cleanup(&it->prismels);
+    arrayof_prismelmapper_cleanup(&it->mappers);
+    arrayof_palettemapper_cleanup(&it->palmappers);
+    memset(it, 0, sizeof(*it));
+}
+void prismelrenderer_cleanup_voidstar(void *it) { prismelrenderer_cleanup((prismelrenderer_t *) it); }
+int prismelrenderer_parse(prismelrenderer_t *it, lexer_t *lexer) {
+}
+int prismelrenderer_parse_voidstar(void *it, lexer_t *lexer) { return prismelrenderer_parse((prismelrenderer_t *) it, lexer); }
+int prismelrenderer_write(prismelrenderer_t *it, writer_t *writer) {
+}
+int prismelrenderer_write_voidstar(void *it, writer_t *writer) { return prismelrenderer_write((prismelrenderer_t *) it, writer); }
+void font_cleanup(font_t *it) {
+    memset(it, 0, sizeof(*it));
+}
+void font_cleanup_voidstar(void *it) { font_cleanup((font_t *) it); }
+int font_parse(font_t *it, lexer_t *lexer) {
+}
+int font_parse_voidstar(void *it, lexer_t *lexer) { return font_parse((font_t *) it, lexer); }
+int font_write(font_t *it, writer_t *writer) {
+}
+int font_write_voidstar(void *it, writer_t *writer) { return font_write((font_t *) it, writer); }
+void geomfont_cleanup(geomfont_t *it) {
+    memset(it, 0, sizeof(*it));
+}
+void geomfont_cleanup_voidstar(void *it) { geomfont_cleanup((geomfont_t *) it); }
+int geomfont_parse(geomfont_t *it, lexer_t *lexer) {
+}
+int geomfont_parse_voidstar(void *it, lexer_t *lexer) { return geomfont_parse((geomfont_t *) it, lexer); }
+int geomfont_write(geomfont_t *it, writer_t *writer) {
+}
+int geomfont_write_voidstar(void *it, writer_t *writer) { return geomfont_write((geomfont_t *) it, writer); }
+void arrayof_prismelmapper_entry_cleanup(arrayof_prismelmapper_entry_t *it) {
+    for (int i = 0; i < it->len; i++) {
+        prismelmapper_entry_cleanup(it->elems[i]);
+    }
+    free(it->elems);
+    memset(it, 0, sizeof(*it));
+}
+void arrayof_prismelmapper_entry_cleanup_voidstar(void *it) { arrayof_prismelmapper_entry_cleanup((arrayof_prismelmapper_entry_t *) it); }
+int arrayof_prismelmapper_entry_parse(arrayof_prismelmapper_entry_t *it, lexer_t *lexer) {
+}
+int arrayof_prismelmapper_entry_parse_voidstar(void *it, lexer_t *lexer) { return arrayof_prismelmapper_entry_parse((arrayof_prismelmapper_entry_t *) it, lexer); }
+int arrayof_prismelmapper_entry_write(arrayof_prismelmapper_entry_t *it, writer_t *writer) {
+}
+int arrayof_prismelmapper_entry_write_voidstar(void *it, writer_t *writer) { return arrayof_prismelmapper_entry_write((arrayof_prismelmapper_entry_t *) it, writer); }
+void prismelmapper_cleanup(prismelmapper_t *it) {
+    arrayof_prismelmapper_entry_cleanup(&it->entries);
+    prismelmapper_application_cleanup(it->applications);
+    prismelmapper_mapplication_cleanup(it->mapplications);
+    memset(it, 0, sizeof(*it));
+}
+void prismelmapper_cleanup_voidstar(void *it) { prismelmapper_cleanup((prismelmapper_t *) it); }
+int prismelmapper_parse(prismelmapper_t *it, lexer_t *lexer) {
+}
+int prismelmapper_parse_voidstar(void *it, lexer_t *lexer) { return prismelmapper_parse((prismelmapper_t *) it, lexer); }
+int prismelmapper_write(prismelmapper_t *it, writer_t *writer) {
+}
+int prismelmapper_write_voidstar(void *it, writer_t *writer) { return prismelmapper_write((prismelmapper_t *) it, writer); }
+void arrayof_byte_cleanup(arrayof_byte_t *it) {
+    free(it->elems);
+    memset(it, 0, sizeof(*it));
+}
+void arrayof_byte_cleanup_voidstar(void *it) { arrayof_byte_cleanup((arrayof_byte_t *) it); }
+int arrayof_byte_parse(arrayof_byte_t *it, lexer_t *lexer) {
+}
+int arrayof_byte_parse_voidstar(void *it, lexer_t *lexer) { return arrayof_byte_parse((arrayof_byte_t *) it, lexer); }
+int arrayof_byte_write(arrayof_byte_t *it, writer_t *writer) {
+}
+int arrayof_byte_write_voidstar(void *it, writer_t *writer) { return arrayof_byte_write((arrayof_byte_t *) it, writer); }
+void arrayof_palettemapper_pmapplication_cleanup(arrayof_palettemapper_pmapplication_t *it) {
+    for (int i = 0; i < it->len; i++) {
+        palettemapper_pmapplication_cleanup(it->elems[i]);
+    }
+    free(it->elems);
+    memset(it, 0, sizeof(*it));
+}
+void arrayof_palettemapper_pmapplication_cleanup_voidstar(void *it) { arrayof_palettemapper_pmapplication_cleanup((arrayof_palettemapper_pmapplication_t *) it); }
+int arrayof_palettemapper_pmapplication_parse(arrayof_palettemapper_pmapplication_t *it, lexer_t *lexer) {
+}
+int arrayof_palettemapper_pmapplication_parse_voidstar(void *it, lexer_t *lexer) { return arrayof_palettemapper_pmapplication_parse((arrayof_palettemapper_pmapplication_t *) it, lexer); }
+int arrayof_palettemapper_pmapplication_write(arrayof_palettemapper_pmapplication_t *it, writer_t *writer) {
+}
+int arrayof_palettemapper_pmapplication_write_voidstar(void *it, writer_t *writer) { return arrayof_palettemapper_pmapplication_write((arrayof_palettemapper_pmapplication_t *) it, writer); }
+void arrayof_palettemapper_application_cleanup(arrayof_palettemapper_application_t *it) {
+    for (int i = 0; i < it->len; i++) {
+        palettemapper_application_cleanup(it->elems[i]);
+    }
+    free(it->elems);
+    memset(it, 0, sizeof(*it));
+}
+void arrayof_palettemapper_application_cleanup_voidstar(void *it) { arrayof_palettemapper_application_cleanup((arrayof_palettemapper_application_t *) it); }
+int arrayof_palettemapper_application_parse(arrayof_palettemapper_application_t *it, lexer_t *lexer) {
+}
+int arrayof_palettemapper_application_parse_voidstar(void *it, lexer_t *lexer) { return arrayof_palettemapper_application_parse((arrayof_palettemapper_application_t *) it, lexer); }
+int arrayof_palettemapper_application_write(arrayof_palettemapper_application_t *it, writer_t *writer) {
+}
+int arrayof_palettemapper_application_write_voidstar(void *it, writer_t *writer) { return arrayof_palettemapper_application_write((arrayof_palettemapper_application_t *) it, writer); }
+void palettemapper_cleanup(palettemapper_t *it) {
+    arrayof_byte_cleanup(&it->table);
+    arrayof_palettemapper_pmapplication_cleanup(&it->pmapplications);
+    arrayof_palettemapper_application_cleanup(&it->applications);
+    memset(it, 0, sizeof(*it));
+}
+void palettemapper_cleanup_voidstar(void *it) { palettemapper_cleanup((palettemapper_t *) it); }
+int palettemapper_parse(palettemapper_t *it, lexer_t *lexer) {
+}
+int palettemapper_parse_voidstar(void *it, lexer_t *lexer) { return palettemapper_parse((palettemapper_t *) it, lexer); }
+int palettemapper_write(palettemapper_t *it, writer_t *writer) {
+}
+int palettemapper_write_voidstar(void *it, writer_t *writer) { return palettemapper_write((palettemapper_t *) it, writer); }
+void prismelmapper_entry_cleanup(prismelmapper_entry_t *it) {
+    memset(it, 0, sizeof(*it));
+}
+void prismelmapper_entry_cleanup_voidstar(void *it) { prismelmapper_entry_cleanup((prismelmapper_entry_t *) it); }
+int prismelmapper_entry_parse(prismelmapper_entry_t *it, lexer_t *lexer) {
+}
+int prismelmapper_entry_parse_voidstar(void *it, lexer_t *lexer) { return prismelmapper_entry_parse((prismelmapper_entry_t *) it, lexer); }
+int prismelmapper_entry_write(prismelmapper_entry_t *it, writer_t *writer) {
+}
+int prismelmapper_entry_write_voidstar(void *it, writer_t *writer) { return prismelmapper_entry_write((prismelmapper_entry_t *) it, writer); }
+void arrayof_rendergraph_child_cleanup(arrayof_rendergraph_child_t *it) {
+    for (int i = 0; i < it->len; i++) {
+        rendergraph_child_cleanup(it->elems[i]);
+    }
+    free(it->elems);
+    memset(it, 0, sizeof(*it));
+}
+void arrayof_rendergraph_child_cleanup_voidstar(void *it) { arrayof_rendergraph_child_cleanup((arrayof_rendergraph_child_t *) it); }
+int arrayof_rendergraph_child_parse(arrayof_rendergraph_child_t *it, lexer_t *lexer) {
+}
+int arrayof_rendergraph_child_parse_voidstar(void *it, lexer_t *lexer) { return arrayof_rendergraph_child_parse((arrayof_rendergraph_child_t *) it, lexer); }
+int arrayof_rendergraph_child_write(arrayof_rendergraph_child_t *it, writer_t *writer) {
+}
+int arrayof_rendergraph_child_write_voidstar(void *it, writer_t *writer) { return arrayof_rendergraph_child_write((arrayof_rendergraph_child_t *) it, writer); }
+void arrayof_rendergraph_frame_cleanup(arrayof_rendergraph_frame_t *it) {
+    for (int i = 0; i < it->len; i++) {
+        rendergraph_frame_cleanup(it->elems[i]);
+    }
+    free(it->elems);
+    memset(it, 0, sizeof(*it));
+}
+void arrayof_rendergraph_frame_cleanup_voidstar(void *it) { arrayof_rendergraph_frame_cleanup((arrayof_rendergraph_frame_t *) it); }
+int arrayof_rendergraph_frame_parse(arrayof_rendergraph_frame_t *it, lexer_t *lexer) {
+}
+int arrayof_rendergraph_frame_parse_voidstar(void *it, lexer_t *lexer) { return arrayof_rendergraph_frame_parse((arrayof_rendergraph_frame_t *) it, lexer); }
+int arrayof_rendergraph_frame_write(arrayof_rendergraph_frame_t *it, writer_t *writer) {
+}
+int arrayof_rendergraph_frame_write_voidstar(void *it, writer_t *writer) { return arrayof_rendergraph_frame_write((arrayof_rendergraph_frame_t *) it, writer); }
+void arrayof_rendergraph_bitmap_cleanup(arrayof_rendergraph_bitmap_t *it) {
+    for (int i = 0; i < it->len; i++) {
+        rendergraph_bitmap_cleanup(it->elems[i]);
+    }
+    free(it->elems);
+    memset(it, 0, sizeof(*it));
+}
+void arrayof_rendergraph_bitmap_cleanup_voidstar(void *it) { arrayof_rendergraph_bitmap_cleanup((arrayof_rendergraph_bitmap_t *) it); }
+int arrayof_rendergraph_bitmap_parse(arrayof_rendergraph_bitmap_t *it, lexer_t *lexer) {
+}
+int arrayof_rendergraph_bitmap_parse_voidstar(void *it, lexer_t *lexer) { return arrayof_rendergraph_bitmap_parse((arrayof_rendergraph_bitmap_t *) it, lexer); }
+int arrayof_rendergraph_bitmap_write(arrayof_rendergraph_bitmap_t *it, writer_t *writer) {
+}
+int arrayof_rendergraph_bitmap_write_voidstar(void *it, writer_t *writer) { return arrayof_rendergraph_bitmap_write((arrayof_rendergraph_bitmap_t *) it, writer); }
+void rendergraph_cleanup(rendergraph_t *it) {
+    arrayof_rendergraph_child_cleanup(&it->children);
+    arrayof_rendergraph_frame_cleanup(&it->frames);
+    arrayof_rendergraph_bitmap_cleanup(&it->bitmaps);
+    memset(it, 0, sizeof(*it));
+}
+void rendergraph_cleanup_voidstar(void *it) { rendergraph_cleanup((rendergraph_t *) it); }
+int rendergraph_parse(rendergraph_t *it, lexer_t *lexer) {
+}
+int rendergraph_parse_voidstar(void *it, lexer_t *lexer) { return rendergraph_parse((rendergraph_t *) it, lexer); }
+int rendergraph_write(rendergraph_t *it, writer_t *writer) {
+}
+int rendergraph_write_voidstar(void *it, writer_t *writer) { return rendergraph_write((rendergraph_t *) it, writer); }
+void prismelmapper_application_cleanup(prismelmapper_application_t *it) {
+    memset(it, 0, sizeof(*it));
+}
+void prismelmapper_application_cleanup_voidstar(void *it) { prismelmapper_application_cleanup((prismelmapper_application_t *) it); }
+int prismelmapper_application_parse(prismelmapper_application_t *it, lexer_t *lexer) {
+}
+int prismelmapper_application_parse_voidstar(void *it, lexer_t *lexer) { return prismelmapper_application_parse((prismelmapper_application_t *) it, lexer); }
+int prismelmapper_application_write(prismelmapper_application_t *it, writer_t *writer) {
+}
+int prismelmapper_application_write_voidstar(void *it, writer_t *writer) { return prismelmapper_application_write((prismelmapper_application_t *) it, writer); }
+void prismelmapper_mapplication_cleanup(prismelmapper_mapplication_t *it) {
+    memset(it, 0, sizeof(*it));
+}
+void prismelmapper_mapplication_cleanup_voidstar(void *it) { prismelmapper_mapplication_cleanup((prismelmapper_mapplication_t *) it); }
+int prismelmapper_mapplication_parse(prismelmapper_mapplication_t *it, lexer_t *lexer) {
+}
+int prismelmapper_mapplication_parse_voidstar(void *it, lexer_t *lexer) { return prismelmapper_mapplication_parse((prismelmapper_mapplication_t *) it, lexer); }
+int prismelmapper_mapplication_write(prismelmapper_mapplication_t *it, writer_t *writer) {
+}
+int prismelmapper_mapplication_write_voidstar(void *it, writer_t *writer) { return prismelmapper_mapplication_write((prismelmapper_mapplication_t *) it, writer); }
+void palettemapper_pmapplication_cleanup(palettemapper_pmapplication_t *it) {
+    memset(it, 0, sizeof(*it));
+}
+void palettemapper_pmapplication_cleanup_voidstar(void *it) { palettemapper_pmapplication_cleanup((palettemapper_pmapplication_t *) it); }
+int palettemapper_pmapplication_parse(palettemapper_pmapplication_t *it, lexer_t *lexer) {
+}
+int palettemapper_pmapplication_parse_voidstar(void *it, lexer_t *lexer) { return palettemapper_pmapplication_parse((palettemapper_pmapplication_t *) it, lexer); }
+int palettemapper_pmapplication_write(palettemapper_pmapplication_t *it, writer_t *writer) {
+}
+int palettemapper_pmapplication_write_voidstar(void *it, writer_t *writer) { return palettemapper_pmapplication_write((palettemapper_pmapplication_t *) it, writer); }
+void palettemapper_application_cleanup(palettemapper_application_t *it) {
+    memset(it, 0, sizeof(*it));
+}
+void palettemapper_application_cleanup_voidstar(void *it) { palettemapper_application_cleanup((palettemapper_application_t *) it); }
+int palettemapper_application_parse(palettemapper_application_t *it, lexer_t *lexer) {
+}
+int palettemapper_application_parse_voidstar(void *it, lexer_t *lexer) { return palettemapper_application_parse((palettemapper_application_t *) it, lexer); }
+int palettemapper_application_write(palettemapper_application_t *it, writer_t *writer) {
+}
+int palettemapper_application_write_voidstar(void *it, writer_t *writer) { return palettemapper_application_write((palettemapper_application_t *) it, writer); }
+void rendergraph_child_type_cleanup(rendergraph_child_type_t *it) {
+    switch (it->tag) {
+        case RENDERGRAPH_CHILD_TYPE_TAG_PRISMEL:
+            rendergraph_child_type_prismel_cleanup(it->u.prismel);
+            break;
+        case RENDERGRAPH_CHILD_TYPE_TAG_RGRAPH:
+            rendergraph_child_type_rgraph_cleanup(it->u.rgraph);
+            break;
+        case RENDERGRAPH_CHILD_TYPE_TAG_LABEL:
+            rendergraph_child_type_label_cleanup(it->u.label);
+            break;
+        default: break;
+    }
+    memset(it, 0, sizeof(*it));
+}
+void rendergraph_child_type_cleanup_voidstar(void *it) { rendergraph_child_type_cleanup((rendergraph_child_type_t *) it); }
+int rendergraph_child_type_parse(rendergraph_child_type_t *it, lexer_t *lexer) {
+}
+int rendergraph_child_type_parse_voidstar(void *it, lexer_t *lexer) { return rendergraph_child_type_parse((rendergraph_child_type_t *) it, lexer); }
+int rendergraph_child_type_write(rendergraph_child_type_t *it, writer_t *writer) {
+}
+int rendergraph_child_type_write_voidstar(void *it, writer_t *writer) { return rendergraph_child_type_write((rendergraph_child_type_t *) it, writer); }
+void rendergraph_child_cleanup(rendergraph_child_t *it) {
+    trf_cleanup(&it->trf);
+    rendergraph_child_type_cleanup(&it->type);
+    memset(it, 0, sizeof(*it));
+}
+void rendergraph_child_cleanup_voidstar(void *it) { rendergraph_child_cleanup((rendergraph_child_t *) it); }
+int rendergraph_child_parse(rendergraph_child_t *it, lexer_t *lexer) {
+}
+int rendergraph_child_parse_voidstar(void *it, lexer_t *lexer) { return rendergraph_child_parse((rendergraph_child_t *) it, lexer); }
+int rendergraph_child_write(rendergraph_child_t *it, writer_t *writer) {
+}
+int rendergraph_child_write_voidstar(void *it, writer_t *writer) { return rendergraph_child_write((rendergraph_child_t *) it, writer); }
+void rendergraph_child_type_prismel_cleanup(rendergraph_child_type_prismel_t *it) {
+    memset(it, 0, sizeof(*it));
+}
+void rendergraph_child_type_prismel_cleanup_voidstar(void *it) { rendergraph_child_type_prismel_cleanup((rendergraph_child_type_prismel_t *) it); }
+int rendergraph_child_type_prismel_parse(rendergraph_child_type_prismel_t *it, lexer_t *lexer) {
+}
+int rendergraph_child_type_prismel_parse_voidstar(void *it, lexer_t *lexer) { return rendergraph_child_type_prismel_parse((rendergraph_child_type_prismel_t *) it, lexer); }
+int rendergraph_child_type_prismel_write(rendergraph_child_type_prismel_t *it, writer_t *writer) {
+}
+int rendergraph_child_type_prismel_write_voidstar(void *it, writer_t *writer) { return rendergraph_child_type_prismel_write((rendergraph_child_type_prismel_t *) it, writer); }
+void rendergraph_child_type_rgraph_cleanup(rendergraph_child_type_rgraph_t *it) {
+    memset(it, 0, sizeof(*it));
+}
+void rendergraph_child_type_rgraph_cleanup_voidstar(void *it) { rendergraph_child_type_rgraph_cleanup((rendergraph_child_type_rgraph_t *) it); }
+int rendergraph_child_type_rgraph_parse(rendergraph_child_type_rgraph_t *it, lexer_t *lexer) {
+}
+int rendergraph_child_type_rgraph_parse_voidstar(void *it, lexer_t *lexer) { return rendergraph_child_type_rgraph_parse((rendergraph_child_type_rgraph_t *) it, lexer); }
+int rendergraph_child_type_rgraph_write(rendergraph_child_type_rgraph_t *it, writer_t *writer) {
+}
+int rendergraph_child_type_rgraph_write_voidstar(void *it, writer_t *writer) { return rendergraph_child_type_rgraph_write((rendergraph_child_type_rgraph_t *) it, writer); }
+void rendergraph_child_type_label_cleanup(rendergraph_child_type_label_t *it) {
+    memset(it, 0, sizeof(*it));
+}
+void rendergraph_child_type_label_cleanup_voidstar(void *it) { rendergraph_child_type_label_cleanup((rendergraph_child_type_label_t *) it); }
+int rendergraph_child_type_label_parse(rendergraph_child_type_label_t *it, lexer_t *lexer) {
+}
+int rendergraph_child_type_label_parse_voidstar(void *it, lexer_t *lexer) { return rendergraph_child_type_label_parse((rendergraph_child_type_label_t *) it, lexer); }
+int rendergraph_child_type_label_write(rendergraph_child_type_label_t *it, writer_t *writer) {
+}
+int rendergraph_child_type_label_write_voidstar(void *it, writer_t *writer) { return rendergraph_child_type_label_write((rendergraph_child_type_label_t *) it, writer); }
+void arrayof_rendergraph_label_cleanup(arrayof_rendergraph_label_t *it) {
+    for (int i = 0; i < it->len; i++) {
+        rendergraph_label_cleanup(it->elems[i]);
+    }
+    free(it->elems);
+    memset(it, 0, sizeof(*it));
+}
+void arrayof_rendergraph_label_cleanup_voidstar(void *it) { arrayof_rendergraph_label_cleanup((arrayof_rendergraph_label_t *) it); }
+int arrayof_rendergraph_label_parse(arrayof_rendergraph_label_t *it, lexer_t *lexer) {
+}
+int arrayof_rendergraph_label_parse_voidstar(void *it, lexer_t *lexer) { return arrayof_rendergraph_label_parse((arrayof_rendergraph_label_t *) it, lexer); }
+int arrayof_rendergraph_label_write(arrayof_rendergraph_label_t *it, writer_t *writer) {
+}
+int arrayof_rendergraph_label_write_voidstar(void *it, writer_t *writer) { return arrayof_rendergraph_label_write((arrayof_rendergraph_label_t *) it, writer); }
+void rendergraph_frame_cleanup(rendergraph_frame_t *it) {
+    arrayof_rendergraph_label_cleanup(&it->labels);
+    memset(it, 0, sizeof(*it));
+}
+void rendergraph_frame_cleanup_voidstar(void *it) { rendergraph_frame_cleanup((rendergraph_frame_t *) it); }
+int rendergraph_frame_parse(rendergraph_frame_t *it, lexer_t *lexer) {
+}
+int rendergraph_frame_parse_voidstar(void *it, lexer_t *lexer) { return rendergraph_frame_parse((rendergraph_frame_t *) it, lexer); }
+int rendergraph_frame_write(rendergraph_frame_t *it, writer_t *writer) {
+}
+int rendergraph_frame_write_voidstar(void *it, writer_t *writer) { return rendergraph_frame_write((rendergraph_frame_t *) it, writer); }
+void rendergraph_label_cleanup(rendergraph_label_t *it) {
+    trf_cleanup(&it->trf);
+    memset(it, 0, sizeof(*it));
+}
+void rendergraph_label_cleanup_voidstar(void *it) { rendergraph_label_cleanup((rendergraph_label_t *) it); }
+int rendergraph_label_parse(rendergraph_label_t *it, lexer_t *lexer) {
+}
+int rendergraph_label_parse_voidstar(void *it, lexer_t *lexer) { return rendergraph_label_parse((rendergraph_label_t *) it, lexer); }
+int rendergraph_label_write(rendergraph_label_t *it, writer_t *writer) {
+}
+int rendergraph_label_write_voidstar(void *it, writer_t *writer) { return rendergraph_label_write((rendergraph_label_t *) it, writer); }
+void rendergraph_bitmap_cleanup(rendergraph_bitmap_t *it) {
+    RENDERGRAPH_BITMAP_EXTRA_CLEANUP;
+    memset(it, 0, sizeof(*it));
+}
+void rendergraph_bitmap_cleanup_voidstar(void *it) { rendergraph_bitmap_cleanup((rendergraph_bitmap_t *) it); }
+int rendergraph_bitmap_parse(rendergraph_bitmap_t *it, lexer_t *lexer) {
+}
+int rendergraph_bitmap_parse_voidstar(void *it, lexer_t *lexer) { return rendergraph_bitmap_parse((rendergraph_bitmap_t *) it, lexer); }
+int rendergraph_bitmap_write(rendergraph_bitmap_t *it, writer_t *writer) {
+}
+int rendergraph_bitmap_write_voidstar(void *it, writer_t *writer) { return rendergraph_bitmap_write((rendergraph_bitmap_t *) it, writer); }
+
+/* Dummy main */
+int main(int n_args, char **args) { return 0; }
@@ -0,0 +1,241 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* FUS typedefs */
+typedef struct lexer lexer_t;
+typedef struct writer writer_t;
+typedef struct any any_t;
+typedef struct type type_t;
+typedef struct graphs_bintree graphs_bintree_t;
+typedef struct graphs_bintree_branch graphs_bintree_branch_t;
+typedef struct arrayof_graphs_tree arrayof_graphs_tree_t;
+typedef struct graphs_tree graphs_tree_t;
+
+/* FUS enums */
+enum types {
+    TYPE_ANY,
+    TYPE_TYPE,
+    TYPE_GRAPHS_BINTREE,
+    TYPE_GRAPHS_BINTREE_BRANCH,
+    TYPE_ARRAYOF_GRAPHS_TREE,
+    TYPE_GRAPHS_TREE,
+    TYPES
+};
+enum graphs_bintree_tag {
+    GRAPHS_BINTREE_TAG_BRANCH,
+    GRAPHS_BINTREE_TAG_DATA,
+    GRAPHS_BINTREE_TAGS
+};
+
+/* FUS structs */
+struct any {
+    type_t *type;
+    int weakref: 1;
+    union {
+        char c; /* byte */
+        bool b; /* bool */
+        int i; /* int, err */
+        const char *s; /* string */
+        void (*fp)(); /* func */
+        void *p; /* everything else */
+    } u;
+};
+struct type {
+    const char *name;
+    /* TODO: tag and union with type's details, e.g. fields */
+    void (*cleanup)(void *it);
+    int (*parse)(void *it, lexer_t *lexer);
+    int (*write)(void *it, writer_t *writer);
+};
+struct graphs_bintree {
+    int tag; /* enum graphs_bintree_tag */
+    union {
+        graphs_bintree_branch_t* branch;
+        any_t data;
+    } u;
+};
+struct graphs_bintree_branch {
+    graphs_bintree_t* left;
+    graphs_bintree_t* right;
+};
+struct arrayof_graphs_tree {
+    size_t size;
+    size_t len;
+    graphs_tree_t* *elems;
+};
+struct graphs_tree {
+    arrayof_graphs_tree_t children;
+    any_t data;
+};
+
+/* FUS types */
+extern type_t types[TYPES]; /* Indexed by: enum types */
+
+/* FUS function prototypes */
+void any_cleanup(any_t *it);
+void any_cleanup_voidstar(void *it);
+int any_parse(any_t *it, lexer_t *lexer);
+int any_parse_voidstar(void *it, lexer_t *lexer);
+int any_write(any_t *it, writer_t *writer);
+int any_write_voidstar(void *it, writer_t *writer);
+#define type_cleanup (void)
+#define type_cleanup_voidstar (void)
+int type_parse(type_t *it, lexer_t *lexer);
+int type_parse_voidstar(void *it, lexer_t *lexer);
+int type_write(type_t *it, writer_t *writer);
+int type_write_voidstar(void *it, writer_t *writer);
+static const char *graphs_bintree_tag_string(int tag /* enum graphs_bintree_tag */) {
+    switch (tag) {
+        case GRAPHS_BINTREE_TAG_BRANCH: return "GRAPHS_BINTREE_TAG_BRANCH";
+        case GRAPHS_BINTREE_TAG_DATA: return "GRAPHS_BINTREE_TAG_DATA";
+        default: return "__unknown__";
+    }
+}
+void graphs_bintree_cleanup(graphs_bintree_t *it);
+void graphs_bintree_cleanup_voidstar(void *it);
+int graphs_bintree_parse(graphs_bintree_t *it, lexer_t *lexer);
+int graphs_bintree_parse_voidstar(void *it, lexer_t *lexer);
+int graphs_bintree_write(graphs_bintree_t *it, writer_t *writer);
+int graphs_bintree_write_voidstar(void *it, writer_t *writer);
+void graphs_bintree_branch_cleanup(graphs_bintree_branch_t *it);
+void graphs_bintree_branch_cleanup_voidstar(void *it);
+int graphs_bintree_branch_parse(graphs_bintree_branch_t *it, lexer_t *lexer);
+int graphs_bintree_branch_parse_voidstar(void *it, lexer_t *lexer);
+int graphs_bintree_branch_write(graphs_bintree_branch_t *it, writer_t *writer);
+int graphs_bintree_branch_write_voidstar(void *it, writer_t *writer);
+void arrayof_graphs_tree_cleanup(arrayof_graphs_tree_t *it);
+void arrayof_graphs_tree_cleanup_voidstar(void *it);
+int arrayof_graphs_tree_parse(arrayof_graphs_tree_t *it, lexer_t *lexer);
+int arrayof_graphs_tree_parse_voidstar(void *it, lexer_t *lexer);
+int arrayof_graphs_tree_write(arrayof_graphs_tree_t *it, writer_t *writer);
+int arrayof_graphs_tree_write_voidstar(void *it, writer_t *writer);
+void graphs_tree_cleanup(graphs_tree_t *it);
+void graphs_tree_cleanup_voidstar(void *it);
+int graphs_tree_parse(graphs_tree_t *it, lexer_t *lexer);
+int graphs_tree_parse_voidstar(void *it, lexer_t *lexer);
+int graphs_tree_write(graphs_tree_t *it, writer_t *writer);
+int graphs_tree_write_voidstar(void *it, writer_t *writer);
+
+/* FUS types */
+type_t types[TYPES] = { /* Indexed by: enum types */
+    {
+        .name = "any",
+        .cleanup = &any_cleanup_voidstar,
+        .parse = &any_parse_voidstar,
+        .write = &any_write_voidstar,
+    }
+    ,{
+        .name = "type",
+        .cleanup = NULL,
+        .parse = &type_parse_voidstar,
+        .write = &type_write_voidstar,
+    }
+    ,{
+        .name = "graphs_bintree",
+        .cleanup = &graphs_bintree_cleanup_voidstar,
+        .parse = &graphs_bintree_parse_voidstar,
+        .write = &graphs_bintree_write_voidstar,
+    }
+    ,{
+        .name = "graphs_bintree_branch",
+        .cleanup = &graphs_bintree_branch_cleanup_voidstar,
+        .parse = &graphs_bintree_branch_parse_voidstar,
+        .write = &graphs_bintree_branch_write_voidstar,
+    }
+    ,{
+        .name = "arrayof_graphs_tree",
+        .cleanup = &arrayof_graphs_tree_cleanup_voidstar,
+        .parse = &arrayof_graphs_tree_parse_voidstar,
+        .write = &arrayof_graphs_tree_write_voidstar,
+    }
+    ,{
+        .name = "graphs_tree",
+        .cleanup = &graphs_tree_cleanup_voidstar,
+        .parse = &graphs_tree_parse_voidstar,
+        .write = &graphs_tree_write_voidstar,
+    }
+};
+
+/* FUS function definitions */
+void any_cleanup(any_t *it) {
+    if (!it->type || !it->type->cleanup) return;
+    /* NOTE: we can safely use it->u.p, because types which have
+    a cleanup function are guaranteed to use pointers. */
+    it->type->cleanup(it->u.p);
+}
+void any_cleanup_voidstar(void *it) { any_cleanup((any_t *) it); }
+int any_parse(any_t *it, lexer_t *lexer) {
+}
+int any_parse_voidstar(void *it, lexer_t *lexer) { return any_parse((any_t *) it, lexer); }
+int any_write(any_t *it, writer_t *writer) {
+}
+int any_write_voidstar(void *it, writer_t *writer) { return any_write((any_t *) it, writer); }
+int type_parse(type_t *it, lexer_t *lexer) {
+}
+int type_parse_voidstar(void *it, lexer_t *lexer) { return type_parse((type_t *) it, lexer); }
+int type_write(type_t *it, writer_t *writer) {
+}
+int type_write_voidstar(void *it, writer_t *writer) { return type_write((type_t *) it, writer); }
+void graphs_bintree_cleanup(graphs_bintree_t *it) {
+    switch (it->tag) {
+        case GRAPHS_BINTREE_TAG_BRANCH:
+            graphs_bintree_branch_cleanup(it->u.branch);
+            break;
+        case GRAPHS_BINTREE_TAG_DATA:
+            any_cleanup(&it->u.data);
+            break;
+        default: break;
+    }
+    memset(it, 0, sizeof(*it));
+}
+void graphs_bintree_cleanup_voidstar(void *it) { graphs_bintree_cleanup((graphs_bintree_t *) it); }
+int graphs_bintree_parse(graphs_bintree_t *it, lexer_t *lexer) {
+}
+int graphs_bintree_parse_voidstar(void *it, lexer_t *lexer) { return graphs_bintree_parse((graphs_bintree_t *) it, lexer); }
+int graphs_bintree_write(graphs_bintree_t *it, writer_t *writer) {
+}
+int graphs_bintree_write_voidstar(void *it, writer_t *writer) { return graphs_bintree_write((graphs_bintree_t *) it, writer); }
+void graphs_bintree_branch_cleanup(graphs_bintree_branch_t *it) {
+    graphs_bintree_cleanup(it->left);
+    graphs_bintree_cleanup(it->right);
+    memset(it, 0, sizeof(*it));
+}
+void graphs_bintree_branch_cleanup_voidstar(void *it) { graphs_bintree_branch_cleanup((graphs_bintree_branch_t *) it); }
+int graphs_bintree_branch_parse(graphs_bintree_branch_t *it, lexer_t *lexer) {
+}
+int graphs_bintree_branch_parse_voidstar(void *it, lexer_t *lexer) { return graphs_bintree_branch_parse((graphs_bintree_branch_t *) it, lexer); }
+int graphs_bintree_branch_write(graphs_bintree_branch_t *it, writer_t *writer) {
+}
+int graphs_bintree_branch_write_voidstar(void *it, writer_t *writer) { return graphs_bintree_branch_write((graphs_bintree_branch_t *) it, writer); }
+void arrayof_graphs_tree_cleanup(arrayof_graphs_tree_t *it) {
+    for (int i = 0; i < it->len; i++) {
+        graphs_tree_cleanup(it->elems[i]);
+    }
+    free(it->elems);
+    memset(it, 0, sizeof(*it));
+}
+void arrayof_graphs_tree_cleanup_voidstar(void *it) { arrayof_graphs_tree_cleanup((arrayof_graphs_tree_t *) it); }
+int arrayof_graphs_tree_parse(arrayof_graphs_tree_t *it, lexer_t *lexer) {
+}
+int arrayof_graphs_tree_parse_voidstar(void *it, lexer_t *lexer) { return arrayof_graphs_tree_parse((arrayof_graphs_tree_t *) it, lexer); }
+int arrayof_graphs_tree_write(arrayof_graphs_tree_t *it, writer_t *writer) {
+}
+int arrayof_graphs_tree_write_voidstar(void *it, writer_t *writer) { return arrayof_graphs_tree_write((arrayof_graphs_tree_t *) it, writer); }
+void graphs_tree_cleanup(graphs_tree_t *it) {
+    arrayof_graphs_tree_cleanup(&it->children);
+    any_cleanup(&it->data);
+    memset(it, 0, sizeof(*it));
+}
+void graphs_tree_cleanup_voidstar(void *it) { graphs_tree_cleanup((graphs_tree_t *) it); }
+int graphs_tree_parse(graphs_tree_t *it, lexer_t *lexer) {
+}
+int graphs_tree_parse_voidstar(void *it, lexer_t *lexer) { return graphs_tree_parse((graphs_tree_t *) it, lexer); }
+int graphs_tree_write(graphs_tree_t *it, writer_t *writer) {
+}
+int graphs_tree_write_voidstar(void *it, writer_t *writer) { return graphs_tree_write((graphs_tree_t *) it, writer); }
+
+/* Dummy main */
+int main(int n_args, char **args) { return 0; }
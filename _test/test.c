@@ -0,0 +1,882 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* FUS typedefs */
+typedef struct lexer lexer_t;
+typedef struct writer writer_t;
+typedef struct any any_t;
+typedef struct type type_t;
+typedef struct cycle1_A cycle1_A_t;
+typedef struct cycle1_B cycle1_B_t;
+typedef struct cycle2_C cycle2_C_t;
+typedef struct cycle2_A cycle2_A_t;
+typedef cycle2_C_t cycle2_B_t;
+typedef int cycle3_B_t;
+typedef cycle3_B_t cycle3_A_t;
+typedef int no_package_int_t;
+typedef no_package_int_t no_package_int_alias_t;
+typedef size_t util_math_complex_t;
+typedef size_t util_math_real_t;
+typedef int test_int_t;
+typedef test_int_t test_integer_t;
+typedef struct arrayof_int arrayof_int_t;
+typedef arrayof_int_t test_intarray_t;
+typedef arrayof_int_t test_intarray2_t;
+typedef struct test_grid_cells_elem test_grid_cells_elem_t;
+typedef struct arrayof_inplace_test_grid_cells_elem arrayof_inplace_test_grid_cells_elem_t;
+typedef struct arrayof_arrayof_inplace_test_grid_cells_elem arrayof_arrayof_inplace_test_grid_cells_elem_t;
+typedef struct test_grid test_grid_t;
+typedef struct test_empty_struct test_empty_struct_t;
+typedef struct test_empty_union test_empty_union_t;
+typedef struct arrayof_test_country_areas_elem arrayof_test_country_areas_elem_t;
+typedef struct test_country test_country_t;
+typedef struct test_country_areas_elem test_country_areas_elem_t;
+typedef struct test_country_areas_elem_details test_country_areas_elem_details_t;
+typedef struct test_country_areas_elem_details_territory test_country_areas_elem_details_territory_t;
+typedef struct arrayof_string arrayof_string_t;
+typedef struct test_country_areas_elem_details_province test_country_areas_elem_details_province_t;
+
+/* FUS enums */
+enum types {
+    TYPE_ANY,
+    TYPE_TYPE,
+    TYPE_CYCLE1_A,
+    TYPE_CYCLE1_B,
+    TYPE_CYCLE2_C,
+    TYPE_CYCLE2_A,
+    TYPE_CYCLE2_B,
+    TYPE_CYCLE3_B,
+    TYPE_CYCLE3_A,
+    TYPE_NO_PACKAGE_INT,
+    TYPE_NO_PACKAGE_INT_ALIAS,
+    TYPE_UTIL_MATH_COMPLEX,
+    TYPE_UTIL_MATH_REAL,
+    TYPE_TEST_INT,
+    TYPE_TEST_INTEGER,
+    TYPE_ARRAYOF_INT,
+    TYPE_TEST_INTARRAY,
+    TYPE_TEST_INTARRAY2,
+    TYPE_TEST_GRID_CELLS_ELEM,
+    TYPE_ARRAYOF_INPLACE_TEST_GRID_CELLS_ELEM,
+    TYPE_ARRAYOF_ARRAYOF_INPLACE_TEST_GRID_CELLS_ELEM,
+    TYPE_TEST_GRID,
+    TYPE_TEST_EMPTY_STRUCT,
+    TYPE_TEST_EMPTY_UNION,
+    TYPE_ARRAYOF_TEST_COUNTRY_AREAS_ELEM,
+    TYPE_TEST_COUNTRY,
+    TYPE_TEST_COUNTRY_AREAS_ELEM,
+    TYPE_TEST_COUNTRY_AREAS_ELEM_DETAILS,
+    TYPE_TEST_COUNTRY_AREAS_ELEM_DETAILS_TERRITORY,
+    TYPE_ARRAYOF_STRING,
+    TYPE_TEST_COUNTRY_AREAS_ELEM_DETAILS_PROVINCE,
+    TYPES
+};
+enum test_empty_union_tag {
+    TEST_EMPTY_UNION_TAGS
+};
+enum test_country_areas_elem_details_tag {
+    TEST_COUNTRY_AREAS_ELEM_DETAILS_TAG_TERRITORY,
+    TEST_COUNTRY_AREAS_ELEM_DETAILS_TAG_PROVINCE,
+    TEST_COUNTRY_AREAS_ELEM_DETAILS_TAGS
+};
+
+/* FUS structs */
+struct any {
+    type_t *type;
+    int weakref: 1;
+    union {
+        char c; /* byte */
+        bool b; /* bool */
+        int i; /* int, err */
+        const char *s; /* string */
+        void (*fp)(); /* func */
+        void *p; /* everything else */
+    } u;
+};
+struct type {
+    const char *name;
+    /* TODO: tag and union with type's details, e.g. fields */
+    void (*cleanup)(void *it);
+    int (*parse)(void *it, lexer_t *lexer);
+    int (*write)(void *it, writer_t *writer);
+};
+struct cycle1_A {
+    cycle1_B_t* b;
+};
+struct cycle1_B {
+    cycle1_A_t* a;
+};
+struct cycle2_C {
+    int whatever;
+};
+struct cycle2_A {
+    cycle2_B_t b;
+};
+struct arrayof_int {
+    size_t size;
+    size_t len;
+    int *elems;
+};
+struct test_grid_cells_elem {
+    any_t data;
+};
+struct arrayof_inplace_test_grid_cells_elem {
+    size_t size;
+    size_t len;
+    test_grid_cells_elem_t *elems;
+};
+struct arrayof_arrayof_inplace_test_grid_cells_elem {
+    size_t size;
+    size_t len;
+    arrayof_inplace_test_grid_cells_elem_t *elems;
+};
+struct test_grid {
+    int w;
+    int h;
+    int /* err */ error;
+    arrayof_arrayof_inplace_test_grid_cells_elem_t cells;
+};
+struct test_empty_struct {
+};
+struct test_empty_union {
+    int tag; /* enum test_empty_union_tag */
+    union {
+    } u;
+};
+struct arrayof_test_country_areas_elem {
+    size_t size;
+    size_t len;
+    test_country_areas_elem_t* *elems;
+};
+struct test_country {
+    const char * name;
+    test_grid_t grid;
+    util_math_complex_t* coord;
+    char /* void */ unused;
+    arrayof_test_country_areas_elem_t areas;
+};
+struct test_country_areas_elem {
+    const char * name;
+    test_country_areas_elem_details_t* details;
+};
+struct test_country_areas_elem_details {
+    int tag; /* enum test_country_areas_elem_details_tag */
+    union {
+        test_country_areas_elem_details_territory_t* territory;
+        test_country_areas_elem_details_province_t* province;
+    } u;
+};
+struct test_country_areas_elem_details_territory {
+    arrayof_int_t years;
+    util_math_real_t* amount;
+};
+struct arrayof_string {
+    size_t size;
+    size_t len;
+    const char * *elems;
+};
+struct test_country_areas_elem_details_province {
+    arrayof_string_t names;
+};
+
+/* FUS types */
+extern type_t types[TYPES]; /* Indexed by: enum types */
+
+/* FUS function prototypes */
+void any_cleanup(any_t *it);
+void any_cleanup_voidstar(void *it);
+int any_parse(any_t *it, lexer_t *lexer);
+int any_parse_voidstar(void *it, lexer_t *lexer);
+int any_write(any_t *it, writer_t *writer);
+int any_write_voidstar(void *it, writer_t *writer);
+#define type_cleanup (void)
+#define type_cleanup_voidstar (void)
+int type_parse(type_t *it, lexer_t *lexer);
+int type_parse_voidstar(void *it, lexer_t *lexer);
+int type_write(type_t *it, writer_t *writer);
+int type_write_voidstar(void *it, writer_t *writer);
+void cycle1_A_cleanup(cycle1_A_t *it);
+void cycle1_A_cleanup_voidstar(void *it);
+int cycle1_A_parse(cycle1_A_t *it, lexer_t *lexer);
+int cycle1_A_parse_voidstar(void *it, lexer_t *lexer);
+int cycle1_A_write(cycle1_A_t *it, writer_t *writer);
+int cycle1_A_write_voidstar(void *it, writer_t *writer);
+void cycle1_B_cleanup(cycle1_B_t *it);
+void cycle1_B_cleanup_voidstar(void *it);
+int cycle1_B_parse(cycle1_B_t *it, lexer_t *lexer);
+int cycle1_B_parse_voidstar(void *it, lexer_t *lexer);
+int cycle1_B_write(cycle1_B_t *it, writer_t *writer);
+int cycle1_B_write_voidstar(void *it, writer_t *writer);
+void cycle2_C_cleanup(cycle2_C_t *it);
+void cycle2_C_cleanup_voidstar(void *it);
+int cycle2_C_parse(cycle2_C_t *it, lexer_t *lexer);
+int cycle2_C_parse_voidstar(void *it, lexer_t *lexer);
+int cycle2_C_write(cycle2_C_t *it, writer_t *writer);
+int cycle2_C_write_voidstar(void *it, writer_t *writer);
+void cycle2_A_cleanup(cycle2_A_t *it);
+void cycle2_A_cleanup_voidstar(void *it);
+int cycle2_A_parse(cycle2_A_t *it, lexer_t *lexer);
+int cycle2_A_parse_voidstar(void *it, lexer_t *lexer);
+int cycle2_A_write(cycle2_A_t *it, writer_t *writer);
+int cycle2_A_write_voidstar(void *it, writer_t *writer);
+#define cycle2_B_cleanup cycle2_C_cleanup
+#define cycle2_B_cleanup_voidstar cycle2_C_cleanup_voidstar
+int cycle2_B_parse(cycle2_B_t *it, lexer_t *lexer);
+int cycle2_B_parse_voidstar(void *it, lexer_t *lexer);
+int cycle2_B_write(cycle2_B_t *it, writer_t *writer);
+int cycle2_B_write_voidstar(void *it, writer_t *writer);
+#define cycle3_B_cleanup (void)
+#define cycle3_B_cleanup_voidstar (void)
+int cycle3_B_parse(cycle3_B_t *it, lexer_t *lexer);
+int cycle3_B_parse_voidstar(void *it, lexer_t *lexer);
+int cycle3_B_write(cycle3_B_t *it, writer_t *writer);
+int cycle3_B_write_voidstar(void *it, writer_t *writer);
+#define cycle3_A_cleanup (void)
+#define cycle3_A_cleanup_voidstar (void)
+int cycle3_A_parse(cycle3_A_t *it, lexer_t *lexer);
+int cycle3_A_parse_voidstar(void *it, lexer_t *lexer);
+int cycle3_A_write(cycle3_A_t *it, writer_t *writer);
+int cycle3_A_write_voidstar(void *it, writer_t *writer);
+#define no_package_int_cleanup (void)
+#define no_package_int_cleanup_voidstar (void)
+int no_package_int_parse(no_package_int_t *it, lexer_t *lexer);
+int no_package_int_parse_voidstar(void *it, lexer_t *lexer);
+int no_package_int_write(no_package_int_t *it, writer_t *writer);
+int no_package_int_write_voidstar(void *it, writer_t *writer);
+#define no_package_int_alias_cleanup (void)
+#define no_package_int_alias_cleanup_voidstar (void)
+int no_package_int_alias_parse(no_package_int_alias_t *it, lexer_t *lexer);
+int no_package_int_alias_parse_voidstar(void *it, lexer_t *lexer);
+int no_package_int_alias_write(no_package_int_alias_t *it, writer_t *writer);
+int no_package_int_alias_write_voidstar(void *it, writer_t *writer);
+#define util_math_complex_cleanup (void)
+#define util_math_complex_cleanup_voidstar (void)
+int util_math_complex_parse(util_math_complex_t *it, lexer_t *lexer);
+int util_math_complex_parse_voidstar(void *it, lexer_t *lexer);
+int util_math_complex_write(util_math_complex_t *it, writer_t *writer);
+int util_math_complex_write_voidstar(void *it, writer_t *writer);
+#define util_math_real_cleanup (void)
+#define util_math_real_cleanup_voidstar (void)
+int util_math_real_parse(util_math_real_t *it, lexer_t *lexer);
+int util_math_real_parse_voidstar(void *it, lexer_t *lexer);
+int util_math_real_write(util_math_real_t *it, writer_t *writer);
+int util_math_real_write_voidstar(void *it, writer_t *writer);
+#define test_int_cleanup (void)
+#define test_int_cleanup_voidstar (void)
+int test_int_parse(test_int_t *it, lexer_t *lexer);
+int test_int_parse_voidstar(void *it, lexer_t *lexer);
+int test_int_write(test_int_t *it, writer_t *writer);
+int test_int_write_voidstar(void *it, writer_t *writer);
+#define test_integer_cleanup (void)
+#define test_integer_cleanup_voidstar (void)
+int test_integer_parse(test_integer_t *it, lexer_t *lexer);
+int test_integer_parse_voidstar(void *it, lexer_t *lexer);
+int test_integer_write(test_integer_t *it, writer_t *writer);
+int test_integer_write_voidstar(void *it, writer_t *writer);
+void arrayof_int_cleanup(arrayof_int_t *it);
+void arrayof_int_cleanup_voidstar(void *it);
+int arrayof_int_parse(arrayof_int_t *it, lexer_t *lexer);
+int arrayof_int_parse_voidstar(void *it, lexer_t *lexer);
+int arrayof_int_write(arrayof_int_t *it, writer_t *writer);
+int arrayof_int_write_voidstar(void *it, writer_t *writer);
+#define test_intarray_cleanup arrayof_int_cleanup
+#define test_intarray_cleanup_voidstar arrayof_int_cleanup_voidstar
+int test_intarray_parse(test_intarray_t *it, lexer_t *lexer);
+int test_intarray_parse_voidstar(void *it, lexer_t *lexer);
+int test_intarray_write(test_intarray_t *it, writer_t *writer);
+int test_intarray_write_voidstar(void *it, writer_t *writer);
+#define test_intarray2_cleanup arrayof_int_cleanup
+#define test_intarray2_cleanup_voidstar arrayof_int_cleanup_voidstar
+int test_intarray2_parse(test_intarray2_t *it, lexer_t *lexer);
+int test_intarray2_parse_voidstar(void *it, lexer_t *lexer);
+int test_intarray2_write(test_intarray2_t *it, writer_t *writer);
+int test_intarray2_write_voidstar(void *it, writer_t *writer);
+void test_grid_cells_elem_cleanup(test_grid_cells_elem_t *it);
+void test_grid_cells_elem_cleanup_voidstar(void *it);
+int test_grid_cells_elem_parse(test_grid_cells_elem_t *it, lexer_t *lexer);
+int test_grid_cells_elem_parse_voidstar(void *it, lexer_t *lexer);
+int test_grid_cells_elem_write(test_grid_cells_elem_t *it, writer_t *writer);
+int test_grid_cells_elem_write_voidstar(void *it, writer_t *writer);
+void arrayof_inplace_test_grid_cells_elem_cleanup(arrayof_inplace_test_grid_cells_elem_t *it);
+void arrayof_inplace_test_grid_cells_elem_cleanup_voidstar(void *it);
+int arrayof_inplace_test_grid_cells_elem_parse(arrayof_inplace_test_grid_cells_elem_t *it, lexer_t *lexer);
+int arrayof_inplace_test_grid_cells_elem_parse_voidstar(void *it, lexer_t *lexer);
+int arrayof_inplace_test_grid_cells_elem_write(arrayof_inplace_test_grid_cells_elem_t *it, writer_t *writer);
+int arrayof_inplace_test_grid_cells_elem_write_voidstar(void *it, writer_t *writer);
+void arrayof_arrayof_inplace_test_grid_cells_elem_cleanup(arrayof_arrayof_inplace_test_grid_cells_elem_t *it);
+void arrayof_arrayof_inplace_test_grid_cells_elem_cleanup_voidstar(void *it);
+int arrayof_arrayof_inplace_test_grid_cells_elem_parse(arrayof_arrayof_inplace_test_grid_cells_elem_t *it, lexer_t *lexer);
+int arrayof_arrayof_inplace_test_grid_cells_elem_parse_voidstar(void *it, lexer_t *lexer);
+int arrayof_arrayof_inplace_test_grid_cells_elem_write(arrayof_arrayof_inplace_test_grid_cells_elem_t *it, writer_t *writer);
+int arrayof_arrayof_inplace_test_grid_cells_elem_write_voidstar(void *it, writer_t *writer);
+void test_grid_cleanup(test_grid_t *it);
+void test_grid_cleanup_voidstar(void *it);
+int test_grid_parse(test_grid_t *it, lexer_t *lexer);
+int test_grid_parse_voidstar(void *it, lexer_t *lexer);
+int test_grid_write(test_grid_t *it, writer_t *writer);
+int test_grid_write_voidstar(void *it, writer_t *writer);
+void test_empty_struct_cleanup(test_empty_struct_t *it);
+void test_empty_struct_cleanup_voidstar(void *it);
+int test_empty_struct_parse(test_empty_struct_t *it, lexer_t *lexer);
+int test_empty_struct_parse_voidstar(void *it, lexer_t *lexer);
+int test_empty_struct_write(test_empty_struct_t *it, writer_t *writer);
+int test_empty_struct_write_voidstar(void *it, writer_t *writer);
+static const char *test_empty_union_tag_string(int tag /* enum test_empty_union_tag */) {
+    switch (tag) {
+        default: return "__unknown__";
+    }
+}
+void test_empty_union_cleanup(test_empty_union_t *it);
+void test_empty_union_cleanup_voidstar(void *it);
+int test_empty_union_parse(test_empty_union_t *it, lexer_t *lexer);
+int test_empty_union_parse_voidstar(void *it, lexer_t *lexer);
+int test_empty_union_write(test_empty_union_t *it, writer_t *writer);
+int test_empty_union_write_voidstar(void *it, writer_t *writer);
+void arrayof_test_country_areas_elem_cleanup(arrayof_test_country_areas_elem_t *it);
+void arrayof_test_country_areas_elem_cleanup_voidstar(void *it);
+int arrayof_test_country_areas_elem_parse(arrayof_test_country_areas_elem_t *it, lexer_t *lexer);
+int arrayof_test_country_areas_elem_parse_voidstar(void *it, lexer_t *lexer);
+int arrayof_test_country_areas_elem_write(arrayof_test_country_areas_elem_t *it, writer_t *writer);
+int arrayof_test_country_areas_elem_write_voidstar(void *it, writer_t *writer);
+void test_country_cleanup(test_country_t *it);
+void test_country_cleanup_voidstar(void *it);
+int test_country_parse(test_country_t *it, lexer_t *lexer);
+int test_country_parse_voidstar(void *it, lexer_t *lexer);
+int test_country_write(test_country_t *it, writer_t *writer);
+int test_country_write_voidstar(void *it, writer_t *writer);
+void test_country_areas_elem_cleanup(test_country_areas_elem_t *it);
+void test_country_areas_elem_cleanup_voidstar(void *it);
+int test_country_areas_elem_parse(test_country_areas_elem_t *it, lexer_t *lexer);
+int test_country_areas_elem_parse_voidstar(void *it, lexer_t *lexer);
+int test_country_areas_elem_write(test_country_areas_elem_t *it, writer_t *writer);
+int test_country_areas_elem_write_voidstar(void *it, writer_t *writer);
+static const char *test_country_areas_elem_details_tag_string(int tag /* enum test_country_areas_elem_details_tag */) {
+    switch (tag) {
+        case TEST_COUNTRY_AREAS_ELEM_DETAILS_TAG_TERRITORY: return "TEST_COUNTRY_AREAS_ELEM_DETAILS_TAG_TERRITORY";
+        case TEST_COUNTRY_AREAS_ELEM_DETAILS_TAG_PROVINCE: return "TEST_COUNTRY_AREAS_ELEM_DETAILS_TAG_PROVINCE";
+        default: return "__unknown__";
+    }
+}
+void test_country_areas_elem_details_cleanup(test_country_areas_elem_details_t *it);
+void test_country_areas_elem_details_cleanup_voidstar(void *it);
+int test_country_areas_elem_details_parse(test_country_areas_elem_details_t *it, lexer_t *lexer);
+int test_country_areas_elem_details_parse_voidstar(void *it, lexer_t *lexer);
+int test_country_areas_elem_details_write(test_country_areas_elem_details_t *it, writer_t *writer);
+int test_country_areas_elem_details_write_voidstar(void *it, writer_t *writer);
+void test_country_areas_elem_details_territory_cleanup(test_country_areas_elem_details_territory_t *it);
+void test_country_areas_elem_details_territory_cleanup_voidstar(void *it);
+int test_country_areas_elem_details_territory_parse(test_country_areas_elem_details_territory_t *it, lexer_t *lexer);
+int test_country_areas_elem_details_territory_parse_voidstar(void *it, lexer_t *lexer);
+int test_country_areas_elem_details_territory_write(test_country_areas_elem_details_territory_t *it, writer_t *writer);
+int test_country_areas_elem_details_territory_write_voidstar(void *it, writer_t *writer);
+void arrayof_string_cleanup(arrayof_string_t *it);
+void arrayof_string_cleanup_voidstar(void *it);
+int arrayof_string_parse(arrayof_string_t *it, lexer_t *lexer);
+int arrayof_string_parse_voidstar(void *it, lexer_t *lexer);
+int arrayof_string_write(arrayof_string_t *it, writer_t *writer);
+int arrayof_string_write_voidstar(void *it, writer_t *writer);
+void test_country_areas_elem_details_province_cleanup(test_country_areas_elem_details_province_t *it);
+void test_country_areas_elem_details_province_cleanup_voidstar(void *it);
+int test_country_areas_elem_details_province_parse(test_country_areas_elem_details_province_t *it, lexer_t *lexer);
+int test_country_areas_elem_details_province_parse_voidstar(void *it, lexer_t *lexer);
+int test_country_areas_elem_details_province_write(test_country_areas_elem_details_province_t *it, writer_t *writer);
+int test_country_areas_elem_details_province_write_voidstar(void *it, writer_t *writer);
+
+/* FUS types */
+type_t types[TYPES] = { /* Indexed by: enum types */
+    {
+        .name = "any",
+        .cleanup = &any_cleanup_voidstar,
+        .parse = &any_parse_voidstar,
+        .write = &any_write_voidstar,
+    }
+    ,{
+        .name = "type",
+        .cleanup = NULL,
+        .parse = &type_parse_voidstar,
+        .write = &type_write_voidstar,
+    }
+    ,{
+        .name = "cycle1_A",
+        .cleanup = &cycle1_A_cleanup_voidstar,
+        .parse = &cycle1_A_parse_voidstar,
+        .write = &cycle1_A_write_voidstar,
+    }
+    ,{
+        .name = "cycle1_B",
+        .cleanup = &cycle1_B_cleanup_voidstar,
+        .parse = &cycle1_B_parse_voidstar,
+        .write = &cycle1_B_write_voidstar,
+    }
+    ,{
+        .name = "cycle2_C",
+        .cleanup = &cycle2_C_cleanup_voidstar,
+        .parse = &cycle2_C_parse_voidstar,
+        .write = &cycle2_C_write_voidstar,
+    }
+    ,{
+        .name = "cycle2_A",
+        .cleanup = &cycle2_A_cleanup_voidstar,
+        .parse = &cycle2_A_parse_voidstar,
+        .write = &cycle2_A_write_voidstar,
+    }
+    ,{
+        .name = "cycle2_B",
+        .cleanup = &cycle2_B_cleanup_voidstar,
+        .parse = &cycle2_B_parse_voidstar,
+        .write = &cycle2_B_write_voidstar,
+    }
+    ,{
+        .name = "cycle3_B",
+        .cleanup = NULL,
+        .parse = &cycle3_B_parse_voidstar,
+        .write = &cycle3_B_write_voidstar,
+    }
+    ,{
+        .name = "cycle3_A",
+        .cleanup = NULL,
+        .parse = &cycle3_A_parse_voidstar,
+        .write = &cycle3_A_write_voidstar,
+    }
+    ,{
+        .name = "no_package_int",
+        .cleanup = NULL,
+        .parse = &no_package_int_parse_voidstar,
+        .write = &no_package_int_write_voidstar,
+    }
+    ,{
+        .name = "no_package_int_alias",
+        .cleanup = NULL,
+        .parse = &no_package_int_alias_parse_voidstar,
+        .write = &no_package_int_alias_write_voidstar,
+    }
+    ,{
+        .name = "util_math_complex",
+        .cleanup = NULL,
+        .parse = &util_math_complex_parse_voidstar,
+        .write = &util_math_complex_write_voidstar,
+    }
+    ,{
+        .name = "util_math_real",
+        .cleanup = NULL,
+        .parse = &util_math_real_parse_voidstar,
+        .write = &util_math_real_write_voidstar,
+    }
+    ,{
+        .name = "test_int",
+        .cleanup = NULL,
+        .parse = &test_int_parse_voidstar,
+        .write = &test_int_write_voidstar,
+    }
+    ,{
+        .name = "test_integer",
+        .cleanup = NULL,
+        .parse = &test_integer_parse_voidstar,
+        .write = &test_integer_write_voidstar,
+    }
+    ,{
+        .name = "arrayof_int",
+        .cleanup = &arrayof_int_cleanup_voidstar,
+        .parse = &arrayof_int_parse_voidstar,
+        .write = &arrayof_int_write_voidstar,
+    }
+    ,{
+        .name = "test_intarray",
+        .cleanup = &test_intarray_cleanup_voidstar,
+        .parse = &test_intarray_parse_voidstar,
+        .write = &test_intarray_write_voidstar,
+    }
+    ,{
+        .name = "test_intarray2",
+        .cleanup = &test_intarray2_cleanup_voidstar,
+        .parse = &test_intarray2_parse_voidstar,
+        .write = &test_intarray2_write_voidstar,
+    }
+    ,{
+        .name = "test_grid_cells_elem",
+        .cleanup = &test_grid_cells_elem_cleanup_voidstar,
+        .parse = &test_grid_cells_elem_parse_voidstar,
+        .write = &test_grid_cells_elem_write_voidstar,
+    }
+    ,{
+        .name = "arrayof_inplace_test_grid_cells_elem",
+        .cleanup = &arrayof_inplace_test_grid_cells_elem_cleanup_voidstar,
+        .parse = &arrayof_inplace_test_grid_cells_elem_parse_voidstar,
+        .write = &arrayof_inplace_test_grid_cells_elem_write_voidstar,
+    }
+    ,{
+        .name = "arrayof_arrayof_inplace_test_grid_cells_elem",
+        .cleanup = &arrayof_arrayof_inplace_test_grid_cells_elem_cleanup_voidstar,
+        .parse = &arrayof_arrayof_inplace_test_grid_cells_elem_parse_voidstar,
+        .write = &arrayof_arrayof_inplace_test_grid_cells_elem_write_voidstar,
+    }
+    ,{
+        .name = "test_grid",
+        .cleanup = &test_grid_cleanup_voidstar,
+        .parse = &test_grid_parse_voidstar,
+        .write = &test_grid_write_voidstar,
+    }
+    ,{
+        .name = "test_empty_struct",
+        .cleanup = &test_empty_struct_cleanup_voidstar,
+        .parse = &test_empty_struct_parse_voidstar,
+        .write = &test_empty_struct_write_voidstar,
+    }
+    ,{
+        .name = "test_empty_union",
+        .cleanup = &test_empty_union_cleanup_voidstar,
+        .parse = &test_empty_union_parse_voidstar,
+        .write = &test_empty_union_write_voidstar,
+    }
+    ,{
+        .name = "arrayof_test_country_areas_elem",
+        .cleanup = &arrayof_test_country_areas_elem_cleanup_voidstar,
+        .parse = &arrayof_test_country_areas_elem_parse_voidstar,
+        .write = &arrayof_test_country_areas_elem_write_voidstar,
+    }
+    ,{
+        .name = "test_country",
+        .cleanup = &test_country_cleanup_voidstar,
+        .parse = &test_country_parse_voidstar,
+        .write = &test_country_write_voidstar,
+    }
+    ,{
+        .name = "test_country_areas_elem",
+        .cleanup = &test_country_areas_elem_cleanup_voidstar,
+        .parse = &test_country_areas_elem_parse_voidstar,
+        .write = &test_country_areas_elem_write_voidstar,
+    }
+    ,{
+        .name = "test_country_areas_elem_details",
+        .cleanup = &test_country_areas_elem_details_cleanup_voidstar,
+        .parse = &test_country_areas_elem_details_parse_voidstar,
+        .write = &test_country_areas_elem_details_write_voidstar,
+    }
+    ,{
+        .name = "test_country_areas_elem_details_territory",
+        .cleanup = &test_country_areas_elem_details_territory_cleanup_voidstar,
+        .parse = &test_country_areas_elem_details_territory_parse_voidstar,
+        .write = &test_country_areas_elem_details_territory_write_voidstar,
+    }
+    ,{
+        .name = "arrayof_string",
+        .cleanup = &arrayof_string_cleanup_voidstar,
+        .parse = &arrayof_string_parse_voidstar,
+        .write = &arrayof_string_write_voidstar,
+    }
+    ,{
+        .name = "test_country_areas_elem_details_province",
+        .cleanup = &test_country_areas_elem_details_province_cleanup_voidstar,
+        .parse = &test_country_areas_elem_details_province_parse_voidstar,
+        .write = &test_country_areas_elem_details_province_write_voidstar,
+    }
+};
+
+/* FUS function definitions */
+void any_cleanup(any_t *it) {
+    if (!it->type || !it->type->cleanup) return;
+    /* NOTE: we can safely use it->u.p, because types which have
+    a cleanup function are guaranteed to use pointers. */
+    it->type->cleanup(it->u.p);
+}
+void any_cleanup_voidstar(void *it) { any_cleanup((any_t *) it); }
+int any_parse(any_t *it, lexer_t *lexer) {
+}
+int any_parse_voidstar(void *it, lexer_t *lexer) { return any_parse((any_t *) it, lexer); }
+int any_write(any_t *it, writer_t *writer) {
+}
+int any_write_voidstar(void *it, writer_t *writer) { return any_write((any_t *) it, writer); }
+int type_parse(type_t *it, lexer_t *lexer) {
+}
+int type_parse_voidstar(void *it, lexer_t *lexer) { return type_parse((type_t *) it, lexer); }
+int type_write(type_t *it, writer_t *writer) {
+}
+int type_write_voidstar(void *it, writer_t *writer) { return type_write((type_t *) it, writer); }
+void cycle1_A_cleanup(cycle1_A_t *it) {
+    cycle1_B_cleanup(it->b);
+    memset(it, 0, sizeof(*it));
+}
+void cycle1_A_cleanup_voidstar(void *it) { cycle1_A_cleanup((cycle1_A_t *) it); }
+int cycle1_A_parse(cycle1_A_t *it, lexer_t *lexer) {
+}
+int cycle1_A_parse_voidstar(void *it, lexer_t *lexer) { return cycle1_A_parse((cycle1_A_t *) it, lexer); }
+int cycle1_A_write(cycle1_A_t *it, writer_t *writer) {
+}
+int cycle1_A_write_voidstar(void *it, writer_t *writer) { return cycle1_A_write((cycle1_A_t *) it, writer); }
+void cycle1_B_cleanup(cycle1_B_t *it) {
+    cycle1_A_cleanup(it->a);
+    memset(it, 0, sizeof(*it));
+}
+void cycle1_B_cleanup_voidstar(void *it) { cycle1_B_cleanup((cycle1_B_t *) it); }
+int cycle1_B_parse(cycle1_B_t *it, lexer_t *lexer) {
+}
+int cycle1_B_parse_voidstar(void *it, lexer_t *lexer) { return cycle1_B_parse((cycle1_B_t *) it, lexer); }
+int cycle1_B_write(cycle1_B_t *it, writer_t *writer) {
+}
+int cycle1_B_write_voidstar(void *it, writer_t *writer) { return cycle1_B_write((cycle1_B_t *) it, writer); }
+void cycle2_C_cleanup(cycle2_C_t *it) {
+    memset(it, 0, sizeof(*it));
+}
+void cycle2_C_cleanup_voidstar(void *it) { cycle2_C_cleanup((cycle2_C_t *) it); }
+int cycle2_C_parse(cycle2_C_t *it, lexer_t *lexer) {
+}
+int cycle2_C_parse_voidstar(void *it, lexer_t *lexer) { return cycle2_C_parse((cycle2_C_t *) it, lexer); }
+int cycle2_C_write(cycle2_C_t *it, writer_t *writer) {
+}
+int cycle2_C_write_voidstar(void *it, writer_t *writer) { return cycle2_C_write((cycle2_C_t *) it, writer); }
+void cycle2_A_cleanup(cycle2_A_t *it) {
+    cycle2_B_cleanup(&it->b);
+    memset(it, 0, sizeof(*it));
+}
+void cycle2_A_cleanup_voidstar(void *it) { cycle2_A_cleanup((cycle2_A_t *) it); }
+int cycle2_A_parse(cycle2_A_t *it, lexer_t *lexer) {
+}
+int cycle2_A_parse_voidstar(void *it, lexer_t *lexer) { return cycle2_A_parse((cycle2_A_t *) it, lexer); }
+int cycle2_A_write(cycle2_A_t *it, writer_t *writer) {
+}
+int cycle2_A_write_voidstar(void *it, writer_t *writer) { return cycle2_A_write((cycle2_A_t *) it, writer); }
+int cycle2_B_parse(cycle2_B_t *it, lexer_t *lexer) {
+}
+int cycle2_B_parse_voidstar(void *it, lexer_t *lexer) { return cycle2_B_parse((cycle2_B_t *) it, lexer); }
+int cycle2_B_write(cycle2_B_t *it, writer_t *writer) {
+}
+int cycle2_B_write_voidstar(void *it, writer_t *writer) { return cycle2_B_write((cycle2_B_t *) it, writer); }
+int cycle3_B_parse(cycle3_B_t *it, lexer_t *lexer) {
+}
+int cycle3_B_parse_voidstar(void *it, lexer_t *lexer) { return cycle3_B_parse((cycle3_B_t *) it, lexer); }
+int cycle3_B_write(cycle3_B_t *it, writer_t *writer) {
+}
+int cycle3_B_write_voidstar(void *it, writer_t *writer) { return cycle3_B_write((cycle3_B_t *) it, writer); }
+int cycle3_A_parse(cycle3_A_t *it, lexer_t *lexer) {
+}
+int cycle3_A_parse_voidstar(void *it, lexer_t *lexer) { return cycle3_A_parse((cycle3_A_t *) it, lexer); }
+int cycle3_A_write(cycle3_A_t *it, writer_t *writer) {
+}
+int cycle3_A_write_voidstar(void *it, writer_t *writer) { return cycle3_A_write((cycle3_A_t *) it, writer); }
+int no_package_int_parse(no_package_int_t *it, lexer_t *lexer) {
+}
+int no_package_int_parse_voidstar(void *it, lexer_t *lexer) { return no_package_int_parse((no_package_int_t *) it, lexer); }
+int no_package_int_write(no_package_int_t *it, writer_t *writer) {
+}
+int no_package_int_write_voidstar(void *it, writer_t *writer) { return no_package_int_write((no_package_int_t *) it, writer); }
+int no_package_int_alias_parse(no_package_int_alias_t *it, lexer_t *lexer) {
+}
+int no_package_int_alias_parse_voidstar(void *it, lexer_t *lexer) { return no_package_int_alias_parse((no_package_int_alias_t *) it, lexer); }
+int no_package_int_alias_write(no_package_int_alias_t *it, writer_t *writer) {
+}
+int no_package_int_alias_write_voidstar(void *it, writer_t *writer) { return no_package_int_alias_write((no_package_int_alias_t *) it, writer); }
+int util_math_complex_parse(util_math_complex_t *it, lexer_t *lexer) {
+}
+int util_math_complex_parse_voidstar(void *it, lexer_t *lexer) { return util_math_complex_parse((util_math_complex_t *) it, lexer); }
+int util_math_complex_write(util_math_complex_t *it, writer_t *writer) {
+}
+int util_math_complex_write_voidstar(void *it, writer_t *writer) { return util_math_complex_write((util_math_complex_t *) it, writer); }
+int util_math_real_parse(util_math_real_t *it, lexer_t *lexer) {
+}
+int util_math_real_parse_voidstar(void *it, lexer_t *lexer) { return util_math_real_parse((util_math_real_t *) it, lexer); }
+int util_math_real_write(util_math_real_t *it, writer_t *writer) {
+}
+int util_math_real_write_voidstar(void *it, writer_t *writer) { return util_math_real_write((util_math_real_t *) it, writer); }
+int test_int_parse(test_int_t *it, lexer_t *lexer) {
+}
+int test_int_parse_voidstar(void *it, lexer_t *lexer) { return test_int_parse((test_int_t *) it, lexer); }
+int test_int_write(test_int_t *it, writer_t *writer) {
+}
+int test_int_write_voidstar(void *it, writer_t *writer) { return test_int_write((test_int_t *) it, writer); }
+int test_integer_parse(test_integer_t *it, lexer_t *lexer) {
+}
+int test_integer_parse_voidstar(void *it, lexer_t *lexer) { return test_integer_parse((test_integer_t *) it, lexer); }
+int test_integer_write(test_integer_t *it, writer_t *writer) {
+}
+int test_integer_write_voidstar(void *it, writer_t *writer) { return test_integer_write((test_integer_t *) it, writer); }
+void arrayof_int_cleanup(arrayof_int_t *it) {
+    free(it->elems);
+    memset(it, 0, sizeof(*it));
+}
+void arrayof_int_cleanup_voidstar(void *it) { arrayof_int_cleanup((arrayof_int_t *) it); }
+int arrayof_int_parse(arrayof_int_t *it, lexer_t *lexer) {
+}
+int arrayof_int_parse_voidstar(void *it, lexer_t *lexer) { return arrayof_int_parse((arrayof_int_t *) it, lexer); }
+int arrayof_int_write(arrayof_int_t *it, writer_t *writer) {
+}
+int arrayof_int_write_voidstar(void *it, writer_t *writer) { return arrayof_int_write((arrayof_int_t *) it, writer); }
+int test_intarray_parse(test_intarray_t *it, lexer_t *lexer) {
+}
+int test_intarray_parse_voidstar(void *it, lexer_t *lexer) { return test_intarray_parse((test_intarray_t *) it, lexer); }
+int test_intarray_write(test_intarray_t *it, writer_t *writer) {
+}
+int test_intarray_write_voidstar(void *it, writer_t *writer) { return test_intarray_write((test_intarray_t *) it, writer); }
+int test_intarray2_parse(test_intarray2_t *it, lexer_t *lexer) {
+}
+int test_intarray2_parse_voidstar(void *it, lexer_t *lexer) { return test_intarray2_parse((test_intarray2_t *) it, lexer); }
+int test_intarray2_write(test_intarray2_t *it, writer_t *writer) {
+}
+int test_intarray2_write_voidstar(void *it, writer_t *writer) { return test_intarray2_write((test_intarray2_t *) it, writer); }
+void test_grid_cells_elem_cleanup(test_grid_cells_elem_t *it) {
+    any_cleanup(&it->data);
+    memset(it, 0, sizeof(*it));
+}
+void test_grid_cells_elem_cleanup_voidstar(void *it) { test_grid_cells_elem_cleanup((test_grid_cells_elem_t *) it); }
+int test_grid_cells_elem_parse(test_grid_cells_elem_t *it, lexer_t *lexer) {
+}
+int test_grid_cells_elem_parse_voidstar(void *it, lexer_t *lexer) { return test_grid_cells_elem_parse((test_grid_cells_elem_t *) it, lexer); }
+int test_grid_cells_elem_write(test_grid_cells_elem_t *it, writer_t *writer) {
+}
+int test_grid_cells_elem_write_voidstar(void *it, writer_t *writer) { return test_grid_cells_elem_write((test_grid_cells_elem_t *) it, writer); }
+void arrayof_inplace_test_grid_cells_elem_cleanup(arrayof_inplace_test_grid_cells_elem_t *it) {
+    for (int i = 0; i < it->len; i++) {
+        test_grid_cells_elem_cleanup(&it->elems[i]);
+    }
+    free(it->elems);
+    memset(it, 0, sizeof(*it));
+}
+void arrayof_inplace_test_grid_cells_elem_cleanup_voidstar(void *it) { arrayof_inplace_test_grid_cells_elem_cleanup((arrayof_inplace_test_grid_cells_elem_t *) it); }
+int arrayof_inplace_test_grid_cells_elem_parse(arrayof_inplace_test_grid_cells_elem_t *it, lexer_t *lexer) {
+}
+int arrayof_inplace_test_grid_cells_elem_parse_voidstar(void *it, lexer_t *lexer) { return arrayof_inplace_test_grid_cells_elem_parse((arrayof_inplace_test_grid_cells_elem_t *) it, lexer); }
+int arrayof_inplace_test_grid_cells_elem_write(arrayof_inplace_test_grid_cells_elem_t *it, writer_t *writer) {
+}
+int arrayof_inplace_test_grid_cells_elem_write_voidstar(void *it, writer_t *writer) { return arrayof_inplace_test_grid_cells_elem_write((arrayof_inplace_test_grid_cells_elem_t *) it, writer); }
+void arrayof_arrayof_inplace_test_grid_cells_elem_cleanup(arrayof_arrayof_inplace_test_grid_cells_elem_t *it) {
+    for (int i = 0; i < it->len; i++) {
+        arrayof_inplace_test_grid_cells_elem_cleanup(&it->elems[i]);
+    }
+    free(it->elems);
+    memset(it, 0, sizeof(*it));
+}
+void arrayof_arrayof_inplace_test_grid_cells_elem_cleanup_voidstar(void *it) { arrayof_arrayof_inplace_test_grid_cells_elem_cleanup((arrayof_arrayof_inplace_test_grid_cells_elem_t *) it); }
+int arrayof_arrayof_inplace_test_grid_cells_elem_parse(arrayof_arrayof_inplace_test_grid_cells_elem_t *it, lexer_t *lexer) {
+}
+int arrayof_arrayof_inplace_test_grid_cells_elem_parse_voidstar(void *it, lexer_t *lexer) { return arrayof_arrayof_inplace_test_grid_cells_elem_parse((arrayof_arrayof_inplace_test_grid_cells_elem_t *) it, lexer); }
+int arrayof_arrayof_inplace_test_grid_cells_elem_write(arrayof_arrayof_inplace_test_grid_cells_elem_t *it, writer_t *writer) {
+}
+int arrayof_arrayof_inplace_test_grid_cells_elem_write_voidstar(void *it, writer_t *writer) { return arrayof_arrayof_inplace_test_grid_cells_elem_write((arrayof_arrayof_inplace_test_grid_cells_elem_t *) it, writer); }
+void test_grid_cleanup(test_grid_t *it) {
+    arrayof_arrayof_inplace_test_grid_cells_elem_cleanup(&it->cells);
+    memset(it, 0, sizeof(*it));
+}
+void test_grid_cleanup_voidstar(void *it) { test_grid_cleanup((test_grid_t *) it); }
+int test_grid_parse(test_grid_t *it, lexer_t *lexer) {
+}
+int test_grid_parse_voidstar(void *it, lexer_t *lexer) { return test_grid_parse((test_grid_t *) it, lexer); }
+int test_grid_write(test_grid_t *it, writer_t *writer) {
+}
+int test_grid_write_voidstar(void *it, writer_t *writer) { return test_grid_write((test_grid_t *) it, writer); }
+void test_empty_struct_cleanup(test_empty_struct_t *it) {
+    memset(it, 0, sizeof(*it));
+}
+void test_empty_struct_cleanup_voidstar(void *it) { test_empty_struct_cleanup((test_empty_struct_t *) it); }
+int test_empty_struct_parse(test_empty_struct_t *it, lexer_t *lexer) {
+}
+int test_empty_struct_parse_voidstar(void *it, lexer_t *lexer) { return test_empty_struct_parse((test_empty_struct_t *) it, lexer); }
+int test_empty_struct_write(test_empty_struct_t *it, writer_t *writer) {
+}
+int test_empty_struct_write_voidstar(void *it, writer_t *writer) { return test_empty_struct_write((test_empty_struct_t *) it, writer); }
+void test_empty_union_cleanup(test_empty_union_t *it) {
+    switch (it->tag) {
+        default: break;
+    }
+    memset(it, 0, sizeof(*it));
+}
+void test_empty_union_cleanup_voidstar(void *it) { test_empty_union_cleanup((test_empty_union_t *) it); }
+int test_empty_union_parse(test_empty_union_t *it, lexer_t *lexer) {
+}
+int test_empty_union_parse_voidstar(void *it, lexer_t *lexer) { return test_empty_union_parse((test_empty_union_t *) it, lexer); }
+int test_empty_union_write(test_empty_union_t *it, writer_t *writer) {
+}
+int test_empty_union_write_voidstar(void *it, writer_t *writer) { return test_empty_union_write((test_empty_union_t *) it, writer); }
+void arrayof_test_country_areas_elem_cleanup(arrayof_test_country_areas_elem_t *it) {
+    for (int i = 0; i < it->len; i++) {
+        test_country_areas_elem_cleanup(it->elems[i]);
+    }
+    free(it->elems);
+    memset(it, 0, sizeof(*it));
+}
+void arrayof_test_country_areas_elem_cleanup_voidstar(void *it) { arrayof_test_country_areas_elem_cleanup((arrayof_test_country_areas_elem_t *) it); }
+int arrayof_test_country_areas_elem_parse(arrayof_test_country_areas_elem_t *it, lexer_t *lexer) {
+}
+int arrayof_test_country_areas_elem_parse_voidstar(void *it, lexer_t *lexer) { return arrayof_test_country_areas_elem_parse((arrayof_test_country_areas_elem_t *) it, lexer); }
+int arrayof_test_country_areas_elem_write(arrayof_test_country_areas_elem_t *it, writer_t *writer) {
+}
+int arrayof_test_country_areas_elem_write_voidstar(void *it, writer_t *writer) { return arrayof_test_country_areas_elem_write((arrayof_test_country_areas_elem_t *) it, writer); }
+void test_country_cleanup(test_country_t *it) {
+    test_grid_cleanup(&it->grid);
+    arrayof_test_country_areas_elem_cleanup(&it->areas);
+    memset(it, 0, sizeof(*it));
+}
+void test_country_cleanup_voidstar(void *it) { test_country_cleanup((test_country_t *) it); }
+int test_country_parse(test_country_t *it, lexer_t *lexer) {
+}
+int test_country_parse_voidstar(void *it, lexer_t *lexer) { return test_country_parse((test_country_t *) it, lexer); }
+int test_country_write(test_country_t *it, writer_t *writer) {
+}
+int test_country_write_voidstar(void *it, writer_t *writer) { return test_country_write((test_country_t *) it, writer); }
+void test_country_areas_elem_cleanup(test_country_areas_elem_t *it) {
+    test_country_areas_elem_details_cleanup(it->details);
+    memset(it, 0, sizeof(*it));
+}
+void test_country_areas_elem_cleanup_voidstar(void *it) { test_country_areas_elem_cleanup((test_country_areas_elem_t *) it); }
+int test_country_areas_elem_parse(test_country_areas_elem_t *it, lexer_t *lexer) {
+}
+int test_country_areas_elem_parse_voidstar(void *it, lexer_t *lexer) { return test_country_areas_elem_parse((test_country_areas_elem_t *) it, lexer); }
+int test_country_areas_elem_write(test_country_areas_elem_t *it, writer_t *writer) {
+}
+int test_country_areas_elem_write_voidstar(void *it, writer_t *writer) { return test_country_areas_elem_write((test_country_areas_elem_t *) it, writer); }
+void test_country_areas_elem_details_cleanup(test_country_areas_elem_details_t *it) {
+    switch (it->tag) {
+        case TEST_COUNTRY_AREAS_ELEM_DETAILS_TAG_TERRITORY:
+            test_country_areas_elem_details_territory_cleanup(it->u.territory);
+            break;
+        case TEST_COUNTRY_AREAS_ELEM_DETAILS_TAG_PROVINCE:
+            test_country_areas_elem_details_province_cleanup(it->u.province);
+            break;
+        default: break;
+    }
+    memset(it, 0, sizeof(*it));
+}
+void test_country_areas_elem_details_cleanup_voidstar(void *it) { test_country_areas_elem_details_cleanup((test_country_areas_elem_details_t *) it); }
+int test_country_areas_elem_details_parse(test_country_areas_elem_details_t *it, lexer_t *lexer) {
+}
+int test_country_areas_elem_details_parse_voidstar(void *it, lexer_t *lexer) { return test_country_areas_elem_details_parse((test_country_areas_elem_details_t *) it, lexer); }
+int test_country_areas_elem_details_write(test_country_areas_elem_details_t *it, writer_t *writer) {
+}
+int test_country_areas_elem_details_write_voidstar(void *it, writer_t *writer) { return test_country_areas_elem_details_write((test_country_areas_elem_details_t *) it, writer); }
+void test_country_areas_elem_details_territory_cleanup(test_country_areas_elem_details_territory_t *it) {
+    arrayof_int_cleanup(&it->years);
+    memset(it, 0, sizeof(*it));
+}
+void test_country_areas_elem_details_territory_cleanup_voidstar(void *it) { test_country_areas_elem_details_territory_cleanup((test_country_areas_elem_details_territory_t *) it); }
+int test_country_areas_elem_details_territory_parse(test_country_areas_elem_details_territory_t *it, lexer_t *lexer) {
+}
+int test_country_areas_elem_details_territory_parse_voidstar(void *it, lexer_t *lexer) { return test_country_areas_elem_details_territory_parse((test_country_areas_elem_details_territory_t *) it, lexer); }
+int test_country_areas_elem_details_territory_write(test_country_areas_elem_details_territory_t *it, writer_t *writer) {
+}
+int test_country_areas_elem_details_territory_write_voidstar(void *it, writer_t *writer) { return test_country_areas_elem_details_territory_write((test_country_areas_elem_details_territory_t *) it, writer); }
+void arrayof_string_cleanup(arrayof_string_t *it) {
+    free(it->elems);
+    memset(it, 0, sizeof(*it));
+}
+void arrayof_string_cleanup_voidstar(void *it) { arrayof_string_cleanup((arrayof_string_t *) it); }
+int arrayof_string_parse(arrayof_string_t *it, lexer_t *lexer) {
+}
+int arrayof_string_parse_voidstar(void *it, lexer_t *lexer) { return arrayof_string_parse((arrayof_string_t *) it, lexer); }
+int arrayof_string_write(arrayof_string_t *it, writer_t *writer) {
+}
+int arrayof_string_write_voidstar(void *it, writer_t *writer) { return arrayof_string_write((arrayof_string_t *) it, writer); }
+void test_country_areas_elem_details_province_cleanup(test_country_areas_elem_details_province_t *it) {
+    arrayof_string_cleanup(&it->names);
+    memset(it, 0, sizeof(*it));
+}
+void test_country_areas_elem_details_province_cleanup_voidstar(void *it) { test_country_areas_elem_details_province_cleanup((test_country_areas_elem_details_province_t *) it); }
+int test_country_areas_elem_details_province_parse(test_country_areas_elem_details_province_t *it, lexer_t *lexer) {
+}
+int test_country_areas_elem_details_province_parse_voidstar(void *it, lexer_t *lexer) { return test_country_areas_elem_details_province_parse((test_country_areas_elem_details_province_t *) it, lexer); }
+int test_country_areas_elem_details_province_write(test_country_areas_elem_details_province_t *it, writer_t *writer) {
+}
+int test_country_areas_elem_details_province_write_voidstar(void *it, writer_t *writer) { return test_country_areas_elem_details_province_write((test_country_areas_elem_details_province_t *) it, writer); }
+
+/* Dummy main */
+int main(int n_args, char **args) { return 0; }
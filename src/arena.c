@@ -0,0 +1,58 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+
+
+void arena_cleanup(arena_t *arena) {
+    arena_block_t *block = arena->blocks;
+    while (block) {
+        arena_block_t *next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->blocks = NULL;
+}
+
+void arena_init(arena_t *arena) {
+    memset(arena, 0, sizeof(*arena));
+}
+
+void *arena_alloc(arena_t *arena, size_t size) {
+    /* Returns size bytes of (uninitialized) memory, or NULL on failure */
+    size = (size + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN;
+
+    arena_block_t *block = arena->blocks;
+    if (block && block->size - block->len >= size) {
+        void *data = block->data + block->len;
+        block->len += size;
+        return data;
+    }
+
+    size_t block_size = size > ARENA_BLOCK_SIZE? size: ARENA_BLOCK_SIZE;
+    arena_block_t *new_block = malloc(sizeof(*new_block) + block_size);
+    if (new_block == NULL) return NULL;
+    new_block->size = block_size;
+    new_block->len = size;
+
+    if (block && block_size == size) {
+        /* An oversized allocation gets a block to itself; keep filling the
+        current block, so its remaining space isn't wasted */
+        new_block->next = block->next;
+        block->next = new_block;
+    } else {
+        new_block->next = block;
+        arena->blocks = new_block;
+    }
+    return new_block->data;
+}
+
+char *arena_strndup(arena_t *arena, const char *s, size_t len) {
+    /* Copies len bytes of s (which need not be NUL-terminated) into the
+    arena, followed by a NUL */
+    char *s2 = arena_alloc(arena, len + 1);
+    if (s2 == NULL) return NULL;
+    memcpy(s2, s, len);
+    s2[len] = '\0';
+    return s2;
+}
@@ -0,0 +1,39 @@
+#ifndef _ARENA_H_
+#define _ARENA_H_
+
+#include <stddef.h>
+
+
+/* Default size of an arena's blocks (allocations larger than this get a
+block of their own) */
+#define ARENA_BLOCK_SIZE ((size_t)(1024 * 64))
+
+/* Alignment of every allocation made from an arena */
+#define ARENA_ALIGN ((size_t)8)
+
+
+typedef struct arena_block arena_block_t;
+
+struct arena_block {
+    arena_block_t *next;
+    size_t size; /* Size of data */
+    size_t len; /* Number of bytes of data used so far */
+    char data[];
+};
+
+/* An append-only allocator: memory is handed out from large blocks, and
+is only ever freed all at once, by arena_cleanup.
+Useful for lots of small allocations which all live as long as each other,
+e.g. the strs of a tokentree (see lexer->str_arena). */
+typedef struct arena {
+    /* The first block is the one currently being filled */
+    arena_block_t *blocks;
+} arena_t;
+
+
+void arena_cleanup(arena_t *arena);
+void arena_init(arena_t *arena);
+void *arena_alloc(arena_t *arena, size_t size);
+char *arena_strndup(arena_t *arena, const char *s, size_t len);
+
+#endif
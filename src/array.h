@@ -76,6 +76,14 @@ Multiplies its size by 2 (or starts it at 8 if size was 0). */
     (A1).size = new_size; \
 }
 
+/* Grows array A1 until its len is at least LEN.
+New elements are zeroed. */
+#define ARRAY_ENSURE_LEN(TYPE, A1, LEN) \
+{ \
+    while ((A1).size < (LEN)) ARRAY_GROW(TYPE, A1) \
+    if ((A1).len < (LEN)) (A1).len = (LEN); \
+}
+
 #define ARRAY_PUSH(TYPE, A1, ELEM_VAR) \
 TYPE *ELEM_VAR; \
 { \
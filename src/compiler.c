@@ -7,6 +7,7 @@
 #include "compiler.h"
 #include "lexer.h"
 #include "stringstore.h"
+#include "tokentree.h"
 
 
 void compiler_init(compiler_t *compiler, lexer_t *lexer,
@@ -26,6 +27,8 @@ void compiler_init(compiler_t *compiler, lexer_t *lexer,
 void compiler_cleanup(compiler_t *compiler) {
     ARRAY_FREE_PTR(compiler->defs, type_def_cleanup)
     ARRAY_FREE_PTR(compiler->bindings, compiler_binding_cleanup)
+    free(compiler->bindings_by_name_id.elems);
+    free(compiler->defs_by_name_id.elems);
 }
 
 void compiler_dump(compiler_t *compiler, FILE *file) {
@@ -81,6 +84,23 @@ void compiler_dump(compiler_t *compiler, FILE *file) {
     }
 }
 
+void compiler_mark_strings(compiler_t *compiler) {
+    /* Marks all strings used by the compiler's defs and bindings, so that
+    they survive stringstore_sweep.
+    NOTE: the default type names (any_type_name etc) are string literals,
+    not strings from the store, so they aren't marked. */
+    stringstore_t *store = compiler->store;
+    if (compiler->package_name) {
+        stringstore_mark(store, compiler->package_name);
+    }
+    ARRAY_FOR_PTR(compiler_binding_t, compiler->bindings, binding) {
+        stringstore_mark(store, binding->name);
+    }
+    ARRAY_FOR_PTR(type_def_t, compiler->defs, def) {
+        type_def_mark_strings(def, store);
+    }
+}
+
 void compiler_debug_info(compiler_t *compiler) {
     lexer_info(compiler->lexer, stderr);
 }
@@ -91,37 +111,55 @@ void compiler_binding_cleanup(compiler_binding_t *binding) {
 
 
 
-int compiler_compile(compiler_t *compiler, const char *buffer,
-    const char *filename
+int compiler_compile(compiler_t *compiler, const char *text,
+    size_t text_len, const char *filename
 ) {
+    /* NOTE: text needn't be NUL-terminated (see lexer_load_n).
+    It may also be a binary tokentree file (see tokentree_flat_save), which
+    is parsed in place, without lexing. */
     int err;
     lexer_t *lexer = compiler->lexer;
 
-    err = lexer_load(lexer, buffer, filename);
-    if (err) return err;
+    /* NOTE: lexer may point to flat (and into text), so we must unload it
+    before returning, whether or not we succeed */
+    tokentree_flat_t flat;
+    if (tokentree_flat_is_file(text, text_len)) {
+        err = tokentree_flat_load(&flat, text, text_len, filename);
+        if (err) return err;
+        err = lexer_load_tokentree_flat(lexer, &flat, filename);
+    } else {
+        err = compiler->tokenize?
+            lexer_load_tokens_n(lexer, text, text_len, filename):
+            lexer_load_n(lexer, text, text_len, filename);
+    }
+    if (err) goto done;
 
     err = compiler_parse_defs(compiler);
     if (err) {
         lexer_info(lexer, stderr);
         fprintf(stderr, "Failed to parse\n");
         compiler_dump(compiler, stderr);
-        return err;
+        goto done;
     }
 
-    if (!compiler_validate(compiler)) return 2;
+    if (!compiler_validate(compiler)) {
+        err = 2;
+        goto done;
+    }
 
     if (compiler->defs.len) {
         /* Sort compiler->defs such that arrays/structs/unions come after any
         defs they have an inplace reference to. */
         err = compiler_sort_inplace_refs(compiler);
-        if (err) return err;
+        if (err) goto done;
 
         /* Sort compiler->defs such that the compiled C typedefs come after
         any other C typedefs they refer to */
         err = compiler_sort_typedefs(compiler);
-        if (err) return err;
+        if (err) goto done;
     }
 
+done:
     lexer_unload(lexer);
-    return 0;
+    return err;
 }
@@ -3,6 +3,7 @@
 
 
 #include <stddef.h>
+#include <stdint.h>
 #include <stdbool.h>
 
 #include "type.h"
@@ -19,10 +20,19 @@ DECLARE_TYPE(compiler_binding)
 struct compiler {
     bool debug;
 
+    /* tokenize: whether to lex each buffer up front, see lexer_load_tokens */
+    bool tokenize;
+
     const char *package_name;
     ARRAYOF(compiler_binding_t *) bindings;
     ARRAYOF(type_def_t *) defs;
 
+    /* Symbol tables: weakrefs to the elements of bindings and defs,
+    indexed by the stringstore_id of their names (and NULL for ids which
+    aren't the name of a binding or def) */
+    ARRAYOF(compiler_binding_t *) bindings_by_name_id;
+    ARRAYOF(type_def_t *) defs_by_name_id;
+
     const char *any_type_name; /* e.g. "any" */
     const char *any_type_name_upper; /* e.g. "ANY" */
     const char *type_type_name; /* e.g. "type" */
@@ -45,6 +55,7 @@ struct compiler {
 "from PACKAGE: NAME" */
 struct compiler_binding {
     const char *name;
+    uint32_t name_id; /* stringstore_id of name */
 
     /* Weakrefs: */
     type_def_t *def;
@@ -55,8 +66,9 @@ void compiler_init(compiler_t *compiler, lexer_t *lexer,
     stringstore_t *store);
 void compiler_dump(compiler_t *compiler, FILE *file);
 void compiler_debug_info(compiler_t *compiler);
-int compiler_compile(compiler_t *compiler, const char *buffer,
-    const char *filename);
+void compiler_mark_strings(compiler_t *compiler);
+int compiler_compile(compiler_t *compiler, const char *text,
+    size_t text_len, const char *filename);
 int compiler_parse_defs(compiler_t *compiler);
 bool compiler_validate(compiler_t *compiler);
 int compiler_sort_inplace_refs(compiler_t *compiler);
@@ -69,35 +69,13 @@ static const char *_build_array_type_name(stringstore_t *store,
 static const char *_build_union_tags_name(stringstore_t *store,
     const char *struct_name
 ) {
-    char *_tags_name = _strjoin2(struct_name, "_tags");
-    if (!_tags_name) return NULL;
-
-    _strtoupper(_tags_name);
-
-    const char *tags_name = stringstore_get_donate(store, _tags_name);
-    if (!tags_name) {
-        free(_tags_name);
-        return NULL;
-    }
-
-    return tags_name;
+    return _const_strjoin2_upper(store, struct_name, "_tags");
 }
 
 static const char *_build_field_tag_name(stringstore_t *store,
     const char *union_name, const char *field_name
 ) {
-    char *_tag_name = _strjoin3(union_name, "_tag_", field_name);
-    if (!_tag_name) return NULL;
-
-    _strtoupper(_tag_name);
-
-    const char *tag_name = stringstore_get_donate(store, _tag_name);
-    if (!tag_name) {
-        free(_tag_name);
-        return NULL;
-    }
-
-    return tag_name;
+    return _const_strjoin3_upper(store, union_name, "_tag_", field_name);
 }
 
 
@@ -108,45 +86,43 @@ static const char *compiler_get_packaged_name(compiler_t *compiler, const char *
         compiler->package_name, "_", name);
 }
 
+/* NOTE: all names passed to the following functions must be owned by
+compiler->store (e.g. returned by GET_CONST_NAME or _const_strjoin*),
+since they are looked up by stringstore_id */
+
 static compiler_binding_t *compiler_get_binding(compiler_t *compiler,
     const char *name
 ) {
-    for (int i = 0; i < compiler->bindings.len; i++) {
-        compiler_binding_t *binding = compiler->bindings.elems[i];
-        if (_streq(binding->name, name)) return binding;
-    }
-    return NULL;
+    uint32_t name_id = stringstore_id(compiler->store, name);
+    if (name_id >= compiler->bindings_by_name_id.len) return NULL;
+    return compiler->bindings_by_name_id.elems[name_id];
 }
 
 static type_def_t *compiler_get_def(compiler_t *compiler,
     const char *type_name
 ) {
-    for (int i = 0; i < compiler->defs.len; i++) {
-        type_def_t *def = compiler->defs.elems[i];
-        if (_streq(def->name, type_name)) return def;
-    }
-    return NULL;
+    uint32_t name_id = stringstore_id(compiler->store, type_name);
+    if (name_id >= compiler->defs_by_name_id.len) return NULL;
+    return compiler->defs_by_name_id.elems[name_id];
 }
 
 static int compiler_add_def(compiler_t *compiler,
     const char *type_name, type_def_t **def_ptr
 ) {
+    const char *type_name_upper = _const_strupper(compiler->store,
+        type_name);
+    if (!type_name_upper) return 1;
 
-    char *_type_name_upper = _strdup(type_name);
-    if (!_type_name_upper) return 1;
-    _strtoupper(_type_name_upper);
-    const char *type_name_upper = stringstore_get_donate(compiler->store,
-        _type_name_upper);
-    if (!type_name_upper) {
-        free(_type_name_upper);
-        return 1;
-    }
+    uint32_t name_id = stringstore_id(compiler->store, type_name);
+    ARRAY_ENSURE_LEN(type_def_t*, compiler->defs_by_name_id, name_id + 1)
 
     /* NOTE: caller guarantees no def exists with name type_name */
     ARRAY_PUSH_NEW(type_def_t*, compiler->defs, def)
     def->name = type_name;
+    def->name_id = name_id;
     def->name_upper = type_name_upper;
     def->type.tag = TYPE_TAG_UNDEFINED;
+    compiler->defs_by_name_id.elems[name_id] = def;
     *def_ptr = def;
     return 0;
 }
@@ -257,10 +233,10 @@ static int compiler_parse_type_ref(compiler_t *compiler,
     memset(ref, 0, sizeof(*ref));
     ref->type.tag = TYPE_TAG_UNDEFINED;
 
-    if (GOT("inplace")) {
+    if (GOT_KEYWORD(INPLACE)) {
         NEXT
         ref->is_inplace = true;
-    } else if (GOT("weakref")) {
+    } else if (GOT_KEYWORD(WEAKREF)) {
         NEXT
         ref->is_weakref = true;
     }
@@ -286,8 +262,9 @@ static int compiler_parse_type_field(compiler_t *compiler,
         fprintf(stderr, "%s: %s / %s\n", __func__, field_name, frame->type_name);
     }
 
+    uint32_t field_name_id = stringstore_id(compiler->store, field_name);
     ARRAY_FOR(type_field_t, *fields, field) {
-        if (_streq(field->name, field_name)) {
+        if (field->name_id == field_name_id) {
             fprintf(stderr, "Can't redefine field: %s\n", field_name);
             return 2;
         }
@@ -299,6 +276,7 @@ static int compiler_parse_type_field(compiler_t *compiler,
 
     ARRAY_PUSH(type_field_t, *fields, field)
     field->name = field_name;
+    field->name_id = field_name_id;
 
     if (is_union) {
         const char *tag_name = _build_field_tag_name(compiler->store,
@@ -334,8 +312,9 @@ static int compiler_parse_type_arg(compiler_t *compiler,
         fprintf(stderr, "%s: %s / %s\n", __func__, arg_name, frame->type_name);
     }
 
+    uint32_t arg_name_id = stringstore_id(compiler->store, arg_name);
     ARRAY_FOR(type_arg_t, *args, arg) {
-        if (_streq(arg->name, arg_name)) {
+        if (arg->name_id == arg_name_id) {
             fprintf(stderr, "Can't redefine arg: %s\n", arg_name);
             return 2;
         }
@@ -347,9 +326,10 @@ static int compiler_parse_type_arg(compiler_t *compiler,
 
     ARRAY_PUSH(type_arg_t, *args, arg)
     arg->name = arg_name;
+    arg->name_id = arg_name_id;
 
     GET_OPEN
-    if (GOT("out")) {
+    if (GOT_KEYWORD(OUT)) {
         NEXT
         arg->out = 1;
     }
@@ -387,7 +367,7 @@ static int compiler_parse_func(compiler_t *compiler,
 
     GET_OPEN
     while (!DONE && !GOT_CLOSE) {
-        if (GOT("ret")) {
+        if (GOT_KEYWORD(RET)) {
             NEXT
 
             const char *ret_type_name = _const_strjoin2(compiler->store,
@@ -402,7 +382,7 @@ static int compiler_parse_func(compiler_t *compiler,
             err = compiler_parse_type(compiler, &subframe, ret);
             if (err) return err;
             GET_CLOSE
-        } else if (GOT("args")) {
+        } else if (GOT_KEYWORD(ARGS)) {
             NEXT
 
             compiler_frame_t subframe = {0};
@@ -449,9 +429,9 @@ static int compiler_parse_struct_or_union(compiler_t *compiler,
     subframe.type_name = def->name;
     GET_OPEN
     while (!DONE && !GOT_CLOSE) {
-        if (GOT("!")) {
+        if (GOT_KEYWORD(BANG)) {
             NEXT
-            if (GOT("extra_cleanup")) {
+            if (GOT_KEYWORD(EXTRA_CLEANUP)) {
                 NEXT
                 def->type.u.struct_f.extra_cleanup = true;
             } else {
@@ -534,7 +514,8 @@ static int compiler_parse_type(compiler_t *compiler,
     /* Character used to indicate type */
     char c;
 
-    if (GOT("@")) {
+    switch (lexer->keyword_id) {
+    case KEYWORD(AT): {
         NEXT
 
         const char *name;
@@ -561,7 +542,9 @@ static int compiler_parse_type(compiler_t *compiler,
         /* Type is an alias to def */
         type->tag = TYPE_TAG_ALIAS;
         type->u.alias_f.def = def;
-    } else if (GOT("@@")) {
+        break;
+    }
+    case KEYWORD(AT_AT): {
         NEXT
 
         const char *packaged_name;
@@ -575,31 +558,49 @@ static int compiler_parse_type(compiler_t *compiler,
         /* Type is an alias to def */
         type->tag = TYPE_TAG_ALIAS;
         type->u.alias_f.def = def;
-    } else if (GOT("void")) {
+        break;
+    }
+    case KEYWORD(VOID): {
         NEXT
         type->tag = TYPE_TAG_VOID;
-    } else if (GOT("any")) {
+        break;
+    }
+    case KEYWORD(ANY): {
         NEXT
         type->tag = TYPE_TAG_ANY;
-    } else if (GOT("type")) {
+        break;
+    }
+    case KEYWORD(TYPE): {
         NEXT
         type->tag = TYPE_TAG_TYPE;
-    } else if (GOT("int")) {
+        break;
+    }
+    case KEYWORD(INT): {
         NEXT
         type->tag = TYPE_TAG_INT;
-    } else if (GOT("err")) {
+        break;
+    }
+    case KEYWORD(ERR): {
         NEXT
         type->tag = TYPE_TAG_ERR;
-    } else if (GOT("string")) {
+        break;
+    }
+    case KEYWORD(STRING): {
         NEXT
         type->tag = TYPE_TAG_STRING;
-    } else if (GOT("bool")) {
+        break;
+    }
+    case KEYWORD(BOOL): {
         NEXT
         type->tag = TYPE_TAG_BOOL;
-    } else if (GOT("byte")) {
+        break;
+    }
+    case KEYWORD(BYTE): {
         NEXT
         type->tag = TYPE_TAG_BYTE;
-    } else if (GOT("array")) {
+        break;
+    }
+    case KEYWORD(ARRAY): {
         NEXT
 
         const char *elem_type_name = frame->type_name;
@@ -629,12 +630,17 @@ static int compiler_parse_type(compiler_t *compiler,
         /* Caller gets an *alias* to our array type */
         type->tag = TYPE_TAG_ALIAS;
         type->u.alias_f.def = def;
-    } else if (
-        (GOT("struct") && (c = 's')) ||
-        (GOT("union") && (c = 'u')) ||
-        (GOT("func") && (c = 'f')) ||
-        (GOT("method") && (c = 'm'))
-    ) {
+        break;
+    }
+    case KEYWORD(STRUCT):
+    case KEYWORD(UNION):
+    case KEYWORD(FUNC):
+    case KEYWORD(METHOD): {
+        c =
+            GOT_KEYWORD(STRUCT)? 's':
+            GOT_KEYWORD(UNION)? 'u':
+            GOT_KEYWORD(FUNC)? 'f': 'm';
+
         type_def_t *def;
         err = compiler_parse_struct_or_union_or_func_def(compiler, frame,
             &def, c);
@@ -647,7 +653,9 @@ static int compiler_parse_type(compiler_t *compiler,
             type->tag = TYPE_TAG_ALIAS;
             type->u.alias_f.def = def;
         }
-    } else if (GOT("extern")) {
+        break;
+    }
+    case KEYWORD(EXTERN): {
         NEXT
 
         GET_OPEN
@@ -657,7 +665,9 @@ static int compiler_parse_type(compiler_t *compiler,
 
         type->tag = TYPE_TAG_EXTERN;
         type->u.extern_f.extern_name = extern_name;
-    } else {
+        break;
+    }
+    default:
         return UNEXPECTED(
             "one of: void any int string bool byte array struct union");
     }
@@ -673,7 +683,7 @@ int compiler_parse_defs(compiler_t *compiler) {
     char c;
 
     while (!DONE && !GOT_CLOSE) {
-        if (GOT("typedef")) {
+        if (GOT_KEYWORD(TYPEDEF)) {
             NEXT
 
             const char *name;
@@ -695,16 +705,16 @@ int compiler_parse_defs(compiler_t *compiler) {
             if (err) return err;
             GET_CLOSE
         } else if (
-            (GOT("struct") && (c = 's')) ||
-            (GOT("union") && (c = 'u')) ||
-            (GOT("func") && (c = 'f')) ||
-            (GOT("method") && (c = 'm'))
+            (GOT_KEYWORD(STRUCT) && (c = 's')) ||
+            (GOT_KEYWORD(UNION) && (c = 'u')) ||
+            (GOT_KEYWORD(FUNC) && (c = 'f')) ||
+            (GOT_KEYWORD(METHOD) && (c = 'm'))
         ) {
             type_def_t *def;
             err = compiler_parse_struct_or_union_or_func_def(compiler, NULL,
                 &def, c);
             if (err) return err;
-        } else if (GOT("package")) {
+        } else if (GOT_KEYWORD(PACKAGE)) {
             NEXT
 
             const char *package_name;
@@ -718,7 +728,7 @@ int compiler_parse_defs(compiler_t *compiler) {
             }
 
             compiler->package_name = package_name;
-        } else if (GOT("from")) {
+        } else if (GOT_KEYWORD(FROM)) {
             NEXT
 
             const char *from_package_name;
@@ -747,12 +757,18 @@ int compiler_parse_defs(compiler_t *compiler) {
                     }
                     compiler_binding_cleanup(binding);
                 } else {
+                    uint32_t name_id = stringstore_id(compiler->store, name);
+                    ARRAY_ENSURE_LEN(compiler_binding_t*,
+                        compiler->bindings_by_name_id, name_id + 1)
                     ARRAY_PUSH_NEW(compiler_binding_t*, compiler->bindings,
                         new_binding)
+                    compiler->bindings_by_name_id.elems[name_id] =
+                        new_binding;
                     binding = new_binding;
                 }
 
                 binding->name = name;
+                binding->name_id = stringstore_id(compiler->store, name);
                 binding->def = def;
             }
             GET_CLOSE
@@ -1,8 +1,15 @@
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include "file_utils.h"
 
@@ -22,7 +29,7 @@ int getln(char buf[], int buf_len, FILE *file){
 
 char *load_file(const char *filename){
     FILE *f = fopen(filename, "r");
-    long f_size;
+    size_t f_size;
     char *f_buffer;
     size_t n_read_bytes;
     if(f == NULL){
@@ -31,15 +38,27 @@ char *load_file(const char *filename){
         return NULL;
     }
 
-    fseek(f, 0, SEEK_END);
-    f_size = ftell(f);
-    fseek(f, 0, SEEK_SET);
+    /* NOTE: ftell's long is only 32 bits on some platforms, so we use
+    fstat's off_t, and check that the file fits in memory */
+    struct stat st;
+    if(fstat(fileno(f), &st)){
+        perror("fstat");
+        fclose(f);
+        return NULL;
+    }
+    if((uintmax_t)st.st_size >= SIZE_MAX){
+        fprintf(stderr, "File is too large: %s (%jd bytes)\n",
+            filename, (intmax_t)st.st_size);
+        fclose(f);
+        return NULL;
+    }
+    f_size = st.st_size;
 
     f_buffer = calloc(f_size + 1, 1);
     if(f_buffer == NULL){
         perror("calloc");
         fprintf(stderr,
-            "Could not allocate buffer for file: %s (%li bytes)\n",
+            "Could not allocate buffer for file: %s (%zu bytes)\n",
             filename, f_size);
         fclose(f);
         return NULL;
@@ -48,7 +67,7 @@ char *load_file(const char *filename){
     if(n_read_bytes < f_size){
         perror("fread");
         fprintf(stderr,
-            "Could not read (all of) file: %s (%li bytes)\n",
+            "Could not read (all of) file: %s (%zu bytes)\n",
             filename, f_size);
         free(f_buffer);
         fclose(f);
@@ -58,40 +77,130 @@ char *load_file(const char *filename){
     return f_buffer;
 }
 
-char *read_stream(FILE *file, const char *filename){
+static char *_read_stream(FILE *file, const char *filename,
+    size_t *len_ptr
+){
+    /* The buffer grows geometrically, so reading n bytes costs O(n) copying
+    in total, however large the stream is */
     char *buffer = NULL;
     size_t bufsize = 0;
+    size_t len = 0;
 
     while(1){
-        bufsize += CHUNK_SIZE;
-        char *new_buffer = realloc(buffer, bufsize);
-        if(!new_buffer){
-            perror("realloc");
-            fprintf(stderr,
-                "Could not allocate %zu-byte buffer for stream: %s\n",
-                bufsize, filename);
-            free(buffer);
-            return NULL;
+        if(bufsize - len < CHUNK_SIZE){
+            size_t new_bufsize = bufsize? bufsize * 2: CHUNK_SIZE;
+            char *new_buffer = realloc(buffer, new_bufsize);
+            if(!new_buffer){
+                perror("realloc");
+                fprintf(stderr,
+                    "Could not allocate %zu-byte buffer for stream: %s\n",
+                    new_bufsize, filename);
+                free(buffer);
+                return NULL;
+            }
+            buffer = new_buffer;
+            bufsize = new_bufsize;
         }
-        buffer = new_buffer;
-
-        char *chunk = buffer + (bufsize - CHUNK_SIZE);
 
-        size_t n_read_bytes = fread(chunk, 1, CHUNK_SIZE, file);
-        if(n_read_bytes < CHUNK_SIZE){
+        /* Leave room for the NUL terminator */
+        size_t n_wanted_bytes = bufsize - len - 1;
+        size_t n_read_bytes = fread(buffer + len, 1, n_wanted_bytes, file);
+        len += n_read_bytes;
+        if(n_read_bytes < n_wanted_bytes){
             if(ferror(file)){
                 free(buffer);
                 perror("fread");
                 fprintf(stderr,
-                    "Failed read (%zu/%zu bytes) from stream: %s\n",
-                    n_read_bytes, CHUNK_SIZE, filename);
+                    "Failed read (%zu bytes) from stream: %s\n",
+                    len, filename);
                 return NULL;
             }
-            buffer[n_read_bytes] = '\0';
+            buffer[len] = '\0';
             break;
         }
-
     }
 
+    if(len_ptr)*len_ptr = len;
     return buffer;
 }
+
+char *read_stream(FILE *file, const char *filename){
+    return _read_stream(file, filename, NULL);
+}
+
+
+void file_text_cleanup(file_text_t *file_text){
+    if(file_text->map_size){
+        munmap((void *)file_text->text, file_text->map_size);
+    }else if(file_text->text){
+        free((void *)file_text->text);
+    }
+    memset(file_text, 0, sizeof(*file_text));
+}
+
+int read_stream_text(file_text_t *file_text, FILE *file,
+    const char *filename
+){
+    memset(file_text, 0, sizeof(*file_text));
+    char *text = _read_stream(file, filename, &file_text->len);
+    if(!text)return 1;
+    file_text->text = text;
+    return 0;
+}
+
+int map_file(file_text_t *file_text, const char *filename){
+    /* Maps a file into memory, so that it may be lexed straight from the
+    page cache, without being copied.
+    NOTE: the mapped text is *not* NUL-terminated; use file_text->len
+    (e.g. with lexer_load_n).
+    Files which can't be mapped (e.g. pipes) are read instead. */
+    memset(file_text, 0, sizeof(*file_text));
+
+    int fd = open(filename, O_RDONLY);
+    if(fd < 0){
+        perror("open");
+        fprintf(stderr, "Could not open file: %s\n", filename);
+        return 1;
+    }
+
+    struct stat st;
+    if(fstat(fd, &st)){
+        perror("fstat");
+        close(fd);
+        return 1;
+    }
+
+    if(!S_ISREG(st.st_mode) || st.st_size == 0){
+        /* NOTE: mmap refuses zero-length mappings, so empty files are
+        "read" too */
+        FILE *file = fdopen(fd, "r");
+        if(!file){
+            perror("fdopen");
+            close(fd);
+            return 1;
+        }
+        int err = read_stream_text(file_text, file, filename);
+        fclose(file);
+        return err;
+    }
+
+    if((uintmax_t)st.st_size > SIZE_MAX){
+        fprintf(stderr, "File is too large: %s (%jd bytes)\n",
+            filename, (intmax_t)st.st_size);
+        close(fd);
+        return 1;
+    }
+    size_t map_size = st.st_size;
+    void *map = mmap(NULL, map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(map == MAP_FAILED){
+        perror("mmap");
+        fprintf(stderr, "Could not map file: %s\n", filename);
+        return 1;
+    }
+
+    file_text->text = map;
+    file_text->len = map_size;
+    file_text->map_size = map_size;
+    return 0;
+}
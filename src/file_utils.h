@@ -2,9 +2,24 @@
 #define _FILE_UTILS_H_
 
 #include <stdio.h>
+#include <stddef.h>
+
+/* Text loaded by map_file or read_stream_text */
+typedef struct file_text {
+    const char *text;
+    size_t len;
+
+    /* If nonzero, text is mapped into memory, and is *not* NUL-terminated.
+    Otherwise, text was malloc'd, and is NUL-terminated. */
+    size_t map_size;
+} file_text_t;
 
 int getln(char buf[], int buf_len, FILE *file);
 char *load_file(const char *filename);
 char *read_stream(FILE *file, const char *filename);
+void file_text_cleanup(file_text_t *file_text);
+int read_stream_text(file_text_t *file_text, FILE *file,
+    const char *filename);
+int map_file(file_text_t *file_text, const char *filename);
 
 #endif
\ No newline at end of file
@@ -3,10 +3,16 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <ctype.h>
+#include <limits.h>
+#include <stdint.h>
 #include <string.h>
 #include <assert.h>
+#include <pthread.h>
 
 #include "lexer.h"
+#include "lexer_scan.h"
+#include "lexer_keywords.h"
+#include "arena.h"
 #include "str_utils.h"
 #include "stringstore.h"
 #include "tokentree.h"
@@ -15,25 +21,42 @@
 
 struct tokentree_frame {
     tokentree_t *tokentree; /* TOKENTREE_TAG_ARR */
-    int i; /* Index within tokentree */
+    size_t i; /* Index within tokentree */
 };
 
 
-static size_t _strnlen(const char *s, size_t maxlen) {
-    size_t len = 0;
-    while (len < maxlen && s[len] != '\0') len++;
-    return len;
-}
-
 static char *_strndup(const char *s1, size_t len) {
-    size_t s_len = _strnlen(s1, len);
+    const char *nul = memchr(s1, '\0', len);
+    size_t s_len = nul? nul - s1: len;
     char *s2 = malloc(s_len + 1);
     if (s2 == NULL) return NULL;
-    strncpy(s2, s1, len);
+    memcpy(s2, s1, s_len);
     s2[s_len] = '\0';
     return s2;
 }
 
+static int lexer_tokentree_int(lexer_t *lexer) {
+    /* NOTE: caller guarantees lexer->tokentree (or the current node of
+    lexer->loaded_flat) is an INT or INTS */
+    if (lexer->loaded_flat) {
+        return lexer->loaded_flat->nodes.elems[lexer->flat_i].u.int_f;
+    }
+    tokentree_t *tokentree = lexer->tokentree;
+    return tokentree->tag == TOKENTREE_TAG_INTS?
+        tokentree->u.ints_f.elems[lexer->tokentree_int_i]:
+        tokentree->u.int_f;
+}
+
+static const char *lexer_tokentree_string(lexer_t *lexer) {
+    /* If we're parsing a tokentree (or a flat one), returns the current
+    node's string; otherwise, returns NULL.
+    NOTE: caller guarantees lexer->token_type is LEXER_TOKEN_{NAME,OP,STR} */
+    if (lexer->loaded_flat) {
+        return tokentree_flat_string(lexer->loaded_flat, lexer->flat_i);
+    }
+    return lexer->tokentree? lexer->tokentree->u.string_f: NULL;
+}
+
 static int lexer_token_type_from_tokentree_tag(int tag) {
     /* Converts enum tokentree_tag to enum lexer_token_type */
     switch (tag) {
@@ -42,25 +65,39 @@ static int lexer_token_type_from_tokentree_tag(int tag) {
         case TOKENTREE_TAG_OP: return LEXER_TOKEN_OP;
         case TOKENTREE_TAG_STR: return LEXER_TOKEN_STR;
         case TOKENTREE_TAG_ARR: return LEXER_TOKEN_OPEN;
+        case TOKENTREE_TAG_INTS: return LEXER_TOKEN_INT;
         default: return LEXER_TOKEN_TYPES; /* Invalid value */
     }
 }
 
 
 
-const int INITIAL_INDENTS_SIZE = 32;
-const int INITIAL_TOKENTREE_FRAMES_SIZE = 32;
+const size_t INITIAL_INDENTS_SIZE = 32;
+const size_t INITIAL_TOKENTREE_FRAMES_SIZE = 32;
+
+/* How much input lexer_load_stream asks its read_fn for at a time */
+#define LEXER_STREAM_CHUNK_SIZE (1024 * 64)
+
+/* lexer_load_tokens_parallel doesn't bother splitting text into chunks
+smaller than this */
+#define LEXER_PARALLEL_MIN_CHUNK_SIZE (1024 * 64)
 
 static int lexer_get_indent(lexer_t *lexer);
 
 void lexer_cleanup(lexer_t *lexer) {
     free(lexer->indents);
     free(lexer->tokentree_frames);
+    free(lexer->line_starts.elems);
+    free(lexer->tokens.elems);
+    free(lexer->stream_buf);
+    free(lexer->str_buf.elems);
+    free(lexer->flat_ends.elems);
 }
 
 void lexer_init(lexer_t *lexer, stringstore_t *store) {
     memset(lexer, 0, sizeof(*lexer));
     lexer->token_type = LEXER_TOKEN_DONE;
+    lexer->keyword_id = LEXER_KEYWORD_NONE;
     lexer->store = store;
 }
 
@@ -73,18 +110,22 @@ void lexer_dump(lexer_t *lexer, FILE *f) {
     if (lexer == NULL) return;
     /* fprintf(f, "  text = ...\n"); */
     fprintf(f, "  filename = %s\n", lexer->filename? lexer->filename: "(none)");
-    fprintf(f, "  pos = %i\n", lexer->pos);
-    fprintf(f, "  row = %i\n", lexer->row);
-    fprintf(f, "  col = %i\n", lexer->col);
-    fprintf(f, "  returning_indents = %i\n", lexer->returning_indents);
-    fprintf(f, "  indent = %i\n", lexer->indent);
-    fprintf(f, "  indents_size = %i\n", lexer->indents_size);
-    fprintf(f, "  indents_len = %i\n", lexer->indents_len);
+    size_t row, col;
+    lexer_get_row_col(lexer, lexer->pos, &row, &col);
+    fprintf(f, "  pos = %zu\n", lexer->pos);
+    fprintf(f, "  row = %zu\n", row);
+    fprintf(f, "  col = %zu\n", col);
+    fprintf(f, "  returning_indents = %td\n", lexer->returning_indents);
+    fprintf(f, "  indent = %zu\n", lexer->indent);
+    fprintf(f, "  indents_size = %zu\n", lexer->indents_size);
+    fprintf(f, "  indents_len = %zu\n", lexer->indents_len);
     fprintf(f, "  indents:\n");
-    for (int i = 0; i < lexer->indents_len; i++) {
-        fprintf(f, "    %i\n", lexer->indents[i]);
+    for (size_t i = 0; i < lexer->indents_len; i++) {
+        fprintf(f, "    %zu\n", lexer->indents[i]);
     }
 
+    fprintf(f, "  tokens: %zu\n", lexer->tokens.len);
+    fprintf(f, "  token_i = %zu\n", lexer->token_i);
     fprintf(f, "  loaded_tokentree = ");
     if (lexer->loaded_tokentree) {
         (void) tokentree_write(lexer->loaded_tokentree, writer);
@@ -101,25 +142,93 @@ void lexer_dump(lexer_t *lexer, FILE *f) {
             fprintf(f, "(none)");
         }
         fprintf(f, "\n");
-        fprintf(f, "  tokentree_frames_size = %i\n", lexer->tokentree_frames_size);
-        fprintf(f, "  tokentree_frames_len = %i\n", lexer->tokentree_frames_len);
+        fprintf(f, "  tokentree_int_i = %zu\n", lexer->tokentree_int_i);
+        fprintf(f, "  tokentree_frames_size = %zu\n", lexer->tokentree_frames_size);
+        fprintf(f, "  tokentree_frames_len = %zu\n", lexer->tokentree_frames_len);
         fprintf(f, "  tokentree_frames:\n");
-        for (int i = 0; i < lexer->tokentree_frames_len; i++) {
+        for (size_t i = 0; i < lexer->tokentree_frames_len; i++) {
             tokentree_frame_t *frame = &lexer->tokentree_frames[i];
-            fprintf(f, "    [%i] ", frame->i);
+            fprintf(f, "    [%zu] ", frame->i);
             (void) tokentree_write(frame->tokentree, writer);
             fprintf(f, "\n");
         }
     }
 
+    if (lexer->loaded_flat) {
+        fprintf(f, "  loaded_flat: %zu nodes\n",
+            lexer->loaded_flat->nodes.len);
+        fprintf(f, "  flat_i = %zu\n", lexer->flat_i);
+        fprintf(f, "  flat_ends:\n");
+        ARRAY_FOR(size_t, lexer->flat_ends, flat_end) {
+            fprintf(f, "    %zu\n", *flat_end);
+        }
+    }
+
     writer_cleanup(writer);
 }
 
+static int lexer_build_line_starts(lexer_t *lexer) {
+    ARRAY_PUSH(size_t, lexer->line_starts, first_line_start)
+    *first_line_start = 0;
+
+    const char *text = lexer->text;
+    const char *end = text + lexer->text_len;
+    const char *newline = text;
+    while ((newline = memchr(newline, '\n', end - newline))) {
+        newline++;
+        ARRAY_PUSH(size_t, lexer->line_starts, line_start)
+        *line_start = newline - text;
+    }
+    return 0;
+}
+
+void lexer_get_row_col(lexer_t *lexer, size_t pos, size_t *row_ptr,
+    size_t *col_ptr
+) {
+    /* Works out the (0-based) row & column of pos within lexer->text */
+    if (!lexer->text) {
+        /* E.g. we're parsing a tokentree */
+        *row_ptr = 0;
+        *col_ptr = pos;
+        return;
+    }
+
+    if (!lexer->line_starts.len) {
+        if (lexer_build_line_starts(lexer)) {
+            /* Out of memory: do it the slow way */
+            size_t row = 0, line_start = 0;
+            for (size_t i = 0; i < pos; i++) {
+                if (lexer->text[i] == '\n') {
+                    row++;
+                    line_start = i + 1;
+                }
+            }
+            lexer->line_starts.len = 0;
+            *row_ptr = lexer->text_row + row;
+            *col_ptr = pos - line_start;
+            return;
+        }
+    }
+
+    /* Binary search for the last line starting at or before pos */
+    size_t *line_starts = lexer->line_starts.elems;
+    size_t lo = 0, hi = lexer->line_starts.len;
+    while (hi - lo > 1) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (line_starts[mid] <= pos) lo = mid;
+        else hi = mid;
+    }
+    *row_ptr = lexer->text_row + lo;
+    *col_ptr = pos - line_starts[lo];
+}
+
 void lexer_info(lexer_t *lexer, FILE *f) {
-    fprintf(f, "%s: row %i: col %i: ",
+    size_t row, col;
+    lexer_get_row_col(lexer, lexer->pos, &row, &col);
+    fprintf(f, "%s: row %zu: col %zu: ",
         lexer->filename,
-        lexer->row + 1,
-        lexer->col - lexer->token_len + 1);
+        row + 1,
+        col - lexer->token_len + 1);
 }
 
 void lexer_err_info(lexer_t *lexer) {
@@ -130,13 +239,22 @@ void lexer_err_info(lexer_t *lexer) {
 int lexer_load(lexer_t *lexer, const char *text,
     const char *filename
 ) {
+    return lexer_load_n(lexer, text, strlen(text), filename);
+}
+
+static int lexer_load_range(lexer_t *lexer, const char *text,
+    size_t start, size_t end, const char *filename
+) {
+    /* Loads text, but only lexes text[start : end].
+    So that rows are reported correctly, start should be the start of a
+    line. */
     int err;
 
     if (lexer_loaded(lexer)) lexer_unload(lexer);
 
     if (lexer->indents_size == 0) {
-        int indents_size = INITIAL_INDENTS_SIZE;
-        int *indents = calloc(indents_size, sizeof(*indents));
+        size_t indents_size = INITIAL_INDENTS_SIZE;
+        size_t *indents = calloc(indents_size, sizeof(*indents));
         if (indents == NULL) return 1;
 
         lexer->indents_size = indents_size;
@@ -145,7 +263,8 @@ int lexer_load(lexer_t *lexer, const char *text,
 
     lexer->filename = filename;
     lexer->text = text;
-    lexer->text_len = strlen(text);
+    lexer->text_len = end;
+    lexer->pos = start;
     lexer->token_type = LEXER_TOKEN_DONE;
 
     err = lexer_get_indent(lexer);
@@ -155,13 +274,518 @@ int lexer_load(lexer_t *lexer, const char *text,
     return 0;
 }
 
+int lexer_load_n(lexer_t *lexer, const char *text, size_t text_len,
+    const char *filename
+) {
+    /* Like lexer_load, but text needn't be NUL-terminated (e.g. it may be
+    a file mapped into memory with map_file): we never read text at or
+    beyond text_len. */
+    return lexer_load_range(lexer, text, 0, text_len, filename);
+}
+
+static int lexer_read_chunk(lexer_t *lexer) {
+    /* Streaming only: drops the lines of text before the one containing
+    pos, and appends the next chunk of input to text */
+    int err;
+
+    /* Text always starts at the start of a line, so that we can keep track
+    of rows for lexer_get_row_col */
+    size_t keep = lexer->pos;
+    while (keep > 0 && lexer->stream_buf[keep - 1] != '\n') keep--;
+    if (keep > 0) {
+        for (size_t i = 0; i < keep; i++) {
+            if (lexer->stream_buf[i] == '\n') lexer->text_row++;
+        }
+        memmove(lexer->stream_buf, lexer->stream_buf + keep,
+            lexer->text_len - keep);
+        lexer->text_len -= keep;
+        lexer->pos -= keep;
+        lexer->line_starts.len = 0;
+    }
+
+    if (lexer->stream_buf_size - lexer->text_len < LEXER_STREAM_CHUNK_SIZE) {
+        /* A very long line: make room for it */
+        if (lexer->stream_buf_size > SIZE_MAX / 2) {
+            lexer_err_info(lexer);
+            fprintf(stderr, "Line is too long\n");
+            return 2;
+        }
+        size_t new_size = lexer->stream_buf_size * 2;
+        char *new_buf = realloc(lexer->stream_buf, new_size);
+        if (!new_buf) return 1;
+        lexer->stream_buf = new_buf;
+        lexer->stream_buf_size = new_size;
+        lexer->text = new_buf;
+    }
+
+    size_t n_read;
+    err = lexer->read_fn(lexer->read_data,
+        lexer->stream_buf + lexer->text_len,
+        lexer->stream_buf_size - lexer->text_len, &n_read);
+    if (err) return err;
+    if (n_read == 0) lexer->read_eof = true;
+    lexer->text_len += n_read;
+    lexer->line_starts.len = 0;
+    return 0;
+}
+
+static int lexer_fill(lexer_t *lexer) {
+    /* Streaming only: makes sure that text holds all of the line containing
+    pos (up to and including its '\n'), reading more input if necessary.
+    No token spans lines, so this means lexer_next may scan a token without
+    worrying about reaching the end of text before the end of input. */
+    int err;
+
+    if (!lexer->read_fn) return 0;
+
+    /* Number of bytes after pos which we know contain no '\n' */
+    size_t scanned = 0;
+    while (!lexer->read_eof) {
+        size_t n = lexer->text_len - lexer->pos - scanned;
+        if (memchr(lexer->text + lexer->pos + scanned, '\n', n)) break;
+        scanned += n;
+        err = lexer_read_chunk(lexer);
+        if (err) return err;
+    }
+    return 0;
+}
+
+int lexer_load_stream(lexer_t *lexer, lexer_read_fn_t *read_fn,
+    void *read_data, const char *filename
+) {
+    /* Like lexer_load, but reads text from read_fn as it's needed, keeping
+    only the current line and at most a chunk or so of input in memory.
+    So multi-gigabyte inputs may be lexed in constant memory, as long as
+    their lines are of reasonable length.
+    NOTE: lexer->token is only valid until the next call to lexer_next.
+    Can't be used with lexer_load_tokens, which records offsets into the
+    whole text. */
+
+    if (lexer_loaded(lexer)) lexer_unload(lexer);
+
+    if (!lexer->stream_buf) {
+        size_t stream_buf_size = LEXER_STREAM_CHUNK_SIZE * 2;
+        char *stream_buf = malloc(stream_buf_size);
+        if (!stream_buf) return 1;
+        lexer->stream_buf = stream_buf;
+        lexer->stream_buf_size = stream_buf_size;
+    }
+
+    lexer->read_fn = read_fn;
+    lexer->read_data = read_data;
+    return lexer_load_n(lexer, lexer->stream_buf, 0, filename);
+}
+
+int lexer_read_file(void *read_data, char *buf, size_t size,
+    size_t *n_read_ptr
+) {
+    /* A lexer_read_fn_t which reads from read_data, a FILE * */
+    FILE *file = read_data;
+    size_t n_read = fread(buf, 1, size, file);
+    if (n_read < size && ferror(file)) {
+        perror("fread");
+        return 1;
+    }
+    *n_read_ptr = n_read;
+    return 0;
+}
+
+static void lexer_set_keyword_id(lexer_t *lexer) {
+    /* Works out lexer->keyword_id for the current token */
+    lexer->keyword_id = LEXER_KEYWORD_NONE;
+    if (
+        lexer->token_type != LEXER_TOKEN_NAME &&
+        lexer->token_type != LEXER_TOKEN_OP
+    ) return;
+
+    const char *string = lexer_tokentree_string(lexer);
+    if (string) {
+        lexer->keyword_id = lexer_keyword_id(string, strlen(string));
+    } else {
+        lexer->keyword_id = lexer_keyword_id(lexer->token, lexer->token_len);
+    }
+}
+
+static const char LEXER_OPEN_TEXT[] = "(";
+static const char LEXER_CLOSE_TEXT[] = ")";
+
+static void lexer_set_token_i(lexer_t *lexer, size_t i) {
+    /* Makes lexer->tokens.elems[i] the current token */
+    lexer_token_t *token = &lexer->tokens.elems[i];
+    lexer->token_i = i;
+    lexer->token_type = token->type;
+    lexer->keyword_id = token->keyword_id;
+    if (token->type == LEXER_TOKEN_DONE) {
+        lexer->token = NULL;
+        lexer->token_len = 0;
+        lexer->pos = token->offset;
+    } else if (token->len == 0) {
+        lexer->token = token->type == LEXER_TOKEN_OPEN?
+            LEXER_OPEN_TEXT: LEXER_CLOSE_TEXT;
+        lexer->token_len = 1;
+        lexer->pos = token->offset;
+    } else {
+        lexer->token = lexer->text + token->offset;
+        lexer->token_len = token->len;
+        lexer->pos = token->offset + token->len;
+    }
+}
+
+static int lexer_grow_tokens(arrayof_inplace_lexer_token_t *tokens) {
+    ARRAY_GROW(lexer_token_t, *tokens)
+    return 0;
+}
+
+int lexer_load_tokens(lexer_t *lexer, const char *text,
+    const char *filename
+) {
+    return lexer_load_tokens_n(lexer, text, strlen(text), filename);
+}
+
+static int lexer_record_tokens(lexer_t *lexer, const char *text,
+    size_t start, size_t end, const char *filename
+) {
+    /* Loads text, lexing all of text[start : end] into lexer->tokens */
+    int err;
+
+    /* Take lexer->tokens' memory (if any) for reuse, so that lexer_next
+    lexes text normally while we record its tokens */
+    arrayof_inplace_lexer_token_t tokens = lexer->tokens;
+    tokens.len = 0;
+    ARRAY_ZERO(lexer->tokens)
+
+    err = lexer_load_range(lexer, text, start, end, filename);
+    while (!err) {
+        if (tokens.len >= tokens.size) {
+            err = lexer_grow_tokens(&tokens);
+            if (err) break;
+        }
+        lexer_token_t *token = &tokens.elems[tokens.len++];
+        token->type = lexer->token_type;
+        token->keyword_id = lexer->keyword_id;
+        if (
+            lexer->token == NULL ||
+            lexer->token == LEXER_OPEN_TEXT ||
+            lexer->token == LEXER_CLOSE_TEXT
+        ) {
+            token->offset = lexer->pos;
+            token->len = 0;
+        } else {
+            token->offset = lexer->token - text;
+            token->len = lexer->token_len;
+        }
+        if (token->type == LEXER_TOKEN_DONE) break;
+        err = lexer_next(lexer);
+    }
+
+    lexer->tokens = tokens;
+    if (err) {
+        lexer->tokens.len = 0;
+        return err;
+    }
+
+    lexer_set_token_i(lexer, 0);
+    return 0;
+}
+
+int lexer_load_tokens_n(lexer_t *lexer, const char *text, size_t text_len,
+    const char *filename
+) {
+    /* Like lexer_load_n, but lexes all of text up front, recording its tokens
+    in lexer->tokens (with indentation already turned into OPEN and CLOSE
+    tokens), which lexer_next then simply steps through.
+    Parsers may look ahead at upcoming tokens with lexer_peek_token. */
+    return lexer_record_tokens(lexer, text, 0, text_len, filename);
+}
+
+static bool lexer_can_split(const char *text, size_t line_start,
+    size_t end, size_t min
+) {
+    /* Whether text may be split at line_start (which follows a '\n'), so
+    that the two parts may be lexed separately (see
+    lexer_load_tokens_parallel and lexer_relex).
+    That's the case if line_start begins a line with a token or comment in
+    column 0, which the lexer reaches by way of a newline (as opposed to by
+    eating whitespace, which may span lines; see lexer_eat_whitespace).
+    All indentation is closed at such a line, so lexing from there gives
+    the same tokens as lexing from the start.
+    Only looks at text[min : end]; if that's not enough to tell, returns
+    false. */
+    if (line_start >= end) return false;
+    if (lexer_char_is(text[line_start], LEXER_CC_BLANK)) return false;
+
+    /* Find the start of the run of blank lines (and spaces) which precedes
+    the line */
+    size_t i = line_start - 1;
+    while (i > min && (text[i - 1] == '\n' || text[i - 1] == ' ')) i--;
+    if (i == 0) return min == 0;
+    return
+        i > min && text[i] == '\n' &&
+        !lexer_char_is(text[i - 1], LEXER_CC_BLANK);
+}
+
+static size_t lexer_find_split(const char *text, size_t pos, size_t end,
+    size_t min
+) {
+    /* Returns the first position after pos at which text may be split
+    (see lexer_can_split), or end if there is none */
+    while (pos < end) {
+        const char *newline = memchr(text + pos, '\n', end - pos);
+        if (!newline) break;
+        pos = newline - text + 1;
+        if (lexer_can_split(text, pos, end, min)) return pos;
+    }
+    return end;
+}
+
+static size_t lexer_find_split_before(const char *text, size_t pos) {
+    /* Returns the last position before pos at which text may be split
+    (see lexer_can_split), looking only at text[0 : pos], or 0 if there is
+    none */
+    size_t line_start = pos;
+    while (line_start > 0) {
+        /* Step back to the start of the previous line */
+        line_start--;
+        while (line_start > 0 && text[line_start - 1] != '\n') line_start--;
+        if (line_start > 0 && lexer_can_split(text, line_start, pos, 0)) {
+            return line_start;
+        }
+    }
+    return 0;
+}
+
+typedef struct lexer_job {
+    pthread_t thread;
+    bool started;
+    lexer_t lexer;
+    const char *text;
+    size_t start;
+    size_t end;
+    const char *filename;
+    int err;
+} lexer_job_t;
+
+static void *lexer_job_main(void *arg) {
+    lexer_job_t *job = arg;
+    job->err = lexer_record_tokens(&job->lexer, job->text,
+        job->start, job->end, job->filename);
+    return NULL;
+}
+
+int lexer_load_tokens_parallel(lexer_t *lexer, const char *text,
+    size_t text_len, const char *filename, int n_jobs
+) {
+    /* Like lexer_load_tokens_n, but splits text into up to n_jobs chunks
+    (see lexer_find_split), lexes each chunk on its own thread, and then
+    stitches their tokens together.
+    Each thread's lexer sees the whole of text, so tokens' offsets need no
+    fixing up, and errors are reported with the right rows.
+    NOTE: if several chunks have errors, they are all reported (in no
+    particular order), and the first chunk's error is returned. */
+    int err = 0;
+
+    size_t max_jobs = text_len / LEXER_PARALLEL_MIN_CHUNK_SIZE;
+    if (n_jobs < 2 || max_jobs < 2) {
+        return lexer_load_tokens_n(lexer, text, text_len, filename);
+    }
+    if (n_jobs > max_jobs) n_jobs = max_jobs;
+
+    lexer_job_t *jobs = calloc(n_jobs, sizeof(*jobs));
+    if (!jobs) return 1;
+
+    /* Split text & start lexing */
+    size_t end = text_len;
+    size_t start = 0;
+    int n_started_jobs = 0;
+    while (start < end) {
+        lexer_job_t *job = &jobs[n_started_jobs++];
+        size_t split = n_started_jobs == n_jobs? end:
+            end * n_started_jobs / n_jobs;
+        if (split < start) split = start;
+
+        lexer_init(&job->lexer, lexer->store);
+        job->text = text;
+        job->start = start;
+        job->end = split < end? lexer_find_split(text, split, end, 0): end;
+        job->filename = filename;
+        job->started = !pthread_create(&job->thread, NULL, &lexer_job_main,
+            job);
+        if (!job->started) {
+            /* Couldn't start a thread: do the work ourselves */
+            lexer_job_main(job);
+        }
+        start = job->end;
+    }
+
+    size_t n_tokens = 1; /* The final DONE */
+    for (int i = 0; i < n_started_jobs; i++) {
+        lexer_job_t *job = &jobs[i];
+        if (job->started) pthread_join(job->thread, NULL);
+        if (!err) err = job->err;
+        if (!err) n_tokens += job->lexer.tokens.len - 1;
+    }
+
+    /* Stitch the jobs' tokens together, dropping the DONE at the end of
+    each chunk but the last */
+    if (!err) {
+        if (lexer_loaded(lexer)) lexer_unload(lexer);
+        arrayof_inplace_lexer_token_t *tokens = &lexer->tokens;
+        while (!err && tokens->size < n_tokens) {
+            err = lexer_grow_tokens(tokens);
+        }
+        for (int i = 0; !err && i < n_started_jobs; i++) {
+            lexer_job_t *job = &jobs[i];
+            size_t n = job->lexer.tokens.len - (i < n_started_jobs - 1);
+            memcpy(tokens->elems + tokens->len, job->lexer.tokens.elems,
+                n * sizeof(*tokens->elems));
+            tokens->len += n;
+        }
+    }
+    if (!err) {
+        lexer->filename = filename;
+        lexer->text = text;
+        lexer->text_len = text_len;
+        lexer_set_token_i(lexer, 0);
+    }
+
+    for (int i = 0; i < n_started_jobs; i++) lexer_cleanup(&jobs[i].lexer);
+    free(jobs);
+    return err;
+}
+
+static size_t lexer_tokens_before(arrayof_inplace_lexer_token_t *tokens,
+    size_t pos
+) {
+    /* Returns the number of tokens which were lexed before pos, a position
+    at which text may be split (see lexer_can_split).
+    That's the tokens starting before pos, plus any CLOSEs produced by
+    indentation being closed at pos. */
+    lexer_token_t *elems = tokens->elems;
+    size_t lo = 0, hi = tokens->len;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (elems[mid].offset < pos) lo = mid + 1;
+        else hi = mid;
+    }
+    while (
+        lo < tokens->len &&
+        elems[lo].offset == pos &&
+        elems[lo].type == LEXER_TOKEN_CLOSE &&
+        elems[lo].len == 0
+    ) lo++;
+    return lo;
+}
+
+int lexer_relex(lexer_t *lexer, const char *text, size_t text_len,
+    lexer_edit_t *edit
+) {
+    /* Updates lexer->tokens, as recorded by lexer_load_tokens* (or by an
+    earlier lexer_relex) from the old lexer->text, for the new text, which
+    is the old text with old text[edit->start : edit->old_end] replaced by
+    text[edit->start : edit->new_end].
+    Only the top-level lines around the edit are re-lexed: from the last
+    split point (see lexer_can_split) before the edit, to the first one
+    after it. The old tokens either side are kept (those after the edit
+    having their offsets shifted).
+    Fills in the rest of edit, and rewinds the lexer to the first token.
+    On error, the lexer is left as it was (on the old text), and should be
+    reloaded with lexer_load_tokens*. */
+    int err;
+
+    if (!lexer->tokens.len) {
+        fprintf(stderr, "%s: Lexer wasn't loaded with lexer_load_tokens\n",
+            __func__);
+        return 2;
+    }
+
+    /* The text after the edit is the same length in the old and new
+    texts */
+    size_t old_len = lexer->text_len;
+    if (
+        edit->old_end < edit->start || edit->old_end > old_len ||
+        edit->new_end < edit->start || edit->new_end > text_len ||
+        text_len - edit->new_end != old_len - edit->old_end
+    ) {
+        fprintf(stderr, "%s: Bad edit: [%zu : %zu] -> [%zu : %zu] "
+            "(old len: %zu, new len: %zu)\n", __func__,
+            edit->start, edit->old_end, edit->start, edit->new_end,
+            old_len, text_len);
+        return 2;
+    }
+
+    /* NOTE: when looking for the split point after the edit, we mustn't
+    look at any of the edited text, since the split point must also be
+    one in the old text */
+    size_t start = lexer_find_split_before(text, edit->start);
+    size_t end = lexer_find_split(text, edit->new_end, text_len,
+        edit->new_end + 1);
+
+    lexer_t _relexer, *relexer = &_relexer;
+    lexer_init(relexer, lexer->store);
+    err = lexer_record_tokens(relexer, text, start, end, lexer->filename);
+    if (!err) {
+        arrayof_inplace_lexer_token_t *tokens = &lexer->tokens;
+        arrayof_inplace_lexer_token_t *new_tokens = &relexer->tokens;
+
+        /* Unless we re-lexed to the end of text, the re-lexed tokens' DONE
+        is replaced by the old tokens after the split point (which was at
+        old_text_end in the old text) */
+        size_t old_text_end = end - edit->new_end + edit->old_end;
+        size_t first = lexer_tokens_before(tokens, start);
+        size_t old_last = end < text_len?
+            lexer_tokens_before(tokens, old_text_end): tokens->len;
+        size_t n_new = new_tokens->len - (end < text_len);
+        size_t n_tail = tokens->len - old_last;
+        size_t new_len = first + n_new + n_tail;
+
+        while (!err && tokens->size < new_len) {
+            err = lexer_grow_tokens(tokens);
+        }
+        if (!err) {
+            memmove(&tokens->elems[first + n_new], &tokens->elems[old_last],
+                n_tail * sizeof(*tokens->elems));
+            memcpy(&tokens->elems[first], new_tokens->elems,
+                n_new * sizeof(*tokens->elems));
+            for (size_t i = first + n_new; i < new_len; i++) {
+                tokens->elems[i].offset =
+                    tokens->elems[i].offset - old_text_end + end;
+            }
+            tokens->len = new_len;
+
+            edit->relex_start = start;
+            edit->relex_end = end;
+            edit->first_token = first;
+            edit->n_old_tokens = old_last - first;
+            edit->n_new_tokens = n_new;
+        }
+    }
+    lexer_cleanup(relexer);
+    if (err) return err;
+
+    lexer->text = text;
+    lexer->text_len = text_len;
+    lexer->line_starts.len = 0;
+    lexer_set_token_i(lexer, 0);
+    return 0;
+}
+
+const lexer_token_t *lexer_peek_token(lexer_t *lexer, size_t n) {
+    /* Returns the token n tokens after the current one (so n == 0 gives the
+    current token), or the final DONE token if there aren't that many.
+    Only works with lexer_load_tokens, otherwise returns NULL. */
+    if (!lexer->tokens.len) return NULL;
+    size_t i = n < lexer->tokens.len - lexer->token_i?
+        lexer->token_i + n: lexer->tokens.len - 1;
+    return &lexer->tokens.elems[i];
+}
+
 int lexer_load_tokentree(lexer_t *lexer, tokentree_t *tokentree,
     const char *filename
 ) {
     if (lexer_loaded(lexer)) lexer_unload(lexer);
 
     if (lexer->tokentree_frames_size == 0) {
-        int tokentree_frames_size = INITIAL_TOKENTREE_FRAMES_SIZE;
+        size_t tokentree_frames_size = INITIAL_TOKENTREE_FRAMES_SIZE;
         tokentree_frame_t *tokentree_frames = calloc(
             tokentree_frames_size, sizeof(*tokentree_frames));
         if (tokentree_frames == NULL) return 1;
@@ -176,6 +800,43 @@ int lexer_load_tokentree(lexer_t *lexer, tokentree_t *tokentree,
 
     lexer->loaded_tokentree = tokentree;
     lexer->tokentree = tokentree;
+    lexer->tokentree_int_i = 0;
+    lexer_set_keyword_id(lexer);
+    return 0;
+}
+
+static void lexer_set_flat_token_type(lexer_t *lexer) {
+    /* Works out lexer->token_type for node lexer->flat_i of
+    lexer->loaded_flat (which may be the end of an ARR, or of the nodes) */
+    arrayof_size_t *flat_ends = &lexer->flat_ends;
+    if (
+        flat_ends->len &&
+        flat_ends->elems[flat_ends->len - 1] == lexer->flat_i
+    ) {
+        flat_ends->len--;
+        lexer->token_type = LEXER_TOKEN_CLOSE;
+    } else if (lexer->flat_i >= lexer->loaded_flat->nodes.len) {
+        lexer->token_type = LEXER_TOKEN_DONE;
+    } else {
+        lexer->token_type = lexer_token_type_from_tokentree_tag(
+            lexer->loaded_flat->nodes.elems[lexer->flat_i].tag);
+    }
+}
+
+int lexer_load_tokentree_flat(lexer_t *lexer, tokentree_flat_t *flat,
+    const char *filename
+) {
+    /* Like lexer_load_tokentree, but parses all of flat's tokentrees, one
+    after another (as if they were top-level lines of text).
+    Since flat's nodes are in pre-order, we just step through them, keeping
+    track of where each open ARR ends. */
+    if (lexer_loaded(lexer)) lexer_unload(lexer);
+
+    lexer->filename = filename;
+    lexer->loaded_flat = flat;
+    lexer->flat_i = 0;
+    lexer_set_flat_token_type(lexer);
+    lexer_set_keyword_id(lexer);
     return 0;
 }
 
@@ -183,21 +844,31 @@ void lexer_unload(lexer_t *lexer) {
     lexer->filename = NULL;
     lexer->text_len = 0;
     lexer->text = NULL;
+    lexer->read_fn = NULL;
+    lexer->read_data = NULL;
+    lexer->read_eof = false;
+    lexer->text_row = 0;
     lexer->token_len = 0;
     lexer->token = NULL;
+    lexer->keyword_id = LEXER_KEYWORD_NONE;
     lexer->pos = 0;
-    lexer->row = 0;
-    lexer->col = 0;
+    lexer->line_starts.len = 0;
+    lexer->tokens.len = 0;
+    lexer->token_i = 0;
     lexer->returning_indents = 0;
     lexer->indent = 0;
     lexer->indents_len = 0;
     lexer->loaded_tokentree = NULL;
     lexer->tokentree = NULL;
+    lexer->tokentree_int_i = 0;
     lexer->tokentree_frames_len = 0;
+    lexer->loaded_flat = NULL;
+    lexer->flat_i = 0;
+    lexer->flat_ends.len = 0;
 }
 
 bool lexer_loaded(lexer_t *lexer) {
-    return lexer->loaded_tokentree || lexer->text;
+    return lexer->loaded_tokentree || lexer->loaded_flat || lexer->text;
 }
 
 static void lexer_start_token(lexer_t *lexer) {
@@ -206,7 +877,7 @@ static void lexer_start_token(lexer_t *lexer) {
 }
 
 static void lexer_end_token(lexer_t *lexer) {
-    int token_startpos = lexer->token - lexer->text;
+    size_t token_startpos = lexer->token - lexer->text;
     lexer->token_len = lexer->pos - token_startpos;
 }
 
@@ -220,12 +891,13 @@ static void lexer_set_token(
 
 static int lexer_push_indent(
     lexer_t *lexer,
-    int indent
+    size_t indent
 ) {
     if (lexer->indents_len >= lexer->indents_size) {
-        int indents_size = lexer->indents_size;
-        int new_indents_size = indents_size * 2;
-        int *new_indents = realloc(lexer->indents,
+        size_t indents_size = lexer->indents_size;
+        if (indents_size > SIZE_MAX / 2 / sizeof(*lexer->indents)) return 1;
+        size_t new_indents_size = indents_size * 2;
+        size_t *new_indents = realloc(lexer->indents,
             new_indents_size * sizeof(*new_indents));
         if (new_indents == NULL) return 1;
         memset(new_indents + indents_size, 0,
@@ -263,8 +935,11 @@ static int lexer_push_tokentree_frame(
     assert(tokentree->tag == TOKENTREE_TAG_ARR);
 
     if (lexer->tokentree_frames_len >= lexer->tokentree_frames_size) {
-        int tokentree_frames_size = lexer->tokentree_frames_size;
-        int new_tokentree_frames_size = tokentree_frames_size * 2;
+        size_t tokentree_frames_size = lexer->tokentree_frames_size;
+        if (tokentree_frames_size >
+            SIZE_MAX / 2 / sizeof(*lexer->tokentree_frames)
+        ) return 1;
+        size_t new_tokentree_frames_size = tokentree_frames_size * 2;
         tokentree_frame_t *new_tokentree_frames = realloc(lexer->tokentree_frames,
             new_tokentree_frames_size * sizeof(*new_tokentree_frames));
         if (new_tokentree_frames == NULL) return 1;
@@ -290,25 +965,34 @@ static void lexer_pop_tokentree_frame(lexer_t *lexer) {
 }
 
 
+static char lexer_char_at(lexer_t *lexer, size_t pos) {
+    /* Text is bounded by text_len rather than by a NUL terminator, so
+    we report its end as '\0' */
+    return pos < lexer->text_len? lexer->text[pos]: '\0';
+}
+
 static char lexer_peek(lexer_t *lexer) {
-    return lexer->text[lexer->pos + 1];
+    return lexer_char_at(lexer, lexer->pos + 1);
 }
 
 static char lexer_eat(lexer_t *lexer) {
-    char c = lexer->text[lexer->pos];
-    lexer->pos++;
-    if (c == '\n') {
-        lexer->row++;
-        lexer->col = 0;
-    } else {
-        lexer->col++;
-    }
-    return c;
+    /* NOTE: we only track pos; row & col are worked out from it when
+    they're needed (see lexer_get_row_col) */
+    return lexer->text[lexer->pos++];
 }
 
 static int lexer_get_indent(lexer_t *lexer) {
-    int indent = 0;
-    while (lexer->pos < lexer->text_len) {
+    int err;
+    size_t indent = 0;
+    while (1) {
+        if (lexer->pos >= lexer->text_len) {
+            /* When streaming, the indentation may continue in the next
+            chunk of input */
+            err = lexer_fill(lexer);
+            if (err) return err;
+            if (lexer->pos >= lexer->text_len) break;
+        }
+
         char c = lexer->text[lexer->pos];
         if (c == ' ') {
             indent++;
@@ -318,7 +1002,7 @@ static int lexer_get_indent(lexer_t *lexer) {
             just reset the indentation and restart on next line */
             indent = 0;
             lexer_eat(lexer);
-        } else if (c != '\0' && isspace(c)) {
+        } else if (lexer_char_is(c, LEXER_CC_SPACE)) {
             lexer_err_info(lexer);
             fprintf(stderr,
                 "Indented with whitespace other than ' ' "
@@ -332,32 +1016,38 @@ static int lexer_get_indent(lexer_t *lexer) {
     return 0;
 }
 
-static void lexer_eat_whitespace(lexer_t *lexer) {
-    while (lexer->pos < lexer->text_len) {
-        char c = lexer->text[lexer->pos];
-        if (c == '\0' || isgraph(c)) break;
-        lexer_eat(lexer);
+static int lexer_eat_whitespace(lexer_t *lexer) {
+    /* NOTE: this also eats any newlines following the first (non-newline)
+    whitespace character */
+    int err;
+    while (1) {
+        lexer->pos = lexer_scan(lexer->text, lexer->pos,
+            lexer->text_len, LEXER_CC_BLANK);
+
+        /* Since we may eat newlines, when streaming, the whitespace may
+        continue in the next chunk of input */
+        if (
+            lexer->pos < lexer->text_len ||
+            !lexer->read_fn || lexer->read_eof
+        ) break;
+        err = lexer_read_chunk(lexer);
+        if (err) return err;
     }
+    return 0;
 }
 
 static void lexer_eat_comment(lexer_t *lexer) {
     /* eat leading '#' */
     lexer_eat(lexer);
 
-    while (lexer->pos < lexer->text_len) {
-        char c = lexer->text[lexer->pos];
-        if (c == '\n') break;
-        lexer_eat(lexer);
-    }
+    lexer->pos = lexer_scan(lexer->text, lexer->pos,
+        lexer->text_len, LEXER_CC_LINE);
 }
 
 static void lexer_parse_name(lexer_t *lexer) {
     lexer_start_token(lexer);
-    while (lexer->pos < lexer->text_len) {
-        char c = lexer->text[lexer->pos];
-        if (c != '_' && !isalnum(c)) break;
-        lexer_eat(lexer);
-    }
+    lexer->pos = lexer_scan(lexer->text, lexer->pos,
+        lexer->text_len, LEXER_CC_NAME);
     lexer_end_token(lexer);
 }
 
@@ -365,24 +1055,17 @@ static void lexer_parse_int(lexer_t *lexer) {
     lexer_start_token(lexer);
 
     /* eat leading '-' if present */
-    if (lexer->text[lexer->pos] == '-') lexer_eat(lexer);
+    if (lexer_char_at(lexer, lexer->pos) == '-') lexer_eat(lexer);
 
-    while (lexer->pos < lexer->text_len) {
-        char c = lexer->text[lexer->pos];
-        if (!isdigit(c)) break;
-        lexer_eat(lexer);
-    }
+    lexer->pos = lexer_scan(lexer->text, lexer->pos,
+        lexer->text_len, LEXER_CC_DIGIT);
     lexer_end_token(lexer);
 }
 
 static void lexer_parse_op(lexer_t *lexer) {
     lexer_start_token(lexer);
-    while (lexer->pos < lexer->text_len) {
-        char c = lexer->text[lexer->pos];
-        if (c == '(' || c == ')' || c == ':'
-            || !isgraph(c) || isalnum(c)) break;
-        lexer_eat(lexer);
-    }
+    lexer->pos = lexer_scan(lexer->text, lexer->pos,
+        lexer->text_len, LEXER_CC_OP);
     lexer_end_token(lexer);
 }
 
@@ -393,7 +1076,11 @@ static int lexer_parse_str(lexer_t *lexer) {
     lexer_eat(lexer);
 
     while (1) {
-        char c = lexer->text[lexer->pos];
+        /* Skip ahead to the next character needing special treatment */
+        lexer->pos = lexer_scan(lexer->text, lexer->pos,
+            lexer->text_len, LEXER_CC_STR);
+
+        char c = lexer_char_at(lexer, lexer->pos);
         if (c == '\0') {
             goto err_eof;
         } else if (c == '\n') {
@@ -403,7 +1090,7 @@ static int lexer_parse_str(lexer_t *lexer) {
             break;
         } else if (c == '\\') {
             lexer_eat(lexer);
-            char c = lexer->text[lexer->pos];
+            char c = lexer_char_at(lexer, lexer->pos);
             if (c == '\0') {
                 goto err_eof;
             } else if (c == '\n') {
@@ -433,15 +1120,8 @@ static int lexer_parse_blockstr(lexer_t *lexer) {
     lexer_eat(lexer);
     lexer_eat(lexer);
 
-    while (lexer->pos < lexer->text_len) {
-        char c = lexer->text[lexer->pos];
-        if (c == '\0') {
-            break;
-        } else if (c == '\n') {
-            break;
-        }
-        lexer_eat(lexer);
-    }
+    lexer->pos = lexer_scan(lexer->text, lexer->pos,
+        lexer->text_len, LEXER_CC_LINE);
     lexer_end_token(lexer);
     return 0;
 }
@@ -458,6 +1138,16 @@ static int lexer_next_tokentree(lexer_t *lexer) {
         return 0;
     }
 
+    if (
+        lexer->tokentree->tag == TOKENTREE_TAG_INTS &&
+        lexer->tokentree_int_i < lexer->tokentree->u.ints_f.len - 1
+    ) {
+        /* Return the next of the INTS node's ints */
+        lexer->tokentree_int_i++;
+        return 0;
+    }
+    lexer->tokentree_int_i = 0;
+
     if (lexer->token_type == LEXER_TOKEN_OPEN) {
         /* Previously, we returned LEXER_TOKEN_OPEN.
         Now we "open" lexer->tokentree, which is guaranteed to be an
@@ -503,24 +1193,60 @@ static int lexer_next_tokentree(lexer_t *lexer) {
     return 0;
 }
 
+static int lexer_next_flat(lexer_t *lexer) {
+    if (lexer->token_type == LEXER_TOKEN_DONE) return 0;
+    if (lexer->token_type == LEXER_TOKEN_OPEN) {
+        /* "Open" the ARR, whose elements follow it */
+        tokentree_flat_node_t *node =
+            &lexer->loaded_flat->nodes.elems[lexer->flat_i];
+        ARRAY_PUSH(size_t, lexer->flat_ends, flat_end)
+        *flat_end = lexer->flat_i + node->u.span;
+        lexer->flat_i++;
+    } else if (lexer->token_type != LEXER_TOKEN_CLOSE) {
+        lexer->flat_i++;
+    }
+    lexer_set_flat_token_type(lexer);
+    return 0;
+}
+
 int lexer_next(lexer_t *lexer) {
     int err;
 
-    if (lexer->loaded_tokentree) return lexer_next_tokentree(lexer);
+    if (lexer->loaded_flat) {
+        err = lexer_next_flat(lexer);
+        if (err) return err;
+        lexer_set_keyword_id(lexer);
+        return 0;
+    }
+    if (lexer->loaded_tokentree) {
+        err = lexer_next_tokentree(lexer);
+        if (err) return err;
+        lexer_set_keyword_id(lexer);
+        return 0;
+    }
+    if (lexer->tokens.len) {
+        if (lexer->token_i < lexer->tokens.len - 1) {
+            lexer_set_token_i(lexer, lexer->token_i + 1);
+        }
+        return 0;
+    }
 
     while (1) {
         /* return "(" or ")" token based on indents? */
         if (lexer->returning_indents != 0) break;
 
-        char c = lexer->text[lexer->pos];
+        err = lexer_fill(lexer);
+        if (err) return err;
+
+        char c = lexer_char_at(lexer, lexer->pos);
         if (c == '\0' || c == '\n') {
             if (c == '\n') lexer_eat(lexer);
 
             err = lexer_get_indent(lexer);
             if (err) return err;
-            int new_indent = lexer->indent;
+            size_t new_indent = lexer->indent;
             while (lexer->indents_len > 0) {
-                int indent = lexer->indents[lexer->indents_len-1];
+                size_t indent = lexer->indents[lexer->indents_len-1];
                 if (new_indent <= indent) {
                     err = lexer_pop_indent(lexer);
                     if (err) return err;
@@ -537,12 +1263,14 @@ int lexer_next(lexer_t *lexer) {
                 lexer->token_type = LEXER_TOKEN_DONE;
                 break;
             }
-        } else if (isspace(c)) {
-            lexer_eat_whitespace(lexer);
+        } else if (lexer_char_is(c, LEXER_CC_SPACE)) {
+            err = lexer_eat_whitespace(lexer);
+            if (err) return err;
         } else if (c == ':') {
             lexer_eat(lexer);
             lexer->returning_indents++;
-            lexer_push_indent(lexer, lexer->indent);
+            err = lexer_push_indent(lexer, lexer->indent);
+            if (err) return err;
             break;
         } else if (c == '(' || c == ')') {
             lexer_start_token(lexer);
@@ -550,12 +1278,15 @@ int lexer_next(lexer_t *lexer) {
             lexer_end_token(lexer);
             lexer->token_type = c == '('? LEXER_TOKEN_OPEN: LEXER_TOKEN_CLOSE;
             break;
-        } else if (c == '_' || isalpha(c)) {
+        } else if (
+            lexer_char_is(c, LEXER_CC_NAME) &&
+            !lexer_char_is(c, LEXER_CC_DIGIT)
+        ) {
             lexer_parse_name(lexer);
             lexer->token_type = LEXER_TOKEN_NAME;
             break;
-        } else if (isdigit(c) || (
-            c == '-' && isdigit(lexer_peek(lexer))
+        } else if (lexer_char_is(c, LEXER_CC_DIGIT) || (
+            c == '-' && lexer_char_is(lexer_peek(lexer), LEXER_CC_DIGIT)
         )) {
             lexer_parse_int(lexer);
             lexer->token_type = LEXER_TOKEN_INT;
@@ -581,15 +1312,16 @@ int lexer_next(lexer_t *lexer) {
 
     if (lexer->returning_indents > 0) {
         lexer->token_type = LEXER_TOKEN_OPEN;
-        lexer_set_token(lexer, "(");
+        lexer_set_token(lexer, LEXER_OPEN_TEXT);
         lexer->returning_indents--;
     }
     if (lexer->returning_indents < 0) {
         lexer->token_type = LEXER_TOKEN_CLOSE;
-        lexer_set_token(lexer, ")");
+        lexer_set_token(lexer, LEXER_CLOSE_TEXT);
         lexer->returning_indents++;
     }
 
+    lexer_set_keyword_id(lexer);
     return 0;
 }
 
@@ -606,7 +1338,7 @@ bool lexer_got(lexer_t *lexer, const char *text) {
     allow using it with DONE, OPEN, CLOSE, and INT since those are
     easy enough to check for. */
 
-    if (lexer->loaded_tokentree) {
+    if (lexer->loaded_tokentree || lexer->loaded_flat) {
         if (text[0] == '(') {
             return lexer->token_type == LEXER_TOKEN_OPEN;
         } else if (text[0] == ')') {
@@ -618,11 +1350,14 @@ bool lexer_got(lexer_t *lexer, const char *text) {
 
             /* Kind of ganky, but I believe it works (TODO: make sure...) */
             int i = atoi(text);
-            return lexer->tokentree->u.int_f == i;
+            return lexer_tokentree_int(lexer) == i;
         } else {
-            if (!lexer->tokentree) return false;
-            if (!tokentree_tag_is_string(lexer->tokentree->tag)) return false;
-            return !strcmp(lexer->tokentree->u.string_f, text);
+            if (
+                lexer->token_type != LEXER_TOKEN_NAME &&
+                lexer->token_type != LEXER_TOKEN_OP &&
+                lexer->token_type != LEXER_TOKEN_STR
+            ) return false;
+            return !strcmp(lexer_tokentree_string(lexer), text);
         }
     }
 
@@ -670,10 +1405,18 @@ void lexer_show(lexer_t *lexer, FILE *f) {
     writer_init(writer, f);
     writer->oneline = true;
 
-    if (lexer->tokentree) {
+    if (lexer->tokentree && lexer->tokentree->tag == TOKENTREE_TAG_INTS) {
+        (void) writer_write_int(writer, lexer_tokentree_int(lexer));
+    } else if (lexer->tokentree) {
         (void) tokentree_write(lexer->tokentree, writer);
+    } else if (lexer->loaded_flat && lexer->token_type == LEXER_TOKEN_CLOSE) {
+        fprintf(f, "\"%s\"", LEXER_CLOSE_TEXT);
+    } else if (lexer->loaded_flat && lexer->token_type != LEXER_TOKEN_DONE) {
+        (void) tokentree_flat_write(lexer->loaded_flat, lexer->flat_i, writer);
     } else if (lexer->token) {
-        fprintf(f, "\"%.*s\"", lexer->token_len, lexer->token);
+        /* printf's precision is an int, so very long tokens are cut off */
+        int len = lexer->token_len > INT_MAX? INT_MAX: (int)lexer->token_len;
+        fprintf(f, "\"%.*s\"", len, lexer->token);
     } else {
         fprintf(f, "end of input");
     }
@@ -696,8 +1439,9 @@ int lexer_get(lexer_t *lexer, const char *text) {
 
 static int _lexer_get_name_or_op(lexer_t *lexer, char **string) {
     /* NOTE: caller guarantees lexer->token_type is LEXER_TOKEN_{NAME,OP} */
-    if (lexer->tokentree) {
-        *string = _strdup(lexer->tokentree->u.string_f);
+    const char *tokentree_string = lexer_tokentree_string(lexer);
+    if (tokentree_string) {
+        *string = _strdup(tokentree_string);
         if (*string == NULL) return 1;
     } else {
         *string = _strndup(lexer->token, lexer->token_len);
@@ -725,8 +1469,16 @@ int lexer_get_string(lexer_t *lexer, char **string) {
 static int _lexer_get_const_name_or_op(lexer_t *lexer, const char **string) {
     /* NOTE: caller guarantees lexer->token_type is LEXER_TOKEN_{NAME,OP} */
 
-    if (lexer->tokentree) {
-        *string = lexer->tokentree->u.string_f;
+    const char *const_string = lexer_tokentree_string(lexer);
+    if (const_string) {
+        /* The tokentree's strings may not be owned by our store, so we
+        intern them (if we have a store) to keep the promise that const
+        names and ops are owned by lexer->store */
+        if (lexer->store) {
+            const_string = stringstore_get(lexer->store, const_string);
+            if (!const_string) return 1;
+        }
+        *string = const_string;
         return lexer_next(lexer);
     }
 
@@ -735,11 +1487,8 @@ static int _lexer_get_const_name_or_op(lexer_t *lexer, const char **string) {
         return 2;
     }
 
-    char *_string = _strndup(lexer->token, lexer->token_len);
-    if (_string == NULL) return 1;
-
-    const char *const_string = stringstore_get_donate(lexer->store,
-        _string);
+    const_string = stringstore_get_n(lexer->store,
+        lexer->token, lexer->token_len);
     if (!const_string) return 1;
 
     *string = const_string;
@@ -782,45 +1531,71 @@ int lexer_get_const_op(lexer_t *lexer, const char **op) {
     return _lexer_get_const_name_or_op(lexer, op);
 }
 
+static bool _lexer_str_has_escapes(const char *token, size_t token_len) {
+    return memchr(token + 1, '\\', token_len - 2) != NULL;
+}
+
+static size_t _lexer_decode_str(const char *token, size_t token_len,
+    char *s
+) {
+    /* Writes the value of STR token (without its surrounding '"' characters,
+    and with escapes resolved) to s, which must have room for token_len - 1
+    bytes.
+    Returns the value's length. */
+    const char *p = token + 1;
+    const char *end = token + token_len - 1; /* The closing '"' */
+    char *s_start = s;
+    while (p < end) {
+        /* Copy everything up to the next escape in one go */
+        const char *backslash = memchr(p, '\\', end - p);
+        const char *run_end = backslash? backslash: end;
+        memcpy(s, p, run_end - p);
+        s += run_end - p;
+        if (!backslash) break;
+
+        /* NOTE: the lexer guarantees there is a character after the
+        backslash, which isn't the closing '"' */
+        *s++ = backslash[1];
+        p = backslash + 2;
+    }
+    *s = '\0';
+    return s - s_start;
+}
+
+static int lexer_grow_str_buf(lexer_t *lexer, size_t size) {
+    while (lexer->str_buf.size < size) ARRAY_GROW(char, lexer->str_buf)
+    return 0;
+}
+
 int lexer_get_str(lexer_t *lexer, char **s) {
     if (!lexer_got_str(lexer)) return lexer_unexpected(lexer, "str");
 
-    if (lexer->tokentree) {
-        *s = _strdup(lexer->tokentree->u.string_f);
+    const char *tokentree_string = lexer_tokentree_string(lexer);
+    if (tokentree_string) {
+        *s = _strdup(tokentree_string);
         if (*s == NULL) return 1;
         return lexer_next(lexer);
     }
 
     if (lexer->token_type == LEXER_TOKEN_STR) {
         const char *token = lexer->token;
-        int token_len = lexer->token_len;
+        size_t token_len = lexer->token_len;
 
-        /* Length of s is length of token without the surrounding
+        /* Length of s is at most length of token without the surrounding
         '"' characters */
-        int s_len = token_len - 2;
-
-        char *ss0 = malloc(s_len + 1);
-        if (ss0 == NULL) return 1;
-        char *ss = ss0;
+        size_t s_len = token_len - 2;
 
-        for (int i = 1; i < token_len - 1; i++) {
-            char c = token[i];
-            if (c == '\\') {
-                i++;
-                c = token[i];
-            }
-            *ss = c;
-            ss++;
-        }
+        char *ss = malloc(s_len + 1);
+        if (ss == NULL) return 1;
+        _lexer_decode_str(token, token_len, ss);
 
-        *ss = '\0';
-        *s = ss0;
+        *s = ss;
     } else if (lexer->token_type == LEXER_TOKEN_BLOCKSTR) {
         const char *token = lexer->token;
-        int token_len = lexer->token_len;
+        size_t token_len = lexer->token_len;
 
         /* Length of s is length of token without the leading ";;" */
-        int s_len = token_len - 2;
+        size_t s_len = token_len - 2;
 
         char *ss = _strndup(token+2, s_len);
         if (ss == NULL) return 1;
@@ -835,8 +1610,41 @@ int lexer_get_const_str(lexer_t *lexer, const char **s) {
 
     if (!lexer_got_str(lexer)) return lexer_unexpected(lexer, "str");
 
-    if (lexer->tokentree) {
-        *s = lexer->tokentree->u.string_f;
+    const char *tokentree_string = lexer_tokentree_string(lexer);
+    if (tokentree_string && lexer->loaded_flat &&
+        lexer->loaded_flat->strings
+    ) {
+        /* The strings of a flat loaded from a file point into the file's
+        data, which may be freed before the str is used, so we copy them
+        (into str_arena if we have one, otherwise into the store) */
+        tokentree_string = lexer->str_arena?
+            arena_strndup(lexer->str_arena, tokentree_string,
+                strlen(tokentree_string)):
+            lexer->store? stringstore_get(lexer->store, tokentree_string):
+            NULL;
+        if (!tokentree_string) {
+            if (lexer->str_arena || lexer->store) return 1;
+            fprintf(stderr, "%s: Lexer requires stringstore\n", __func__);
+            return 2;
+        }
+    }
+    if (tokentree_string) {
+        *s = tokentree_string;
+        return lexer_next(lexer);
+    }
+
+    if (lexer->str_arena) {
+        char *ss;
+        if (lexer->token_type == LEXER_TOKEN_BLOCKSTR) {
+            ss = arena_strndup(lexer->str_arena,
+                lexer->token + 2, lexer->token_len - 2);
+            if (ss == NULL) return 1;
+        } else {
+            ss = arena_alloc(lexer->str_arena, lexer->token_len - 1);
+            if (ss == NULL) return 1;
+            _lexer_decode_str(lexer->token, lexer->token_len, ss);
+        }
+        *s = ss;
         return lexer_next(lexer);
     }
 
@@ -845,23 +1653,177 @@ int lexer_get_const_str(lexer_t *lexer, const char **s) {
         return 2;
     }
 
+    if (
+        lexer->token_type == LEXER_TOKEN_BLOCKSTR ||
+        !_lexer_str_has_escapes(lexer->token, lexer->token_len)
+    ) {
+        /* Blockstrs (and most strs) have no escapes, so we can intern them
+        straight out of the text (without the leading ";;" or the
+        surrounding '"' characters) */
+        int prefix_len = lexer->token_type == LEXER_TOKEN_BLOCKSTR? 2: 1;
+        const char *cs = stringstore_get_n(lexer->store,
+            lexer->token + prefix_len, lexer->token_len - 2);
+        if (!cs) return 1;
+
+        *s = cs;
+        return lexer_next(lexer);
+    }
+
+    /* NOTE: lexer_get_str calls lexer_next for us */
     char *_s;
     err = lexer_get_str(lexer, &_s);
     if (err) return err;
 
     const char *cs = stringstore_get_donate(lexer->store, _s);
-    if (!cs) return 1;
+    if (!cs) {
+        free(_s);
+        return 1;
+    }
 
     *s = cs;
+    return 0;
+}
+
+int lexer_get_str_view(lexer_t *lexer, const char **s, size_t *len) {
+    /* Like lexer_get_const_str, but *s is a view of the str's value, which
+    is NOT NUL-terminated (its length is *len).
+    Unless the str has escapes, the view points straight into lexer->text,
+    and is valid until the text is unloaded. Otherwise (and always when
+    streaming, since the text moves), the value is decoded into
+    lexer->str_buf, and the view is only valid until the next call. */
+    int err;
+
+    if (!lexer_got_str(lexer)) return lexer_unexpected(lexer, "str");
+
+    const char *tokentree_string = lexer_tokentree_string(lexer);
+    if (tokentree_string) {
+        *s = tokentree_string;
+        *len = strlen(*s);
+        return lexer_next(lexer);
+    }
+
+    const char *token = lexer->token;
+    size_t token_len = lexer->token_len;
+    if (lexer->token_type == LEXER_TOKEN_BLOCKSTR) {
+        *s = token + 2;
+        *len = token_len - 2;
+        if (lexer->read_fn) {
+            err = lexer_grow_str_buf(lexer, token_len - 1);
+            if (err) return err;
+            memcpy(lexer->str_buf.elems, *s, *len);
+            *s = lexer->str_buf.elems;
+        }
+    } else if (!lexer->read_fn && !_lexer_str_has_escapes(token, token_len)) {
+        *s = token + 1;
+        *len = token_len - 2;
+    } else {
+        err = lexer_grow_str_buf(lexer, token_len - 1);
+        if (err) return err;
+        *len = _lexer_decode_str(token, token_len, lexer->str_buf.elems);
+        *s = lexer->str_buf.elems;
+    }
     return lexer_next(lexer);
 }
 
+static int _lexer_parse_int(const char *token, size_t token_len) {
+    /* Like atoi, but token needn't be NUL-terminated (e.g. if the text is
+    mapped into memory with map_file), and is known to be a valid INT */
+    bool negative = token[0] == '-';
+    unsigned int u = 0;
+    for (size_t i = negative; i < token_len; i++) {
+        u = u * 10 + (token[i] - '0');
+    }
+    return negative? (int)-u: (int)u;
+}
+
 int lexer_get_int(lexer_t *lexer, int *i) {
     if (!lexer_got_int(lexer)) return lexer_unexpected(lexer, "int");
-    *i = lexer->tokentree? lexer->tokentree->u.int_f: atoi(lexer->token);
+    *i = lexer->text? _lexer_parse_int(lexer->token, lexer->token_len):
+        lexer_tokentree_int(lexer);
     return lexer_next(lexer);
 }
 
+static int lexer_push_int(arrayof_int_t *ints, int i) {
+    ARRAY_PUSH(int, *ints, new_i)
+    *new_i = i;
+    return 0;
+}
+
+int lexer_get_ints(lexer_t *lexer, arrayof_int_t *ints) {
+    /* Gets a run of one or more INT tokens, appending them to ints.
+    Same as calling lexer_get_int until !lexer_got_int, but ints are read
+    in bulk where possible: straight from the text (for the rest of the
+    run on the current line), from lexer->tokens, or from an INTS node,
+    rather than going through lexer_next for each one. */
+    int err;
+    if (!lexer_got_int(lexer)) return lexer_unexpected(lexer, "int");
+    while (lexer_got_int(lexer)) {
+        if (lexer->loaded_flat) {
+            int i;
+            err = lexer_get_int(lexer, &i);
+            if (!err) err = lexer_push_int(ints, i);
+            if (err) return err;
+        } else if (lexer->loaded_tokentree) {
+            tokentree_t *tokentree = lexer->tokentree;
+            if (tokentree->tag == TOKENTREE_TAG_INTS) {
+                /* The rest of the INTS node's ints */
+                arrayof_int_t *node_ints = &tokentree->u.ints_f;
+                for (size_t i = lexer->tokentree_int_i; i < node_ints->len;
+                    i++
+                ) {
+                    err = lexer_push_int(ints, node_ints->elems[i]);
+                    if (err) return err;
+                }
+                lexer->tokentree_int_i = node_ints->len - 1;
+            } else {
+                err = lexer_push_int(ints, tokentree->u.int_f);
+                if (err) return err;
+            }
+            err = lexer_next(lexer);
+            if (err) return err;
+        } else if (lexer->tokens.len) {
+            /* The tokens array always ends with DONE, so this stops */
+            size_t i = lexer->token_i;
+            lexer_token_t *token;
+            while ((token = &lexer->tokens.elems[i])->type == LEXER_TOKEN_INT) {
+                err = lexer_push_int(ints, _lexer_parse_int(
+                    lexer->text + token->offset, token->len));
+                if (err) return err;
+                i++;
+            }
+            lexer_set_token_i(lexer, i);
+        } else {
+            /* Scan ints separated by spaces ourselves, and leave anything
+            else (e.g. a newline, which may close indented blocks) to
+            lexer_next. Even when streaming, the whole of the current line
+            is in text (see lexer_fill). */
+            const char *text = lexer->text;
+            size_t end = lexer->text_len;
+            size_t pos = lexer->pos;
+            err = lexer_push_int(ints,
+                _lexer_parse_int(lexer->token, lexer->token_len));
+            if (err) return err;
+            while (1) {
+                size_t start = pos;
+                while (start < end && text[start] == ' ') start++;
+                size_t digits = start < end && text[start] == '-'?
+                    start + 1: start;
+                if (digits >= end || !lexer_char_is(text[digits],
+                    LEXER_CC_DIGIT)
+                ) break;
+                pos = lexer_scan(text, digits, end, LEXER_CC_DIGIT);
+                err = lexer_push_int(ints,
+                    _lexer_parse_int(text + start, pos - start));
+                if (err) return err;
+            }
+            lexer->pos = pos;
+            err = lexer_next(lexer);
+            if (err) return err;
+        }
+    }
+    return 0;
+}
+
 int lexer_get_open(lexer_t *lexer) {
     if (!lexer_got_open(lexer)) return lexer_unexpected(lexer, "'('");
     return lexer_next(lexer);
@@ -882,7 +1844,7 @@ int lexer_unexpected(lexer_t *lexer, const char *expected) {
 }
 
 int lexer_parse_silent(lexer_t *lexer) {
-    int depth = 1;
+    size_t depth = 1;
     while (1) {
         int err;
 
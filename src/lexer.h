@@ -31,12 +31,15 @@
 #include <stddef.h>
 #include <stdio.h>
 
+#include "array.h"
 
 
 
 /* Expected from other translation units */
 typedef struct stringstore stringstore_t;
 typedef struct tokentree tokentree_t;
+typedef struct arena arena_t;
+typedef struct tokentree_flat tokentree_flat_t;
 
 
 /* Expected from lexer.c */
@@ -56,6 +59,52 @@ enum lexer_token_type {
 };
 
 
+/* A token, as recorded by lexer_load_tokens */
+typedef struct lexer_token {
+    /* The token's text is lexer->text[offset : offset + len].
+    OPEN and CLOSE tokens which come from indentation (as opposed to
+    literal "(" and ")") have len 0, and offset is the lexer's pos when they
+    were produced. So is DONE's. */
+    size_t offset;
+    size_t len;
+
+    int type; /* enum lexer_token_type */
+    int keyword_id; /* See lexer->keyword_id */
+} lexer_token_t;
+
+typedef ARRAYOF(lexer_token_t) arrayof_inplace_lexer_token_t;
+typedef ARRAYOF(size_t) arrayof_size_t;
+typedef ARRAYOF(int) arrayof_int_t;
+
+
+/* An edit to a lexer's text, for lexer_relex */
+typedef struct lexer_edit {
+    /* Set by caller: old text[start : old_end] was replaced by
+    new text[start : new_end] */
+    size_t start;
+    size_t old_end;
+    size_t new_end;
+
+    /* Set by lexer_relex: the top-level lines which were re-lexed were
+    new text[relex_start : relex_end], and their tokens replaced old
+    tokens[first_token : first_token + n_old_tokens] with new
+    tokens[first_token : first_token + n_new_tokens] */
+    size_t relex_start;
+    size_t relex_end;
+    size_t first_token;
+    size_t n_old_tokens;
+    size_t n_new_tokens;
+} lexer_edit_t;
+
+
+/* Input callback for lexer_load_stream: reads up to size bytes into buf,
+and sets *n_read_ptr to the number of bytes read (0 at end of input).
+Returns nonzero on error.
+See lexer_read_file for an implementation which reads from a FILE *. */
+typedef int lexer_read_fn_t(void *read_data, char *buf, size_t size,
+    size_t *n_read_ptr);
+
+
 typedef struct lexer {
     const char *filename;
 
@@ -63,29 +112,66 @@ typedef struct lexer {
     or never plan to use the lexer_get_const_* methods */
     stringstore_t *store;
 
-    int text_len;
+    /* Weakref: if non-NULL, lexer_get_const_str copies strs into this arena
+    instead of interning them in store.
+    Strs are rarely looked up by value, and data files may be full of
+    unique ones, which would only bloat the store. */
+    arena_t *str_arena;
+
+    /* NOTE: offsets & sizes within text are size_t throughout, so texts
+    may be larger than 2 GiB */
+    size_t text_len;
     const char *text;
 
-    int token_len;
+    /* If read_fn is non-NULL, we were loaded with lexer_load_stream, and
+    text is a window onto the input, which starts at the beginning of row
+    text_row, and is refilled from read_fn as we go. */
+    lexer_read_fn_t *read_fn;
+    void *read_data;
+    bool read_eof;
+    size_t text_row;
+    size_t stream_buf_size;
+    char *stream_buf;
+
+    size_t token_len;
     const char *token;
     int token_type; /* enum lexer_token_type */
 
-    int pos;
-    int row;
-    int col;
+    /* enum lexer_keyword (see lexer_keywords.h): which keyword the current
+    token is, if it's a NAME or OP; otherwise LEXER_KEYWORD_NONE */
+    int keyword_id;
+
+    size_t pos;
+
+    /* Positions at which each line of text starts (so line_starts.elems[0]
+    is always 0), for working out rows & columns when reporting errors.
+    Built on demand by lexer_get_row_col, and emptied by lexer_unload. */
+    ARRAYOF(size_t) line_starts;
+
+    /* Scratch space for lexer_get_str_view */
+    ARRAYOF(char) str_buf;
+
+    /* NOTE: if lexer->tokens.len > 0, then we are returning the tokens
+    recorded by lexer_load_tokens, instead of lexing lexer->text as we go.
+    The last token is always DONE. */
+    arrayof_inplace_lexer_token_t tokens;
+    size_t token_i; /* Index of the current token within tokens */
 
     /* If positive, represents a series of "(" tokens being returned.
-    If negative, represents a series of ")" tokens being returned. */
-    int returning_indents;
+    If negative, represents a series of ")" tokens being returned.
+    (So its magnitude is at most indents_len.) */
+    ptrdiff_t returning_indents;
 
 
     /* STACKS: */
     /* (TODO: use array.h instead of implementing these by hand) */
+    /* NOTE: their depth grows with the input's nesting, so they're only
+    bounded by memory (see lexer_push_indent) */
 
-    int indent;
-    int indents_size;
-    int indents_len;
-    int *indents;
+    size_t indent;
+    size_t indents_size;
+    size_t indents_len;
+    size_t *indents;
 
     /* NOTE: if lexer->loaded_tokentree != NULL, then we are parsing it
     instead of lexer->text.
@@ -93,9 +179,18 @@ typedef struct lexer {
     "end of file" (i.e. LEXER_TOKEN_DONE). */
     tokentree_t *loaded_tokentree;
     tokentree_t *tokentree;
-    int tokentree_frames_size;
-    int tokentree_frames_len;
+    size_t tokentree_int_i; /* Index within tokentree, if it's INTS */
+    size_t tokentree_frames_size;
+    size_t tokentree_frames_len;
     tokentree_frame_t *tokentree_frames;
+
+    /* NOTE: if lexer->loaded_flat != NULL, then we are parsing its nodes
+    (see lexer_load_tokentree_flat).
+    flat_i is the current node, and flat_ends are the ends of the ARRs
+    which we're inside (innermost last). */
+    tokentree_flat_t *loaded_flat;
+    size_t flat_i;
+    arrayof_size_t flat_ends;
 } lexer_t;
 
 
@@ -104,10 +199,29 @@ void lexer_init(lexer_t *lexer, stringstore_t *store);
 void lexer_dump(lexer_t *lexer, FILE *f);
 void lexer_info(lexer_t *lexer, FILE *f);
 void lexer_err_info(lexer_t *lexer);
+void lexer_get_row_col(lexer_t *lexer, size_t pos, size_t *row_ptr,
+    size_t *col_ptr);
 int lexer_load(lexer_t *lexer, const char *text,
     const char *filename);
+int lexer_load_n(lexer_t *lexer, const char *text, size_t text_len,
+    const char *filename);
+int lexer_load_stream(lexer_t *lexer, lexer_read_fn_t *read_fn,
+    void *read_data, const char *filename);
+int lexer_read_file(void *read_data, char *buf, size_t size,
+    size_t *n_read_ptr);
 int lexer_load_tokentree(lexer_t *lexer, tokentree_t *tokentree,
     const char *filename);
+int lexer_load_tokentree_flat(lexer_t *lexer, tokentree_flat_t *flat,
+    const char *filename);
+int lexer_load_tokens(lexer_t *lexer, const char *text,
+    const char *filename);
+int lexer_load_tokens_n(lexer_t *lexer, const char *text, size_t text_len,
+    const char *filename);
+int lexer_load_tokens_parallel(lexer_t *lexer, const char *text,
+    size_t text_len, const char *filename, int n_jobs);
+int lexer_relex(lexer_t *lexer, const char *text, size_t text_len,
+    lexer_edit_t *edit);
+const lexer_token_t *lexer_peek_token(lexer_t *lexer, size_t n);
 void lexer_unload(lexer_t *lexer);
 bool lexer_loaded(lexer_t *lexer);
 int lexer_next(lexer_t *lexer);
@@ -129,7 +243,9 @@ int lexer_get_op(lexer_t *lexer, char **op);
 int lexer_get_const_op(lexer_t *lexer, const char **op);
 int lexer_get_str(lexer_t *lexer, char **s);
 int lexer_get_const_str(lexer_t *lexer, const char **s);
+int lexer_get_str_view(lexer_t *lexer, const char **s, size_t *len);
 int lexer_get_int(lexer_t *lexer, int *i);
+int lexer_get_ints(lexer_t *lexer, arrayof_int_t *ints);
 int lexer_get_open(lexer_t *lexer);
 int lexer_get_close(lexer_t *lexer);
 int lexer_unexpected(lexer_t *lexer, const char *expected);
@@ -0,0 +1,90 @@
+#ifndef _LEXER_KEYWORDS_H_
+#define _LEXER_KEYWORDS_H_
+
+/* Keywords: names & ops which the lexer recognizes as it produces them, so
+that parsers can check for them with a switch on lexer->keyword_id instead
+of a series of lexer_got calls (see GOT_KEYWORD in lexer_macros.h). */
+
+#include <stdint.h>
+#include <string.h>
+
+
+/* X(ID, TEXT, FIRST_CHAR, LAST_CHAR) */
+#define LEXER_KEYWORDS(X) \
+    X(AT, "@", '@', '@') \
+    X(AT_AT, "@@", '@', '@') \
+    X(BANG, "!", '!', '!') \
+    X(VOID, "void", 'v', 'd') \
+    X(ANY, "any", 'a', 'y') \
+    X(TYPE, "type", 't', 'e') \
+    X(INT, "int", 'i', 't') \
+    X(ERR, "err", 'e', 'r') \
+    X(STRING, "string", 's', 'g') \
+    X(BOOL, "bool", 'b', 'l') \
+    X(BYTE, "byte", 'b', 'e') \
+    X(ARRAY, "array", 'a', 'y') \
+    X(STRUCT, "struct", 's', 't') \
+    X(UNION, "union", 'u', 'n') \
+    X(FUNC, "func", 'f', 'c') \
+    X(METHOD, "method", 'm', 'd') \
+    X(EXTERN, "extern", 'e', 'n') \
+    X(TYPEDEF, "typedef", 't', 'f') \
+    X(PACKAGE, "package", 'p', 'e') \
+    X(FROM, "from", 'f', 'm') \
+    X(INPLACE, "inplace", 'i', 'e') \
+    X(WEAKREF, "weakref", 'w', 'f') \
+    X(OUT, "out", 'o', 't') \
+    X(RET, "ret", 'r', 't') \
+    X(ARGS, "args", 'a', 's') \
+    X(EXTRA_CLEANUP, "extra_cleanup", 'e', 'p')
+
+enum lexer_keyword {
+    LEXER_KEYWORD_NONE,
+#define LEXER_KEYWORD_ENUM(ID, TEXT, FIRST, LAST) LEXER_KEYWORD_##ID,
+    LEXER_KEYWORDS(LEXER_KEYWORD_ENUM)
+#undef LEXER_KEYWORD_ENUM
+    LEXER_KEYWORDS_COUNT
+};
+
+static const char *const lexer_keyword_texts[LEXER_KEYWORDS_COUNT] = {
+    NULL,
+#define LEXER_KEYWORD_TEXT(ID, TEXT, FIRST, LAST) TEXT,
+    LEXER_KEYWORDS(LEXER_KEYWORD_TEXT)
+#undef LEXER_KEYWORD_TEXT
+};
+
+static const uint8_t lexer_keyword_lens[LEXER_KEYWORDS_COUNT] = {
+    0,
+#define LEXER_KEYWORD_LEN(ID, TEXT, FIRST, LAST) sizeof(TEXT) - 1,
+    LEXER_KEYWORDS(LEXER_KEYWORD_LEN)
+#undef LEXER_KEYWORD_LEN
+};
+
+/* A perfect hash of the keywords: no two of them may have the same hash.
+(When adding a keyword, check that it doesn't collide with another one;
+if it does, the constants below need changing.) */
+#define LEXER_KEYWORD_TABLE_SIZE 64
+#define LEXER_KEYWORD_HASH(FIRST, LAST, LEN) \
+    (((unsigned char)(FIRST) + (unsigned char)(LAST) + 11 * (LEN)) \
+        & (LEXER_KEYWORD_TABLE_SIZE - 1))
+
+static const uint8_t lexer_keyword_table[LEXER_KEYWORD_TABLE_SIZE] = {
+#define LEXER_KEYWORD_SLOT(ID, TEXT, FIRST, LAST) \
+    [LEXER_KEYWORD_HASH(FIRST, LAST, sizeof(TEXT) - 1)] = LEXER_KEYWORD_##ID,
+    LEXER_KEYWORDS(LEXER_KEYWORD_SLOT)
+#undef LEXER_KEYWORD_SLOT
+};
+
+static int lexer_keyword_id(const char *text, size_t len) {
+    /* Returns the enum lexer_keyword of text (which need not be
+    NUL-terminated), or LEXER_KEYWORD_NONE if it isn't a keyword */
+    if (len == 0) return LEXER_KEYWORD_NONE;
+    int id = lexer_keyword_table[
+        LEXER_KEYWORD_HASH(text[0], text[len - 1], len)];
+    if (id == LEXER_KEYWORD_NONE) return LEXER_KEYWORD_NONE;
+    if (lexer_keyword_lens[id] != len) return LEXER_KEYWORD_NONE;
+    if (memcmp(lexer_keyword_texts[id], text, len)) return LEXER_KEYWORD_NONE;
+    return id;
+}
+
+#endif
@@ -1,10 +1,14 @@
 #ifndef _LEXER_MACROS_H_
 #define _LEXER_MACROS_H_
 
+#include "lexer_keywords.h"
+
 #define DO(X) {err = (X); if (err) return err;}
 #define LOAD(TEXT, FILENAME) DO(lexer_load(lexer, TEXT, FILENAME))
 #define LOAD_TOKENTREE(TOKENTREE, FILENAME) DO(lexer_load_tokentree(lexer, TOKENTREE, FILENAME))
 #define GOT(S) lexer_got(lexer, S)
+#define GOT_KEYWORD(K) (lexer->keyword_id == LEXER_KEYWORD_##K)
+#define KEYWORD(K) LEXER_KEYWORD_##K
 #define GET(S) DO(lexer_get(lexer, S))
 #define NEXT DO(lexer_next(lexer))
 #define PARSE_SILENT DO(lexer_parse_silent(lexer))
@@ -23,7 +27,9 @@
 #define GET_CONST_OP(P) DO(lexer_get_const_op(lexer, (&P)))
 #define GET_STR(P) DO(lexer_get_str(lexer, (&P)))
 #define GET_CONST_STR(P) DO(lexer_get_const_str(lexer, (&P)))
+#define GET_STR_VIEW(P, LEN) DO(lexer_get_str_view(lexer, (&P), (&LEN)))
 #define GET_INT(P) DO(lexer_get_int(lexer, (&P)))
+#define GET_INTS(P) DO(lexer_get_ints(lexer, (&P)))
 #define GET_OPEN DO(lexer_get_open(lexer))
 #define GET_CLOSE DO(lexer_get_close(lexer))
 #define UNEXPECTED(S) lexer_unexpected(lexer, S)
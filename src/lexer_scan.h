@@ -0,0 +1,198 @@
+#ifndef _LEXER_SCAN_H_
+#define _LEXER_SCAN_H_
+
+/* Character classes & scanning of runs of characters, for lexer.c.
+Runs are found 16 (SSE2) or 32 (AVX2) bytes at a time where the compiler
+supports it, falling back to a lookup table. */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#if defined(__GNUC__) && defined(__AVX2__)
+#include <immintrin.h>
+#define LEXER_SCAN_VEC_SIZE 32
+#define LEXER_SCAN_MASK_ALL ((uint32_t)0xffffffff)
+typedef __m256i lexer_scan_vec_t;
+#define LEXER_SCAN_LOAD(P) _mm256_loadu_si256((const __m256i *)(P))
+#define LEXER_SCAN_SET1(C) _mm256_set1_epi8(C)
+#define LEXER_SCAN_ADD(A, B) _mm256_add_epi8(A, B)
+#define LEXER_SCAN_CMPEQ(A, B) _mm256_cmpeq_epi8(A, B)
+#define LEXER_SCAN_CMPGT(A, B) _mm256_cmpgt_epi8(A, B)
+#define LEXER_SCAN_OR(A, B) _mm256_or_si256(A, B)
+#define LEXER_SCAN_AND(A, B) _mm256_and_si256(A, B)
+#define LEXER_SCAN_ANDNOT(A, B) _mm256_andnot_si256(A, B)
+#define LEXER_SCAN_MASK(A) ((uint32_t)_mm256_movemask_epi8(A))
+#elif defined(__GNUC__) && defined(__SSE2__)
+#include <emmintrin.h>
+#define LEXER_SCAN_VEC_SIZE 16
+#define LEXER_SCAN_MASK_ALL ((uint32_t)0xffff)
+typedef __m128i lexer_scan_vec_t;
+#define LEXER_SCAN_LOAD(P) _mm_loadu_si128((const __m128i *)(P))
+#define LEXER_SCAN_SET1(C) _mm_set1_epi8(C)
+#define LEXER_SCAN_ADD(A, B) _mm_add_epi8(A, B)
+#define LEXER_SCAN_CMPEQ(A, B) _mm_cmpeq_epi8(A, B)
+#define LEXER_SCAN_CMPGT(A, B) _mm_cmpgt_epi8(A, B)
+#define LEXER_SCAN_OR(A, B) _mm_or_si128(A, B)
+#define LEXER_SCAN_AND(A, B) _mm_and_si128(A, B)
+#define LEXER_SCAN_ANDNOT(A, B) _mm_andnot_si128(A, B)
+#define LEXER_SCAN_MASK(A) ((uint32_t)_mm_movemask_epi8(A))
+#endif
+
+
+/* Character classes (bit flags).
+These match the <ctype.h> functions in the "C" locale, which is the only
+one the lexer supports, so bytes >= 0x80 are never names or ops. */
+enum lexer_char_class {
+    LEXER_CC_NAME  = 0x01, /* Continues a name: isalnum(c) || c == '_' */
+    LEXER_CC_DIGIT = 0x02, /* isdigit(c) */
+    LEXER_CC_SPACE = 0x04, /* isspace(c) */
+    LEXER_CC_BLANK = 0x08, /* Eaten by lexer_eat_whitespace: !isgraph(c)
+                              && c != '\0' (so includes '\n') */
+    LEXER_CC_OP    = 0x10, /* Continues an op: isgraph(c) && !isalnum(c)
+                              && c isn't one of "():" */
+    LEXER_CC_STR   = 0x20, /* Ordinary character within a str: c isn't
+                              one of '"', '\\', '\n', '\0' */
+    LEXER_CC_LINE  = 0x40, /* Continues a line: c isn't '\n' or '\0' */
+};
+
+static const uint8_t lexer_char_classes[256] = {
+    /* 0x00 */ 0x00, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68,
+    /* 0x08 */ 0x68, 0x6c, 0x0c, 0x6c, 0x6c, 0x6c, 0x68, 0x68,
+    /* 0x10 */ 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68,
+    /* 0x18 */ 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68,
+    /* 0x20 */ 0x6c, 0x70, 0x50, 0x70, 0x70, 0x70, 0x70, 0x70,
+    /* 0x28 */ 0x60, 0x60, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70,
+    /* 0x30 */ 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63,
+    /* 0x38 */ 0x63, 0x63, 0x60, 0x70, 0x70, 0x70, 0x70, 0x70,
+    /* 0x40 */ 0x70, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61,
+    /* 0x48 */ 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61,
+    /* 0x50 */ 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61,
+    /* 0x58 */ 0x61, 0x61, 0x61, 0x70, 0x50, 0x70, 0x70, 0x71,
+    /* 0x60 */ 0x70, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61,
+    /* 0x68 */ 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61,
+    /* 0x70 */ 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61,
+    /* 0x78 */ 0x61, 0x61, 0x61, 0x70, 0x70, 0x70, 0x70, 0x68,
+    /* 0x80 */ 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68,
+    /* 0x88 */ 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68,
+    /* 0x90 */ 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68,
+    /* 0x98 */ 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68,
+    /* 0xa0 */ 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68,
+    /* 0xa8 */ 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68,
+    /* 0xb0 */ 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68,
+    /* 0xb8 */ 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68,
+    /* 0xc0 */ 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68,
+    /* 0xc8 */ 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68,
+    /* 0xd0 */ 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68,
+    /* 0xd8 */ 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68,
+    /* 0xe0 */ 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68,
+    /* 0xe8 */ 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68,
+    /* 0xf0 */ 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68,
+    /* 0xf8 */ 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68, 0x68,
+};
+
+static bool lexer_char_is(char c, int cls) {
+    return lexer_char_classes[(unsigned char)c] & cls;
+}
+
+
+#ifdef LEXER_SCAN_VEC_SIZE
+
+static lexer_scan_vec_t lexer_scan_vec_range(lexer_scan_vec_t v,
+    char lo, char hi
+) {
+    /* Which bytes of v are in the range lo..hi (inclusive).
+    Shifts the range down to start at -128, so that a single signed
+    comparison does the job. */
+    lexer_scan_vec_t shifted = LEXER_SCAN_ADD(v,
+        LEXER_SCAN_SET1((char)(0x80 - lo)));
+    return LEXER_SCAN_CMPGT(LEXER_SCAN_SET1((char)(-128 + (hi - lo + 1))),
+        shifted);
+}
+
+static lexer_scan_vec_t lexer_scan_vec_eq(lexer_scan_vec_t v, char c) {
+    return LEXER_SCAN_CMPEQ(v, LEXER_SCAN_SET1(c));
+}
+
+static lexer_scan_vec_t lexer_scan_vec_alnum(lexer_scan_vec_t v) {
+    return LEXER_SCAN_OR(
+        lexer_scan_vec_range(v, '0', '9'),
+        LEXER_SCAN_OR(
+            lexer_scan_vec_range(v, 'A', 'Z'),
+            lexer_scan_vec_range(v, 'a', 'z')));
+}
+
+static lexer_scan_vec_t lexer_scan_vec_class(lexer_scan_vec_t v, int cls) {
+    /* Which bytes of v are in character class cls (which must be a single
+    enum lexer_char_class).
+    Each case only computes what it needs, since we may not be built
+    with optimizations to strip out the rest. */
+    switch (cls) {
+        case LEXER_CC_NAME:
+            return LEXER_SCAN_OR(lexer_scan_vec_alnum(v),
+                lexer_scan_vec_eq(v, '_'));
+        case LEXER_CC_DIGIT:
+            return lexer_scan_vec_range(v, '0', '9');
+        case LEXER_CC_BLANK:
+            return LEXER_SCAN_ANDNOT(
+                LEXER_SCAN_OR(lexer_scan_vec_range(v, 0x21, 0x7e),
+                    lexer_scan_vec_eq(v, '\0')),
+                LEXER_SCAN_SET1(-1));
+        case LEXER_CC_OP: {
+            lexer_scan_vec_t not_op = LEXER_SCAN_OR(lexer_scan_vec_alnum(v),
+                LEXER_SCAN_OR(lexer_scan_vec_eq(v, '('),
+                    LEXER_SCAN_OR(lexer_scan_vec_eq(v, ')'),
+                        lexer_scan_vec_eq(v, ':'))));
+            return LEXER_SCAN_ANDNOT(not_op,
+                lexer_scan_vec_range(v, 0x21, 0x7e));
+        }
+        case LEXER_CC_STR: {
+            lexer_scan_vec_t not_str = LEXER_SCAN_OR(
+                LEXER_SCAN_OR(lexer_scan_vec_eq(v, '\0'),
+                    lexer_scan_vec_eq(v, '\n')),
+                LEXER_SCAN_OR(lexer_scan_vec_eq(v, '"'),
+                    lexer_scan_vec_eq(v, '\\')));
+            return LEXER_SCAN_ANDNOT(not_str, LEXER_SCAN_SET1(-1));
+        }
+        case LEXER_CC_LINE:
+            return LEXER_SCAN_ANDNOT(
+                LEXER_SCAN_OR(lexer_scan_vec_eq(v, '\0'),
+                    lexer_scan_vec_eq(v, '\n')),
+                LEXER_SCAN_SET1(-1));
+        default:
+            /* LEXER_CC_SPACE isn't scanned for runs */
+            return LEXER_SCAN_SET1(0);
+    }
+}
+
+#endif
+
+
+static size_t lexer_scan(const char *text, size_t pos, size_t end,
+    int cls
+) {
+    /* Returns the position of the first character at or after pos which
+    isn't in character class cls, or end if there is none.
+    Never reads text at or beyond end. */
+#ifdef LEXER_SCAN_VEC_SIZE
+    /* Most runs (names, ops, whitespace between tokens) are short, and
+    are quicker to scan a character at a time, so we only switch to
+    vectors once a run is a whole vector long */
+    size_t short_end = end - pos > LEXER_SCAN_VEC_SIZE?
+        pos + LEXER_SCAN_VEC_SIZE: end;
+    while (pos < short_end && lexer_char_is(text[pos], cls)) pos++;
+    if (pos < short_end) return pos;
+    while (end - pos >= LEXER_SCAN_VEC_SIZE) {
+        lexer_scan_vec_t v = LEXER_SCAN_LOAD(text + pos);
+        uint32_t in_class = LEXER_SCAN_MASK(lexer_scan_vec_class(v, cls));
+        if (in_class != LEXER_SCAN_MASK_ALL) {
+            return pos + __builtin_ctz(~in_class);
+        }
+        pos += LEXER_SCAN_VEC_SIZE;
+    }
+#endif
+    while (pos < end && lexer_char_is(text[pos], cls)) pos++;
+    return pos;
+}
+
+#endif
@@ -12,6 +12,7 @@
 
 bool debug = false;
 bool dump = false;
+bool tokenize = false;
 bool write_typedefs = false;
 bool write_enums = false;
 bool write_structs = false;
@@ -22,6 +23,7 @@ bool write_functions = false;
 bool write_hfile = false;
 bool write_cfile = false;
 bool write_main = false;
+const char *strings_filename = NULL;
 
 
 static void print_usage(FILE *file) {
@@ -30,6 +32,7 @@ static void print_usage(FILE *file) {
         "  -h  --help        Print this message & exit\n"
         "  -D  --debug       Compiler dumps debug information to stderr during compilation\n"
         "  -d  --dump        Dump debug information to stderr after compilation\n"
+        "  -t  --tokenize    Lex each file up front into an array of tokens\n"
         "  -a  --all         Write all compiled C code to stdout\n"
         "      --hfile       Write compiled .h file to stdout\n"
         "      --cfile       Write compiled .c file to stdout\n"
@@ -41,6 +44,9 @@ static void print_usage(FILE *file) {
         "      --protos      Write compiled function prototypes to stdout\n"
         "      --type_defns  Write compiled type definitions to stdout\n"
         "      --functions   Write compiled function definitions to stdout\n"
+        "  -s  --strings FILE  Load interned strings from FILE (if it exists)\n"
+        "                    before compiling, and save them to FILE afterwards,\n"
+        "                    so that later runs can reuse them\n"
     );
 }
 
@@ -52,13 +58,15 @@ int _compile(compiler_t *compiler, int n_filenames, char **filenames) {
         const char *filename = filenames[i];
         fprintf(stderr, "Compiling: %s\n", filename);
 
-        char *buffer = load_file(filename);
-        if (!buffer) return 1;
+        file_text_t file_text;
+        err = map_file(&file_text, filename);
+        if (err) return err;
 
-        err = compiler_compile(compiler, buffer, filename);
+        err = compiler_compile(compiler, file_text.text, file_text.len,
+            filename);
         if (err) return err;
 
-        free(buffer);
+        file_text_cleanup(&file_text);
         fprintf(stderr, "...done compiling: %s\n", filename);
     }
 
@@ -99,6 +107,8 @@ int main(int n_args, char **args) {
             debug = true;
         } else if (!strcmp(arg, "-d") || !strcmp(arg, "--dump")) {
             dump = true;
+        } else if (!strcmp(arg, "-t") || !strcmp(arg, "--tokenize")) {
+            tokenize = true;
         } else if (!strcmp(arg, "-a") || !strcmp(arg, "--all")) {
             write_hfile = true;
             write_cfile = true;
@@ -123,6 +133,13 @@ int main(int n_args, char **args) {
             write_type_defns = true;
         } else if (!strcmp(arg, "--functions")) {
             write_functions = true;
+        } else if (!strcmp(arg, "-s") || !strcmp(arg, "--strings")) {
+            arg_i++;
+            if (arg_i >= n_args) {
+                fprintf(stderr, "Missing value for %s\n", arg);
+                return 2;
+            }
+            strings_filename = args[arg_i];
         } else if (!strcmp(arg, "--")) {
             arg_i++;
             break;
@@ -137,10 +154,22 @@ int main(int n_args, char **args) {
         compiler_t compiler;
 
         stringstore_init(&store);
+        if (strings_filename) {
+            FILE *strings_file = fopen(strings_filename, "rb");
+            if (strings_file) {
+                fclose(strings_file);
+                err = stringstore_load_base(&store, strings_filename);
+                if (err) {
+                    fprintf(stderr, "Ignoring strings file: %s\n",
+                        strings_filename);
+                }
+            }
+        }
         lexer_init(&lexer, &store);
         compiler_init(&compiler, &lexer, &store);
 
         compiler.debug = debug;
+        compiler.tokenize = tokenize;
 
         err = _compile(&compiler, n_args - arg_i, args + arg_i);
         if (err) {
@@ -148,6 +177,17 @@ int main(int n_args, char **args) {
             return err;
         }
 
+        if (strings_filename) {
+            /* Only save strings still in use by the compiler (e.g. not the
+            names of fields of types which were redefined) */
+            compiler_mark_strings(&compiler);
+            err = stringstore_sweep(&store);
+            if (err) return err;
+
+            err = stringstore_save(&store, strings_filename);
+            if (err) return err;
+        }
+
         compiler_cleanup(&compiler);
         lexer_cleanup(&lexer);
         stringstore_cleanup(&store);
@@ -4,7 +4,10 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
+#include <pthread.h>
 
+#include "../array.h"
+#include "../arena.h"
 #include "../tokentree.h"
 #include "../file_utils.h"
 #include "../stringstore.h"
@@ -15,81 +18,750 @@
 
 bool output_oneline = false;
 bool reparse = false;
+bool arena_strs = false;
+bool arena_trees = false;
+bool dedup = false;
+bool flat = false;
+const char *binary_filename = NULL;
+bool tokenize = false;
+bool stream = false;
+int jobs = 1;
+int lex_jobs = 1;
+int relex_edits = 0;
 
 
 static void print_usage(FILE *file) {
     fprintf(file,
         "Usage: tokentree [OPTION ...] [--] [FILE ...]\n"
-        "To read stdin, use the filename \"-\".\n"
         "Options:\n"
         "  -h  --help            Print this message and exit\n"
         "  -i  --oneline         Output tokentree \"oneline\" as opposed to indented\n"
         "  -r  --reparse         Parse the parsed tokentree\n"
         "                        (for testing lexer_load_tokentree)\n"
+        "  -j  --jobs N          Parse up to N files at once, on separate\n"
+        "                        threads sharing one stringstore\n"
+        "  -t  --tokenize        Lex each file up front into an array of tokens\n"
+        "                        (see lexer_load_tokens)\n"
+        "  -J  --lex-jobs N      Lex each large file on up to N threads, by\n"
+        "                        splitting it at top-level lines (implies\n"
+        "                        --tokenize; see lexer_load_tokens_parallel)\n"
+        "  -a  --arena-strs      Copy strs into a per-file arena, rather than\n"
+        "                        interning them (only names and ops are\n"
+        "                        interned)\n"
+        "  -A  --arena-trees     Allocate tokentrees from an arena, rather than\n"
+        "                        with malloc (see tokentree_parse_arena)\n"
+        "  -D  --dedup           Share identical subtrees between the\n"
+        "                        tokentrees parsed from each file (see\n"
+        "                        tokentree_pool_t)\n"
+        "  -F  --flat            Parse into flat tokentrees (see\n"
+        "                        tokentree_flat_t)\n"
+        "  -b  --binary FILE     Save the parsed tokentrees to FILE in binary\n"
+        "                        form (see tokentree_flat_save), rather than\n"
+        "                        writing them out as text\n"
+        "  -S  --stream          Read each file a chunk at a time as it's lexed\n"
+        "                        (see lexer_load_stream), rather than loading it\n"
+        "                        whole (ignored with --tokenize and --jobs)\n"
+        "  -E  --check-relex N   Instead of writing out tokentrees, make N edits\n"
+        "                        to each file, checking that lexer_relex (and\n"
+        "                        lexer_peek_token) agree with lexing the edited\n"
+        "                        text from scratch\n"
+        "Input files may be text, or binary tokentree files (which are loaded\n"
+        "whole, even with --stream).\n"
+        "To read stdin, use the filename \"-\".\n"
     );
 }
 
 
-static int parse_buffer(const char *buffer, const char *filename,
-    stringstore_t *store
+static int parse_tokentree(tokentree_t *tokentree, lexer_t *lexer,
+    const char *filename, stringstore_t *store, arena_t *arena,
+    tokentree_pool_t *pool
+) {
+    /* If arena or pool is non-NULL, tokentree is allocated from it, and
+    must not be passed to tokentree_cleanup */
+    int err;
+
+    err = pool?
+        tokentree_parse_pool(tokentree, lexer, pool):
+        tokentree_parse_arena(tokentree, lexer, arena);
+    if (err) return err;
+
+    if (reparse) {
+        /* Re-parse the tokentree from itself, to test
+        lexer_load_tokentree. */
+
+        lexer_t _lexer2, *lexer2=&_lexer2;
+        lexer_init(lexer2, store);
+
+        tokentree_t tokentree2;
+        err = lexer_load_tokentree(lexer2, tokentree, filename);
+        if (!err) {
+            err = pool?
+                tokentree_parse_pool(&tokentree2, lexer2, pool):
+                tokentree_parse_arena(&tokentree2, lexer2, arena);
+        }
+        lexer_cleanup(lexer2);
+        if (err) {
+            if (!arena && !pool) tokentree_cleanup(tokentree);
+            return err;
+        }
+
+        /* The reparsed tokentree should have been found in the pool */
+        if (pool && !tokentree_shallow_equal(tokentree, &tokentree2)) {
+            fprintf(stderr, "%s: Reparsed tokentree doesn't match\n",
+                filename);
+            return 2;
+        }
+
+        /* Replace the original tokentree (which was parsed from the
+        text buffer) with the new one (which was parsed from the old
+        one) */
+        if (!arena && !pool) tokentree_cleanup(tokentree);
+        *tokentree = tokentree2;
+    }
+
+    return 0;
+}
+
+static int parse_flat_tokentree(tokentree_flat_t *flat_tokentrees,
+    lexer_t *lexer, const char *filename, stringstore_t *store
 ) {
+    /* Like parse_tokentree, but appends the tokentree to flat_tokentrees */
+    int err;
+
+    size_t start = flat_tokentrees->nodes.len;
+    err = tokentree_flat_parse(flat_tokentrees, lexer);
+    if (err) return err;
+
+    if (reparse) {
+        /* Re-parse the new nodes from themselves, to test
+        lexer_load_tokentree_flat. */
+        size_t n_nodes = flat_tokentrees->nodes.len - start;
+        tokentree_flat_t new_nodes = *flat_tokentrees;
+        new_nodes.nodes.elems += start;
+        new_nodes.nodes.len = n_nodes;
+        new_nodes.nodes.size = n_nodes;
+
+        lexer_t _lexer2, *lexer2=&_lexer2;
+        lexer_init(lexer2, store);
+
+        tokentree_flat_t flat2;
+        tokentree_flat_init(&flat2, store);
+        err = lexer_load_tokentree_flat(lexer2, &new_nodes, filename);
+        if (!err) err = tokentree_flat_parse(&flat2, lexer2);
+        if (!err && (!lexer_done(lexer2) || flat2.nodes.len != n_nodes)) {
+            fprintf(stderr, "%s: Reparsed tokentree doesn't match\n",
+                filename);
+            err = 2;
+        }
+        lexer_cleanup(lexer2);
+        if (err) {
+            tokentree_flat_cleanup(&flat2);
+            return err;
+        }
+
+        /* Replace the new nodes (which were parsed from the text buffer)
+        with the reparsed ones */
+        memcpy(new_nodes.nodes.elems, flat2.nodes.elems,
+            n_nodes * sizeof(*flat2.nodes.elems));
+        tokentree_flat_cleanup(&flat2);
+    }
+
+    return 0;
+}
+
+static int write_tokentree(tokentree_t *tokentree, writer_t *writer) {
+    int err;
+    writer_reset(writer);
+    err = tokentree_write(tokentree, writer);
+    if (err) return err;
+    fputc('\n', stdout);
+    return 0;
+}
+
+static int load_text(file_text_t *file_text, const char **filename_ptr) {
+    if (!strcmp(*filename_ptr, "-")) {
+        *filename_ptr = "<stdin>";
+        return read_stream_text(file_text, stdin, *filename_ptr);
+    } else {
+        return map_file(file_text, *filename_ptr);
+    }
+}
+
+static int load_lexer(lexer_t *lexer, file_text_t *file_text,
+    tokentree_flat_t *file_flat, const char *filename, int n_lex_jobs
+) {
+    /* Loads file_text into lexer. If it's a binary tokentree file, then
+    file_flat is loaded from it (pointing into file_text), and the lexer
+    parses that instead. */
+    int err;
+    const char *text = file_text->text;
+    size_t text_len = file_text->len;
+    if (tokentree_flat_is_file(text, text_len)) {
+        err = tokentree_flat_load(file_flat, text, text_len, filename);
+        if (err) return err;
+        return lexer_load_tokentree_flat(lexer, file_flat, filename);
+    }
+    return tokenize?
+        lexer_load_tokens_parallel(lexer, text, text_len, filename,
+            n_lex_jobs):
+        lexer_load_n(lexer, text, text_len, filename);
+}
+
+
+/* For --stream: the start of each file is read up front, to check whether
+it's a binary tokentree file (which has to be loaded whole) */
+
+typedef struct stream_file {
+    FILE *file;
+    char prefix[sizeof(TOKENTREE_FILE_MAGIC) - 1];
+    size_t prefix_len;
+    size_t prefix_i; /* How much of prefix has been passed to the lexer */
+} stream_file_t;
+
+static int stream_file_open(stream_file_t *stream_file, FILE *file) {
+    stream_file->file = file;
+    stream_file->prefix_i = 0;
+    stream_file->prefix_len = fread(stream_file->prefix, 1,
+        sizeof(stream_file->prefix), file);
+    if (stream_file->prefix_len < sizeof(stream_file->prefix) &&
+        ferror(file)
+    ) {
+        perror("fread");
+        return 1;
+    }
+    return 0;
+}
+
+static bool stream_file_is_binary(stream_file_t *stream_file) {
+    /* Only checks the magic: the rest of the file is checked once it's
+    been loaded whole (see load_lexer) */
+    return stream_file->prefix_len == sizeof(stream_file->prefix) &&
+        !memcmp(stream_file->prefix, TOKENTREE_FILE_MAGIC,
+            sizeof(stream_file->prefix));
+}
+
+static int stream_file_read(void *read_data, char *buf, size_t size,
+    size_t *n_read_ptr
+) {
+    /* A lexer_read_fn_t which reads from read_data, a stream_file_t */
+    stream_file_t *stream_file = read_data;
+    size_t n_read = 0;
+    while (n_read < size && stream_file->prefix_i < stream_file->prefix_len) {
+        buf[n_read++] = stream_file->prefix[stream_file->prefix_i++];
+    }
+    if (n_read < size) {
+        size_t n_file_read;
+        int err = lexer_read_file(stream_file->file, buf + n_read,
+            size - n_read, &n_file_read);
+        if (err) return err;
+        n_read += n_file_read;
+    }
+    *n_read_ptr = n_read;
+    return 0;
+}
+
+static int stream_file_load_text(stream_file_t *stream_file,
+    file_text_t *file_text, const char *filename
+) {
+    /* Reads the whole of stream_file (including its prefix) into
+    file_text */
+    file_text_t rest;
+    int err = read_stream_text(&rest, stream_file->file, filename);
+    if (err) return err;
+
+    size_t prefix_len = stream_file->prefix_len;
+    size_t len = prefix_len + rest.len;
+    char *text = malloc(len + 1);
+    if (!text) {
+        file_text_cleanup(&rest);
+        return 1;
+    }
+    memcpy(text, stream_file->prefix, prefix_len);
+    memcpy(text + prefix_len, rest.text, rest.len);
+    text[len] = '\0';
+    file_text_cleanup(&rest);
+
+    memset(file_text, 0, sizeof(*file_text));
+    file_text->text = text;
+    file_text->len = len;
+    return 0;
+}
+
+static int parse_text(file_text_t *file_text, stream_file_t *file,
+    const char *filename, stringstore_t *store
+) {
+    /* Parses file_text, or (if file is non-NULL) the text streamed from
+    file, writing out each tokentree as soon as it's parsed */
     int err;
 
     lexer_t _lexer, *lexer=&_lexer;
     lexer_init(lexer, store);
 
+    arena_t arena;
+    arena_init(&arena);
+    if (arena_strs) lexer->str_arena = &arena;
+
+    /* For --arena-trees: each tokentree is written out as soon as it's
+    parsed, so we can free it straight away */
+    arena_t tree_arena;
+    arena_init(&tree_arena);
+
+    /* For --dedup: subtrees are shared across the whole file, so its
+    tokentrees are only freed once they've all been written out */
+    tokentree_pool_t pool;
+    tokentree_pool_init(&pool);
+
     writer_t _writer, *writer=&_writer;
     writer_init(writer, stdout);
     writer->oneline = output_oneline;
 
-    err = lexer_load(lexer, buffer, filename);
+    tokentree_flat_t flat_tokentrees;
+    tokentree_flat_init(&flat_tokentrees, store);
+
+    tokentree_flat_t file_flat;
+    err = file?
+        lexer_load_stream(lexer, &stream_file_read, file, filename):
+        load_lexer(lexer, file_text, &file_flat, filename, lex_jobs);
+    if (err) goto done;
+
+    while (flat && !lexer_done(lexer)) {
+        /* Each tokentree is written out as soon as it's parsed, so the
+        flat tokentrees only ever hold one at a time */
+        flat_tokentrees.nodes.len = 0;
+        err = parse_flat_tokentree(&flat_tokentrees, lexer, filename, store);
+        if (err) goto done;
+
+        writer_reset(writer);
+        err = tokentree_flat_write(&flat_tokentrees, 0, writer);
+        if (err) goto done;
+        fputc('\n', stdout);
+    }
+
+    while (!lexer_done(lexer)) {
+        tokentree_t tokentree;
+        err = parse_tokentree(&tokentree, lexer, filename, store,
+            arena_trees? &tree_arena: NULL, dedup? &pool: NULL);
+        if (err) goto done;
+
+        err = write_tokentree(&tokentree, writer);
+
+        if (arena_trees) arena_cleanup(&tree_arena);
+        else if (!dedup) tokentree_cleanup(&tokentree);
+        if (err) goto done;
+    }
+
+done:
+    tokentree_pool_cleanup(&pool);
+    tokentree_flat_cleanup(&flat_tokentrees);
+    lexer_cleanup(lexer);
+    writer_cleanup(writer);
+    arena_cleanup(&tree_arena);
+    arena_cleanup(&arena);
+    return err;
+}
+
+
+
+/* For --jobs: each file is parsed by a worker thread into a "parsed file",
+and then the main thread writes the parsed files out in order */
+
+typedef struct parsed_file {
+    const char *filename;
+    arrayof_inplace_tokentree_t tokentrees;
+    tokentree_flat_t flat_tokentrees; /* For --flat */
+    arena_t arena; /* For --arena-strs and --arena-trees */
+    tokentree_pool_t pool; /* For --dedup */
+    int err;
+} parsed_file_t;
+
+typedef struct parse_worker {
+    pthread_t thread;
+    int i; /* Index of first file to be parsed by this worker */
+    int n_workers; /* Each worker parses every n_workers'th file */
+    int n_files;
+    parsed_file_t *files;
+    stringstore_t *store;
+} parse_worker_t;
+
+static int parse_file_push(parsed_file_t *file, tokentree_t *tokentree) {
+    ARRAY_PUSH(tokentree_t, file->tokentrees, new_tokentree)
+    *new_tokentree = *tokentree;
+    return 0;
+}
+
+static int parse_file(parsed_file_t *file, stringstore_t *store) {
+    int err;
+
+    /* Whatever has been parsed so far is kept in file (and freed by the
+    caller) even if we fail */
+    file_text_t file_text;
+    err = load_text(&file_text, &file->filename);
     if (err) return err;
 
+    lexer_t _lexer, *lexer=&_lexer;
+    lexer_init(lexer, store);
+    if (arena_strs) lexer->str_arena = &file->arena;
+
+    tokentree_flat_t file_flat;
+    err = load_lexer(lexer, &file_text, &file_flat, file->filename, 1);
+    if (err) goto done;
+
+    while (flat && !lexer_done(lexer)) {
+        err = parse_flat_tokentree(&file->flat_tokentrees, lexer,
+            file->filename, store);
+        if (err) goto done;
+    }
+
     while (!lexer_done(lexer)) {
         tokentree_t tokentree;
-        err = tokentree_parse(&tokentree, lexer);
-        if (err) return err;
+        err = parse_tokentree(&tokentree, lexer, file->filename, store,
+            arena_trees? &file->arena: NULL, dedup? &file->pool: NULL);
+        if (err) goto done;
+        err = parse_file_push(file, &tokentree);
+        if (err) {
+            if (!arena_trees && !dedup) tokentree_cleanup(&tokentree);
+            goto done;
+        }
+    }
 
-        if (reparse) {
-            /* Re-parse the tokentree from itself, to test
-            lexer_load_tokentree. */
+done:
+    lexer_cleanup(lexer);
+    file_text_cleanup(&file_text);
+    return err;
+}
 
-            lexer_t _lexer2, *lexer2=&_lexer2;
-            lexer_init(lexer2, store);
+static void *parse_worker_main(void *arg) {
+    parse_worker_t *worker = arg;
+    for (int i = worker->i; i < worker->n_files; i += worker->n_workers) {
+        parsed_file_t *file = &worker->files[i];
+        file->err = parse_file(file, worker->store);
+        if (file->err) break;
+    }
+    return NULL;
+}
 
-            err = lexer_load_tokentree(lexer2, &tokentree, filename);
-            if (err) return err;
+static int parse_files_parallel(int n_files, char **filenames) {
+    int err = 0;
 
-            tokentree_t tokentree2;
-            err = tokentree_parse(&tokentree2, lexer2);
-            if (err) return err;
+    stringstore_t store;
+    err = stringstore_init_concurrent(&store, jobs * 4);
+    if (err) return err;
 
-            lexer_cleanup(lexer2);
+    int n_workers = jobs < n_files? jobs: n_files;
+    parsed_file_t *files = calloc(n_files, sizeof(*files));
+    parse_worker_t *workers = calloc(n_workers, sizeof(*workers));
+    if (!files || !workers) {
+        err = 1;
+        goto done;
+    }
+    for (int i = 0; i < n_files; i++) {
+        files[i].filename = filenames[i];
+        tokentree_flat_init(&files[i].flat_tokentrees, &store);
+        arena_init(&files[i].arena);
+        tokentree_pool_init(&files[i].pool);
+    }
 
-            /* Replace the original tokentree (which was parsed from the
-            text buffer) with the new one (which was parsed from the old
-            one) */
-            tokentree_cleanup(&tokentree);
-            tokentree = tokentree2;
+    /* If a thread can't be created, we still have to wait for the ones
+    which were, since they're using store and files */
+    int n_started = 0;
+    for (; n_started < n_workers; n_started++) {
+        parse_worker_t *worker = &workers[n_started];
+        worker->i = n_started;
+        worker->n_workers = n_workers;
+        worker->n_files = n_files;
+        worker->files = files;
+        worker->store = &store;
+        if (pthread_create(&worker->thread, NULL, &parse_worker_main,
+            worker)
+        ) {
+            fprintf(stderr, "Could not create worker thread\n");
+            err = 1;
+            break;
         }
+    }
+    for (int i = 0; i < n_started; i++) {
+        pthread_join(workers[i].thread, NULL);
+    }
+    if (err) goto done;
 
-        writer_reset(writer);
-        err = tokentree_write(&tokentree, writer);
-        if (err) return err;
-        fputc('\n', stdout);
+    writer_t _writer, *writer=&_writer;
+    writer_init(writer, stdout);
+    writer->oneline = output_oneline;
 
-        tokentree_cleanup(&tokentree);
+    for (int i = 0; !err && i < n_files; i++) {
+        parsed_file_t *file = &files[i];
+        ARRAY_FOR(tokentree_t, file->tokentrees, tokentree) {
+            if (!err) err = write_tokentree(tokentree, writer);
+        }
+        tokentree_flat_t *flat_tokentrees = &file->flat_tokentrees;
+        for (size_t j = 0; !err && j < flat_tokentrees->nodes.len;
+            j += tokentree_flat_span(flat_tokentrees, j)
+        ) {
+            writer_reset(writer);
+            err = tokentree_flat_write(flat_tokentrees, j, writer);
+            if (!err) fputc('\n', stdout);
+        }
+        if (!err) err = file->err;
     }
 
-    lexer_cleanup(lexer);
     writer_cleanup(writer);
+
+done:
+    for (int i = 0; files && i < n_files; i++) {
+        parsed_file_t *file = &files[i];
+        tokentree_flat_cleanup(&file->flat_tokentrees);
+        if (arena_trees || dedup) free(file->tokentrees.elems);
+        else ARRAY_FREE(file->tokentrees, tokentree_cleanup)
+        arena_cleanup(&file->arena);
+        tokentree_pool_cleanup(&file->pool);
+    }
+    free(workers);
+    free(files);
+    stringstore_cleanup(&store);
+    return err;
+}
+
+
+/* For --check-relex */
+
+static size_t relex_random(uint64_t *state, size_t n) {
+    /* Returns a pseudo-random number in 0..n-1 (xorshift64, so that the
+    edits made are the same on every platform) */
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return n? x % n: 0;
+}
+
+static bool relex_token_eq(const lexer_token_t *a, const lexer_token_t *b) {
+    return a->offset == b->offset && a->len == b->len &&
+        a->type == b->type && a->keyword_id == b->keyword_id;
+}
+
+static void relex_pick_edit(const char *text, size_t text_len,
+    arrayof_inplace_lexer_token_t *tokens, uint64_t *state,
+    lexer_edit_t *edit, const char **insert_ptr
+) {
+    /* Picks an edit which keeps text lexable: deleting a top-level line,
+    copying one elsewhere, replacing a token with another of the same
+    type, or adding a space after a token.
+    The inserted text is *insert_ptr[0 : edit->new_end - edit->start]. */
+    size_t i = relex_random(state, tokens->len);
+    const lexer_token_t *token = &tokens->elems[i];
+    int kind = relex_random(state, 4);
+
+    if (kind < 2) {
+        /* Top-level lines: those starting with a token in column 0 */
+        size_t line_start = token->offset;
+        while (line_start > 0 && (text[line_start - 1] != '\n' ||
+            text[line_start] == ' ' || text[line_start] == '\n'
+        )) line_start--;
+        size_t line_end = token->offset + token->len;
+        while (line_end < text_len && (text[line_end - 1] != '\n' ||
+            text[line_end] == ' ' || text[line_end] == '\n'
+        )) line_end++;
+
+        if (kind == 0) {
+            edit->start = line_start;
+            edit->old_end = line_end;
+            edit->new_end = line_start;
+        } else {
+            size_t at = relex_random(state, 2)? line_start: line_end;
+            if (at == text_len && at > 0 && text[at - 1] != '\n') {
+                /* Can't start a line here */
+                at = line_start;
+            }
+            edit->start = at;
+            edit->old_end = at;
+            edit->new_end = at + line_end - line_start;
+            *insert_ptr = text + line_start;
+        }
+    } else if (kind == 2 && (token->type == LEXER_TOKEN_NAME ||
+        token->type == LEXER_TOKEN_INT || token->type == LEXER_TOKEN_OP)
+    ) {
+        const lexer_token_t *other = &tokens->elems[
+            relex_random(state, tokens->len)];
+        if (other->type != token->type) other = token;
+        edit->start = token->offset;
+        edit->old_end = token->offset + token->len;
+        edit->new_end = token->offset + other->len;
+        *insert_ptr = text + other->offset;
+    } else {
+        size_t at = token->offset + token->len;
+        edit->start = at;
+        edit->old_end = at;
+        edit->new_end = at + 1;
+        *insert_ptr = " ";
+    }
+}
+
+static int check_relex_tokens(lexer_t *lexer, lexer_t *full,
+    const char *filename, int edit_i
+) {
+    /* Checks that lexer (re-lexed by lexer_relex) has the same tokens as
+    full (lexed from scratch), and that lexer_peek_token sees them too */
+    arrayof_inplace_lexer_token_t *tokens = &lexer->tokens;
+    arrayof_inplace_lexer_token_t *full_tokens = &full->tokens;
+    bool ok = tokens->len == full_tokens->len;
+    for (size_t i = 0; ok && i < tokens->len; i++) {
+        ok = relex_token_eq(&tokens->elems[i], &full_tokens->elems[i]);
+    }
+    for (size_t i = 0; ok; i++) {
+        for (size_t n = 0; ok && n < 3; n++) {
+            size_t j = i + n < tokens->len? i + n: tokens->len - 1;
+            const lexer_token_t *peeked = lexer_peek_token(lexer, n);
+            ok = peeked && relex_token_eq(peeked, &full_tokens->elems[j]);
+        }
+        if (!ok || lexer_done(lexer)) break;
+        int err = lexer_next(lexer);
+        if (err) return err;
+    }
+    if (!ok) {
+        fprintf(stderr, "%s: After edit %i, re-lexed tokens don't match\n",
+            filename, edit_i);
+        return 2;
+    }
     return 0;
 }
 
+static int check_relex(file_text_t *file_text, const char *filename,
+    stringstore_t *store
+) {
+    /* For --check-relex: makes relex_edits edits to file_text, re-lexing
+    after each one */
+    int err;
 
-int main(int n_args, char **args) {
+    size_t text_len = file_text->len;
+    if (tokentree_flat_is_file(file_text->text, text_len)) {
+        fprintf(stderr, "%s: Can't check re-lexing of a binary tokentree "
+            "file\n", filename);
+        return 2;
+    }
+
+    char *text = malloc(text_len + 1);
+    if (!text) return 1;
+    memcpy(text, file_text->text, text_len);
+    text[text_len] = '\0';
+
+    lexer_t _lexer, *lexer=&_lexer;
+    lexer_init(lexer, store);
+    err = lexer_load_tokens_n(lexer, text, text_len, filename);
+    if (err) goto done;
+
+    uint64_t state = 0x9e3779b97f4a7c15u;
+    for (int edit_i = 0; edit_i < relex_edits; edit_i++) {
+        lexer_edit_t edit = {0};
+        const char *insert = NULL;
+        relex_pick_edit(text, text_len, &lexer->tokens, &state, &edit,
+            &insert);
+
+        size_t insert_len = edit.new_end - edit.start;
+        size_t new_len = text_len - (edit.old_end - edit.start) + insert_len;
+        char *new_text = malloc(new_len + 1);
+        if (!new_text) {
+            err = 1;
+            goto done;
+        }
+        memcpy(new_text, text, edit.start);
+        if (insert_len) memcpy(new_text + edit.start, insert, insert_len);
+        memcpy(new_text + edit.new_end, text + edit.old_end,
+            text_len - edit.old_end);
+        new_text[new_len] = '\0';
+
+        /* NOTE: even if lexer_relex fails, lexer may point into new_text,
+        so it replaces text either way */
+        err = lexer_relex(lexer, new_text, new_len, &edit);
+        free(text);
+        text = new_text;
+        text_len = new_len;
+        if (err) goto done;
+
+        lexer_t _full, *full=&_full;
+        lexer_init(full, store);
+        err = lexer_load_tokens_n(full, text, text_len, filename);
+        if (!err) err = check_relex_tokens(lexer, full, filename, edit_i);
+        lexer_cleanup(full);
+        if (err) goto done;
+    }
+
+done:
+    lexer_cleanup(lexer);
+    free(text);
+    return err;
+}
+
+
+static int convert_file(tokentree_flat_t *flat_tokentrees,
+    const char *filename, stringstore_t *store
+) {
+    /* Parses filename, appending its tokentrees to flat_tokentrees */
     int err;
 
+    file_text_t file_text;
+    err = load_text(&file_text, &filename);
+    if (err) return err;
+
+    lexer_t _lexer, *lexer=&_lexer;
+    lexer_init(lexer, store);
+
+    tokentree_flat_t file_flat;
+    err = load_lexer(lexer, &file_text, &file_flat, filename, lex_jobs);
+
+    while (!err && !lexer_done(lexer)) {
+        err = parse_flat_tokentree(flat_tokentrees, lexer, filename, store);
+    }
+
+    lexer_cleanup(lexer);
+    file_text_cleanup(&file_text);
+    return err;
+}
+
+static int convert_files(int n_files, char **filenames) {
+    /* For --binary: parses all of the files into one set of flat
+    tokentrees, and saves them to binary_filename */
+    int err = 0;
+
+    stringstore_t store;
+    stringstore_init(&store);
+
+    tokentree_flat_t flat_tokentrees;
+    tokentree_flat_init(&flat_tokentrees, &store);
+
+    for (int i = 0; i < n_files; i++) {
+        err = convert_file(&flat_tokentrees, filenames[i], &store);
+        if (err) goto done;
+    }
+
+    FILE *file = stdout;
+    if (strcmp(binary_filename, "-")) {
+        file = fopen(binary_filename, "wb");
+        if (!file) {
+            perror("fopen");
+            fprintf(stderr, "Could not open file for writing: %s\n",
+                binary_filename);
+            err = 1;
+            goto done;
+        }
+    }
+    err = tokentree_flat_save(&flat_tokentrees, file);
+    if (file != stdout && fclose(file)) err = 1;
+    if (err) {
+        fprintf(stderr, "Could not write tokentree file: %s\n",
+            binary_filename);
+    }
+
+done:
+    tokentree_flat_cleanup(&flat_tokentrees);
+    stringstore_cleanup(&store);
+    return err;
+}
+
+
+int main(int n_args, char **args) {
+    int err = 0;
+
     int arg_i = 1;
     for (; arg_i < n_args; arg_i++) {
         char *arg = args[arg_i];
@@ -100,6 +772,50 @@ int main(int n_args, char **args) {
             output_oneline = true;
         } else if (!strcmp(arg, "-r") || !strcmp(arg, "--reparse")) {
             reparse = true;
+        } else if (!strcmp(arg, "-t") || !strcmp(arg, "--tokenize")) {
+            tokenize = true;
+        } else if (!strcmp(arg, "-a") || !strcmp(arg, "--arena-strs")) {
+            arena_strs = true;
+        } else if (!strcmp(arg, "-A") || !strcmp(arg, "--arena-trees")) {
+            arena_trees = true;
+        } else if (!strcmp(arg, "-D") || !strcmp(arg, "--dedup")) {
+            dedup = true;
+        } else if (!strcmp(arg, "-F") || !strcmp(arg, "--flat")) {
+            flat = true;
+        } else if (!strcmp(arg, "-b") || !strcmp(arg, "--binary")) {
+            arg_i++;
+            if (arg_i >= n_args) {
+                fprintf(stderr, "Missing value for %s\n", arg);
+                return 2;
+            }
+            binary_filename = args[arg_i];
+        } else if (!strcmp(arg, "-E") || !strcmp(arg, "--check-relex")) {
+            arg_i++;
+            if (arg_i >= n_args) {
+                fprintf(stderr, "Missing value for %s\n", arg);
+                return 2;
+            }
+            relex_edits = atoi(args[arg_i]);
+            if (relex_edits < 1) relex_edits = 1;
+        } else if (!strcmp(arg, "-S") || !strcmp(arg, "--stream")) {
+            stream = true;
+        } else if (!strcmp(arg, "-j") || !strcmp(arg, "--jobs")) {
+            arg_i++;
+            if (arg_i >= n_args) {
+                fprintf(stderr, "Missing value for %s\n", arg);
+                return 2;
+            }
+            jobs = atoi(args[arg_i]);
+            if (jobs < 1) jobs = 1;
+        } else if (!strcmp(arg, "-J") || !strcmp(arg, "--lex-jobs")) {
+            arg_i++;
+            if (arg_i >= n_args) {
+                fprintf(stderr, "Missing value for %s\n", arg);
+                return 2;
+            }
+            lex_jobs = atoi(args[arg_i]);
+            if (lex_jobs < 1) lex_jobs = 1;
+            tokenize = true;
         } else if (!strcmp(arg, "--")) {
             arg_i++;
             break;
@@ -108,27 +824,62 @@ int main(int n_args, char **args) {
         }
     }
 
+    if (binary_filename) return convert_files(n_args - arg_i, args + arg_i);
+    if (jobs > 1) return parse_files_parallel(n_args - arg_i, args + arg_i);
+
     stringstore_t store;
     stringstore_init(&store);
 
     for (; arg_i < n_args; arg_i++) {
-        char *filename = args[arg_i];
-        char *buffer;
-        if (!strcmp(filename, "-")) {
-            filename = "<stdin>";
-            buffer = read_stream(stdin, filename);
-            if (!buffer) return 1;
-        } else {
-            buffer = load_file(filename);
-            if (!buffer) return 1;
+        const char *filename = args[arg_i];
+
+        if (stream && !tokenize && !relex_edits) {
+            FILE *file = stdin;
+            if (!strcmp(filename, "-")) {
+                filename = "<stdin>";
+            } else {
+                file = fopen(filename, "r");
+                if (!file) {
+                    perror("fopen");
+                    fprintf(stderr, "Could not open file: %s\n", filename);
+                    err = 1;
+                    break;
+                }
+            }
+
+            /* Binary tokentree files can't be streamed, so they're loaded
+            whole instead */
+            stream_file_t stream_file;
+            err = stream_file_open(&stream_file, file);
+            if (!err) {
+                if (stream_file_is_binary(&stream_file)) {
+                    file_text_t file_text;
+                    err = stream_file_load_text(&stream_file, &file_text,
+                        filename);
+                    if (!err) {
+                        err = parse_text(&file_text, NULL, filename, &store);
+                        file_text_cleanup(&file_text);
+                    }
+                } else {
+                    err = parse_text(NULL, &stream_file, filename, &store);
+                }
+            }
+            if (file != stdin) fclose(file);
+            if (err) break;
+            continue;
         }
 
-        err = parse_buffer(buffer, filename, &store);
-        if (err) return err;
+        file_text_t file_text;
+        err = load_text(&file_text, &filename);
+        if (err) break;
 
-        free(buffer);
+        err = relex_edits?
+            check_relex(&file_text, filename, &store):
+            parse_text(&file_text, NULL, filename, &store);
+        file_text_cleanup(&file_text);
+        if (err) break;
     }
 
     stringstore_cleanup(&store);
-    return 0;
+    return err;
 }
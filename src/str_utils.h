@@ -81,28 +81,56 @@ static char *_strjoin4(const char *s1, const char *s2, const char *s3,
 }
 
 
+/* The _const_* functions return strings owned by the given stringstore.
+They don't allocate anything on the heap unless the resulting string is
+new to the stringstore. */
+
+static const char *_const_strupper(stringstore_t *stringstore,
+    const char *s
+) {
+    const char *parts[] = {s};
+    return stringstore_get_join(stringstore, STRINGSTORE_CASE_UPPER,
+        1, parts);
+}
+
 static const char *_const_strjoin2(stringstore_t *stringstore,
     const char *s1, const char *s2
 ) {
-    char *s = _strjoin2(s1, s2);
-    if (!s) return NULL;
-    return stringstore_get_donate(stringstore, s);
+    const char *parts[] = {s1, s2};
+    return stringstore_get_join(stringstore, STRINGSTORE_CASE_KEEP,
+        2, parts);
 }
 
 static const char *_const_strjoin3(stringstore_t *stringstore,
     const char *s1, const char *s2, const char *s3
 ) {
-    char *s = _strjoin3(s1, s2, s3);
-    if (!s) return NULL;
-    return stringstore_get_donate(stringstore, s);
+    const char *parts[] = {s1, s2, s3};
+    return stringstore_get_join(stringstore, STRINGSTORE_CASE_KEEP,
+        3, parts);
 }
 
 static const char *_const_strjoin4(stringstore_t *stringstore,
     const char *s1, const char *s2, const char *s3, const char *s4
 ) {
-    char *s = _strjoin4(s1, s2, s3, s4);
-    if (!s) return NULL;
-    return stringstore_get_donate(stringstore, s);
+    const char *parts[] = {s1, s2, s3, s4};
+    return stringstore_get_join(stringstore, STRINGSTORE_CASE_KEEP,
+        4, parts);
+}
+
+static const char *_const_strjoin2_upper(stringstore_t *stringstore,
+    const char *s1, const char *s2
+) {
+    const char *parts[] = {s1, s2};
+    return stringstore_get_join(stringstore, STRINGSTORE_CASE_UPPER,
+        2, parts);
+}
+
+static const char *_const_strjoin3_upper(stringstore_t *stringstore,
+    const char *s1, const char *s2, const char *s3
+) {
+    const char *parts[] = {s1, s2, s3};
+    return stringstore_get_join(stringstore, STRINGSTORE_CASE_UPPER,
+        3, parts);
 }
 
 #endif
\ No newline at end of file
@@ -1,77 +1,685 @@
-
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdbool.h>
 #include <string.h>
+#include <ctype.h>
+#include <stdint.h>
 
 #include "array.h"
 #include "stringstore.h"
 
+
+#define INITIAL_INDEX_SIZE ((size_t)64)
+#define SLAB_SIZE ((size_t)(1024 * 64))
+
+/* Each string in a slab is preceded by its entry's id (a uint32_t), so that
+stringstore_id can find it in constant time.
+Allocations are rounded up to ID_SIZE bytes so that ids stay aligned. */
+#define ID_SIZE sizeof(uint32_t)
+
+
+/* A string to be looked up in the store, given as the concatenation of
+n_parts slices, with case mapping (enum stringstore_case) applied to every
+character */
+typedef struct stringstore_key {
+    int n_parts;
+    const char *const *parts;
+    const size_t *part_lens;
+    int strcase; /* enum stringstore_case */
+
+    /* Computed by stringstore_key_init */
+    size_t len;
+    uint32_t hash;
+
+    /* Number of index slots examined while looking up the key so far
+    (for stringstore_stats_t) */
+    size_t n_probes;
+} stringstore_key_t;
+
+
 void stringstore_entry_cleanup(stringstore_entry_t *entry){
-    free(entry->data);
+    /* Nothing to do: entry->data lives in one of the store's slabs */
+}
+
+void stringstore_slab_cleanup(stringstore_slab_t *slab){
+    free(slab->data);
+}
+
+void stringstore_shard_cleanup(stringstore_shard_t *shard){
+    ARRAY_FREE(shard->entries, stringstore_entry_cleanup)
+    ARRAY_FREE(shard->slabs, stringstore_slab_cleanup)
+    free(shard->free_ids.elems);
+    ARRAY_ZERO(shard->free_ids)
+    free(shard->index);
+    shard->index = NULL;
+    shard->index_size = 0;
+}
+
+static stringstore_shard_t *stringstore_get_shard(stringstore_t *store,
+    int i
+){
+    return store->shards? &store->shards[i]: &store->shard;
 }
 
 void stringstore_cleanup(stringstore_t *store){
-    ARRAY_FREE_PTR(store->entries, stringstore_entry_cleanup)
+    stringstore_base_cleanup(&store->base);
+    for(int i = 0; i < store->n_shards; i++){
+        stringstore_shard_t *shard = stringstore_get_shard(store, i);
+        stringstore_shard_cleanup(shard);
+        if(store->concurrent)pthread_mutex_destroy(&shard->lock);
+    }
+    free(store->shards);
+    store->shards = NULL;
 }
 
 void stringstore_dump(stringstore_t *store, FILE *f){
-    fprintf(f, "STRING STORE (%p) (%zu ENTRIES):\n", store,
-        store->entries.len);
-    for(int i = 0; i < store->entries.len; i++){
-        stringstore_entry_t *entry = store->entries.elems[i];
-        fprintf(f, "  ENTRY %i: %s\n",
-            i, entry->data);
+    fprintf(f, "STRING STORE (%p) (%i SHARDS):\n", store, store->n_shards);
+    stringstore_base_t *base = &store->base;
+    if(base->map){
+        fprintf(f, " BASE (%u ENTRIES):\n", base->n_entries);
+        for(uint32_t i = 0; i < base->n_entries; i++){
+            fprintf(f, "  ENTRY %u: %s\n",
+                i, base->strings + base->entries[i].offset);
+        }
     }
+    for(int i = 0; i < store->n_shards; i++){
+        stringstore_shard_t *shard = stringstore_get_shard(store, i);
+        fprintf(f, " SHARD %i (%zu ENTRIES) (%zu SLABS):\n", i,
+            shard->entries.len, shard->slabs.len);
+        for(int j = 0; j < shard->entries.len; j++){
+            stringstore_entry_t *entry = &shard->entries.elems[j];
+            if(!entry->data)continue;
+            fprintf(f, "  ENTRY %i: %s\n",
+                stringstore_id(store, entry->data), entry->data);
+        }
+    }
+    stringstore_stats_t stats;
+    stringstore_get_stats(store, &stats);
+    stringstore_stats_dump(&stats, f);
+}
+
+void stringstore_stats_dump(stringstore_stats_t *stats, FILE *f){
+    fprintf(f, " STATS:\n");
+    fprintf(f, "  LOOKUPS: %llu (%llu HITS, %llu MISSES)\n",
+        (unsigned long long)stats->lookups,
+        (unsigned long long)stats->hits,
+        (unsigned long long)stats->misses);
+    fprintf(f, "  PROBES: %llu (AVERAGE %.2f, MAX %llu)\n",
+        (unsigned long long)stats->probes,
+        stats->lookups? (double)stats->probes / stats->lookups: 0.0,
+        (unsigned long long)stats->max_probes);
+    fprintf(f, "  DONATED: %llu (%llu DUPLICATES FREED)\n",
+        (unsigned long long)stats->donated,
+        (unsigned long long)stats->donated_dups);
+    fprintf(f, "  SWEPT: %llu (%llu SLABS FREED)\n",
+        (unsigned long long)stats->swept,
+        (unsigned long long)stats->slabs_freed);
+    fprintf(f, "  STRINGS: %llu (%llu BYTES)\n",
+        (unsigned long long)stats->n_strings,
+        (unsigned long long)stats->string_bytes);
+    fprintf(f, "  SLABS: %llu BYTES (%llu USED)\n",
+        (unsigned long long)stats->slab_bytes,
+        (unsigned long long)stats->slab_bytes_used);
+    fprintf(f, "  INDEX: %llu BYTES\n",
+        (unsigned long long)stats->index_bytes);
+    fprintf(f, "  BASE: %llu BYTES\n",
+        (unsigned long long)stats->base_bytes);
 }
 
 void stringstore_init(stringstore_t *store){
     memset(store, 0, sizeof(*store));
+    store->n_shards = 1;
 }
 
-int stringstore_add(stringstore_t *store, const char *data,
-    stringstore_entry_t **entry_ptr
+int stringstore_init_concurrent(stringstore_t *store, int n_shards){
+    /* Initializes a store which may be used from several threads at once.
+    Its strings are spread over n_shards shards (rounded up to a power of
+    2), each with its own lock. */
+    stringstore_init(store);
+    store->concurrent = true;
+
+    if(n_shards > STRINGSTORE_MAX_SHARDS)n_shards = STRINGSTORE_MAX_SHARDS;
+    while(store->n_shards < n_shards){
+        store->n_shards *= 2;
+        store->shard_bits++;
+    }
+
+    if(store->n_shards > 1){
+        store->shards = calloc(store->n_shards, sizeof(*store->shards));
+        if(!store->shards){
+            stringstore_init(store);
+            return 1;
+        }
+    }
+    for(int i = 0; i < store->n_shards; i++){
+        stringstore_shard_t *shard = stringstore_get_shard(store, i);
+        if(pthread_mutex_init(&shard->lock, NULL)){
+            /* Undo what we've done so far, leaving store empty (and safe
+            to pass to stringstore_cleanup) */
+            while(i-- > 0){
+                pthread_mutex_destroy(&stringstore_get_shard(store, i)->lock);
+            }
+            free(store->shards);
+            stringstore_init(store);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void stringstore_lock(stringstore_t *store, stringstore_shard_t *shard){
+    if(store->concurrent)pthread_mutex_lock(&shard->lock);
+}
+
+static void stringstore_unlock(stringstore_t *store,
+    stringstore_shard_t *shard
 ){
-    ARRAY_PUSH_NEW(stringstore_entry_t*, store->entries, entry)
-    size_t len = strlen(data);
-    char *entry_data = malloc(len + 1);
-    if(!entry_data)return 1;
-    strcpy(entry_data, data);
+    if(store->concurrent)pthread_mutex_unlock(&shard->lock);
+}
+
+#define FNV_OFFSET_BASIS 2166136261u
+#define FNV_PRIME 16777619u
+
+uint32_t stringstore_hash(const char *data, size_t len){
+    /* FNV-1a */
+    uint32_t hash = FNV_OFFSET_BASIS;
+    for(size_t i = 0; i < len; i++){
+        hash ^= (unsigned char)data[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+static char stringstore_case_map(int strcase, char c){
+    switch(strcase){
+        case STRINGSTORE_CASE_UPPER: return toupper((unsigned char)c);
+        case STRINGSTORE_CASE_LOWER: return tolower((unsigned char)c);
+        default: return c;
+    }
+}
+
+static void stringstore_key_init(stringstore_key_t *key){
+    /* Same as stringstore_hash, but over the concatenated (and
+    case-mapped) parts */
+    uint32_t hash = FNV_OFFSET_BASIS;
+    size_t len = 0;
+    for(int i = 0; i < key->n_parts; i++){
+        const char *part = key->parts[i];
+        size_t part_len = key->part_lens[i];
+        for(size_t j = 0; j < part_len; j++){
+            char c = stringstore_case_map(key->strcase, part[j]);
+            hash ^= (unsigned char)c;
+            hash *= FNV_PRIME;
+        }
+        len += part_len;
+    }
+    key->len = len;
+    key->hash = hash;
+}
+
+static bool stringstore_key_eq(stringstore_key_t *key, const char *data){
+    /* Caller guarantees strlen(data) == key->len */
+    for(int i = 0; i < key->n_parts; i++){
+        const char *part = key->parts[i];
+        size_t part_len = key->part_lens[i];
+        if(key->strcase == STRINGSTORE_CASE_KEEP){
+            if(part != data && memcmp(part, data, part_len))return false;
+        }else{
+            for(size_t j = 0; j < part_len; j++){
+                if(stringstore_case_map(key->strcase, part[j]) != data[j]){
+                    return false;
+                }
+            }
+        }
+        data += part_len;
+    }
+    return true;
+}
+
+static void stringstore_key_copy(stringstore_key_t *key, char *data){
+    /* Caller guarantees data has room for key->len + 1 bytes */
+    for(int i = 0; i < key->n_parts; i++){
+        const char *part = key->parts[i];
+        size_t part_len = key->part_lens[i];
+        if(key->strcase == STRINGSTORE_CASE_KEEP){
+            memcpy(data, part, part_len);
+        }else{
+            for(size_t j = 0; j < part_len; j++){
+                data[j] = stringstore_case_map(key->strcase, part[j]);
+            }
+        }
+        data += part_len;
+    }
+    *data = '\0';
+}
+
+static size_t *stringstore_find_slot(stringstore_shard_t *shard,
+    stringstore_key_t *key
+){
+    /* Returns the index slot holding an entry equal to data, or the empty
+    slot where such an entry would be inserted.
+    Caller guarantees shard->index_size > 0 (so there is always at least
+    one empty slot, since we keep the index at most half full). */
+    size_t mask = shard->index_size - 1;
+    size_t i = key->hash & mask;
+    while(1){
+        key->n_probes++;
+        size_t *slot = &shard->index[i];
+        if(!*slot)return slot;
+        stringstore_entry_t *entry = &shard->entries.elems[*slot - 1];
+        if(entry->hash == key->hash && entry->len == key->len &&
+            stringstore_key_eq(key, entry->data)
+        ){
+            return slot;
+        }
+        i = (i + 1) & mask;
+    }
+}
+
+static void stringstore_rehash(stringstore_shard_t *shard,
+    size_t *index, size_t index_size
+){
+    /* Fills in index (which caller has zeroed) with the shard's entries,
+    using the hashes stored on them */
+    size_t mask = index_size - 1;
+    for(size_t j = 0; j < shard->entries.len; j++){
+        stringstore_entry_t *entry = &shard->entries.elems[j];
+        if(!entry->data)continue;
+        size_t i = entry->hash & mask;
+        while(index[i])i = (i + 1) & mask;
+        index[i] = j + 1;
+    }
+}
+
+static int stringstore_grow_index(stringstore_shard_t *shard){
+    size_t new_size = shard->index_size?
+        shard->index_size * 2: INITIAL_INDEX_SIZE;
+    size_t *new_index = calloc(new_size, sizeof(*new_index));
+    if(!new_index)return 1;
+
+    stringstore_rehash(shard, new_index, new_size);
+
+    free(shard->index);
+    shard->index = new_index;
+    shard->index_size = new_size;
+    return 0;
+}
+
+static int stringstore_alloc(stringstore_shard_t *shard, size_t size,
+    char **data_ptr
+){
+    /* Gets size bytes of space from the current slab, starting a new
+    slab if necessary */
+
+    if(shard->slabs.len){
+        stringstore_slab_t *slab = &shard->slabs.elems[shard->slabs.len - 1];
+        if(slab->size - slab->len >= size){
+            *data_ptr = slab->data + slab->len;
+            slab->len += size;
+            return 0;
+        }
+    }
+
+    if(shard->slabs.len >= shard->slabs.size){
+        ARRAY_GROW(stringstore_slab_t, shard->slabs)
+    }
+
+    size_t slab_size = size > SLAB_SIZE? size: SLAB_SIZE;
+    char *slab_data = malloc(slab_size);
+    if(!slab_data)return 1;
+
+    ARRAY_PUSH(stringstore_slab_t, shard->slabs, slab)
+    slab->data = slab_data;
+    slab->size = slab_size;
+    slab->len = size;
+
+    if(slab_size == size && shard->slabs.len > 1){
+        /* An oversized string gets a slab to itself; keep the slab we were
+        filling as the last one, so its remaining space isn't wasted */
+        stringstore_slab_t *prev_slab = &shard->slabs.elems[
+            shard->slabs.len - 2];
+        stringstore_slab_t tmp = *prev_slab;
+        *prev_slab = *slab;
+        *slab = tmp;
+    }
+
+    *data_ptr = slab_data;
+    return 0;
+}
+
+static int stringstore_add_entry(stringstore_t *store,
+    stringstore_shard_t *shard, int shard_i,
+    stringstore_key_t *key, stringstore_entry_t **entry_ptr
+){
+    /* Copies key's string into the shard as a new entry */
+
+    /* Keep the index at most half full */
+    size_t n_live = shard->entries.len - shard->free_ids.len;
+    if((n_live + 1) * 2 > shard->index_size){
+        if(stringstore_grow_index(shard))return 1;
+    }
+
+    /* Reuse the local id of a string dropped by stringstore_sweep, if
+    there is one */
+    bool reuse_id = shard->free_ids.len > 0;
+    size_t local_id = reuse_id?
+        shard->free_ids.elems[shard->free_ids.len - 1]:
+        shard->entries.len;
+    /* Ids must fit in a uint32_t (without being STRINGSTORE_ID_NONE) */
+    if(local_id >= (UINT32_MAX - store->base.n_entries) >> store->shard_bits){
+        fprintf(stderr, "%s: Out of string ids\n", __func__);
+        return 2;
+    }
+    uint32_t id = store->base.n_entries +
+        ((local_id << store->shard_bits) | shard_i);
+    size_t size = ID_SIZE + key->len + 1;
+    size = (size + ID_SIZE - 1) / ID_SIZE * ID_SIZE;
+
+    char *entry_data;
+    if(stringstore_alloc(shard, size, &entry_data))return 1;
+    memcpy(entry_data, &id, ID_SIZE);
+    entry_data += ID_SIZE;
+    stringstore_key_copy(key, entry_data);
+
+    size_t *slot = stringstore_find_slot(shard, key);
+
+    stringstore_entry_t *entry;
+    if(reuse_id){
+        shard->free_ids.len--;
+        entry = &shard->entries.elems[local_id];
+    }else{
+        ARRAY_PUSH(stringstore_entry_t, shard->entries, new_entry)
+        entry = new_entry;
+    }
     entry->data = entry_data;
+    entry->len = key->len;
+    entry->hash = key->hash;
+    entry->marked = false;
+    *slot = local_id + 1;
+
     *entry_ptr = entry;
     return 0;
 }
 
+static stringstore_entry_t *stringstore_lookup(stringstore_shard_t *shard,
+    stringstore_key_t *key
+){
+    if(!shard->index_size)return NULL;
+    size_t *slot = stringstore_find_slot(shard, key);
+    if(!*slot)return NULL;
+    return &shard->entries.elems[*slot - 1];
+}
+
+static const char *stringstore_base_lookup(stringstore_base_t *base,
+    stringstore_key_t *key
+){
+    /* The base is read-only, so no locking is required */
+    if(!base->index_size)return NULL;
+    uint32_t mask = base->index_size - 1;
+    uint32_t i = key->hash & mask;
+    while(1){
+        key->n_probes++;
+        uint32_t slot = base->index[i];
+        if(!slot)return NULL;
+        const stringstore_snapshot_entry_t *entry = &base->entries[slot - 1];
+        const char *data = base->strings + entry->offset;
+        if(entry->hash == key->hash && entry->len == key->len &&
+            stringstore_key_eq(key, data)
+        ){
+            return data;
+        }
+        i = (i + 1) & mask;
+    }
+}
+
+static int stringstore_hash_shard(stringstore_t *store, uint32_t hash){
+    /* Shards are chosen using the hash's top bits, since its bottom bits
+    are used by the shard's index */
+    if(!store->shard_bits)return 0;
+    return hash >> (32 - store->shard_bits);
+}
+
+static int stringstore_key_shard(stringstore_t *store,
+    stringstore_key_t *key
+){
+    return stringstore_hash_shard(store, key->hash);
+}
+
+static const char *stringstore_find_key(stringstore_t *store,
+    stringstore_shard_t *shard, stringstore_key_t *key
+){
+    /* Looks key up in the base, and then in shard (which caller has
+    locked), counting the lookup in shard's stats */
+    const char *data = stringstore_base_lookup(&store->base, key);
+    if(data){
+        /* Caller may hold on to data, so if it was dropped by the last
+        stringstore_sweep, it's live again */
+        store->base.dropped[stringstore_id(store, data)] = false;
+    }else{
+        stringstore_entry_t *entry = stringstore_lookup(shard, key);
+        if(entry)data = entry->data;
+    }
+
+    stringstore_stats_t *stats = &shard->stats;
+    stats->lookups++;
+    if(data)stats->hits++;
+    else stats->misses++;
+    stats->probes += key->n_probes;
+    if(key->n_probes > stats->max_probes)stats->max_probes = key->n_probes;
+    return data;
+}
+
+static const char *stringstore_get_key(stringstore_t *store,
+    stringstore_key_t *key, bool donated
+){
+    /* If donated, then caller is going to free the string it looked up
+    (see stringstore_get_donate), which we count in the shard's stats */
+    stringstore_key_init(key);
+    int shard_i = stringstore_key_shard(store, key);
+    stringstore_shard_t *shard = stringstore_get_shard(store, shard_i);
+
+    /* NOTE: we lock the shard even if the string turns out to be in the
+    base, since the lookup is counted in the shard's stats */
+    stringstore_lock(store, shard);
+    const char *data = stringstore_find_key(store, shard, key);
+    if(donated){
+        shard->stats.donated++;
+        if(data)shard->stats.donated_dups++;
+    }
+    if(!data){
+        stringstore_entry_t *entry;
+        int err = stringstore_add_entry(store, shard, shard_i,
+            key, &entry);
+        if(!err)data = entry->data;
+    }
+    stringstore_unlock(store, shard);
+    return data;
+}
+
+int stringstore_add(stringstore_t *store, const char *data,
+    stringstore_entry_t **entry_ptr
+){
+    /* NOTE: the returned entry is only valid until the next string is
+    added to the store (so this shouldn't be used with concurrent stores) */
+    size_t len = strlen(data);
+    stringstore_key_t key = {
+        .n_parts = 1,
+        .parts = &data,
+        .part_lens = &len,
+    };
+    stringstore_key_init(&key);
+    int shard_i = stringstore_key_shard(store, &key);
+    stringstore_shard_t *shard = stringstore_get_shard(store, shard_i);
+
+    stringstore_lock(store, shard);
+    int err = stringstore_add_entry(store, shard, shard_i,
+        &key, entry_ptr);
+    stringstore_unlock(store, shard);
+    return err;
+}
+
 int stringstore_add_donate(stringstore_t *store, char *data,
     stringstore_entry_t **entry_ptr
 ){
-    /* Caller "donates" (passes ownership of) data to store */
-    ARRAY_PUSH_NEW(stringstore_entry_t*, store->entries, entry)
-    entry->data = data;
-    *entry_ptr = entry;
+    /* Caller "donates" (passes ownership of) data to store...
+    which copies it into a slab, and frees it. */
+    int err = stringstore_add(store, data, entry_ptr);
+    if(err)return err;
+    free(data);
     return 0;
 }
 
 const char *stringstore_find(stringstore_t *store, const char *data){
     if(!data)return NULL;
-    for(int i = 0; i < store->entries.len; i++){
-        stringstore_entry_t *entry = store->entries.elems[i];
-        if(entry->data == data || !strcmp(entry->data, data)){
-            return entry->data;
-        }
-    }
-    return NULL;
+    size_t len = strlen(data);
+    stringstore_key_t key = {
+        .n_parts = 1,
+        .parts = &data,
+        .part_lens = &len,
+    };
+    stringstore_key_init(&key);
+    stringstore_shard_t *shard = stringstore_get_shard(store,
+        stringstore_key_shard(store, &key));
+
+    stringstore_lock(store, shard);
+    const char *found_data = stringstore_find_key(store, shard, &key);
+    stringstore_unlock(store, shard);
+    return found_data;
 }
 
 const char *stringstore_get(stringstore_t *store, const char *data){
     if(!data)return NULL;
+    return stringstore_get_n(store, data, strlen(data));
+}
 
+const char *stringstore_get_n(stringstore_t *store, const char *data,
+    size_t len
+){
+    /* Like stringstore_get, but data is a slice of len bytes, which need
+    not be NUL-terminated. Only copies data if it isn't in the store yet. */
+    stringstore_key_t key = {
+        .n_parts = 1,
+        .parts = &data,
+        .part_lens = &len,
+    };
+    return stringstore_get_key(store, &key, false);
+}
+
+const char *stringstore_get_join(stringstore_t *store, int strcase,
+    int n_parts, const char **parts
+){
+    /* Interns the concatenation of n_parts NUL-terminated strings, with
+    case mapping (enum stringstore_case) applied, without building the
+    joined string on the heap first */
+    size_t part_lens[STRINGSTORE_MAX_JOIN_PARTS];
+    if(n_parts > STRINGSTORE_MAX_JOIN_PARTS){
+        fprintf(stderr, "%s: Too many parts: %i\n", __func__, n_parts);
+        return NULL;
+    }
+    for(int i = 0; i < n_parts; i++){
+        if(!parts[i])return NULL;
+        part_lens[i] = strlen(parts[i]);
+    }
+    stringstore_key_t key = {
+        .n_parts = n_parts,
+        .parts = parts,
+        .part_lens = part_lens,
+        .strcase = strcase,
+    };
+    return stringstore_get_key(store, &key, false);
+}
+
+uint32_t stringstore_id(stringstore_t *store, const char *data){
+    /* Returns the id of data, which MUST be a string returned by one of
+    the stringstore_get* functions for this store: the id is read from just
+    before data, so for any other pointer, the result is garbage (or worse).
+    See stringstore_find_id for arbitrary strings, and stringstore_owns.
+    Ids of strings in the base are just their index in the base.
+    For other strings, the id minus the number of strings in the base is
+    made up of the index of the string's shard (in its bottom shard_bits
+    bits) and the string's local id within that shard. */
+    uint32_t id;
+    memcpy(&id, data - ID_SIZE, ID_SIZE);
+    return id;
+}
+
+uint32_t stringstore_find_id(stringstore_t *store, const char *data){
+    /* Returns the id of a string equal to data, or STRINGSTORE_ID_NONE if
+    there is none in the store */
     const char *found_data = stringstore_find(store, data);
-    if(found_data)return found_data;
+    if(!found_data)return STRINGSTORE_ID_NONE;
+    return stringstore_id(store, found_data);
+}
 
-    stringstore_entry_t *entry;
-    int err = stringstore_add(store, data, &entry);
-    if(err)return NULL;
-    return entry->data;
+const char *stringstore_string(stringstore_t *store, uint32_t id){
+    stringstore_base_t *base = &store->base;
+    if(id < base->n_entries)return base->strings + base->entries[id].offset;
+    id -= base->n_entries;
+
+    int shard_i = id & (store->n_shards - 1);
+    uint32_t local_id = id >> store->shard_bits;
+    stringstore_shard_t *shard = stringstore_get_shard(store, shard_i);
+
+    stringstore_lock(store, shard);
+    const char *data = local_id < shard->entries.len?
+        shard->entries.elems[local_id].data: NULL;
+    stringstore_unlock(store, shard);
+    return data;
+}
+
+static bool stringstore_in_range(const char *data, const char *start,
+    size_t size
+){
+    /* Whether data could be a string in the given range, i.e. whether it
+    lies in the range, after room for its id */
+    uintptr_t addr = (uintptr_t)data;
+    return addr >= (uintptr_t)start + ID_SIZE &&
+        addr < (uintptr_t)start + size;
+}
+
+bool stringstore_owns(stringstore_t *store, const char *data){
+    /* Whether data is one of the store's strings (as opposed to an equal
+    string elsewhere), e.g. for stringstore_mark'ing strings which may not
+    have come from the store.
+    Unlike stringstore_find, this doesn't hash data, or count as a lookup
+    (see stringstore_get_stats): it compares data's address with those of
+    the base and of the slabs, of which there are few, since they're
+    large. */
+    if(!data)return false;
+    stringstore_base_t *base = &store->base;
+    bool in_store = base->map &&
+        stringstore_in_range(data, base->map, base->map_size);
+    for(int i = 0; !in_store && i < store->n_shards; i++){
+        stringstore_shard_t *shard = stringstore_get_shard(store, i);
+        stringstore_lock(store, shard);
+        ARRAY_FOR(stringstore_slab_t, shard->slabs, slab){
+            if(stringstore_in_range(data, slab->data, slab->len)){
+                in_store = true;
+                break;
+            }
+        }
+        stringstore_unlock(store, shard);
+    }
+
+    /* data may still be in the middle of a string, or be a dropped
+    string, so check that its id leads back to it */
+    return in_store &&
+        stringstore_string(store, stringstore_id(store, data)) == data;
+}
+
+uint32_t stringstore_n_ids(stringstore_t *store){
+    /* All ids are less than the value returned by this function.
+    For non-concurrent stores (which have a single shard), ids are dense:
+    every id from 0 up to that value is in use. */
+    uint32_t n_ids = 0;
+    for(int i = 0; i < store->n_shards; i++){
+        stringstore_shard_t *shard = stringstore_get_shard(store, i);
+        stringstore_lock(store, shard);
+        uint32_t shard_n_ids = shard->entries.len << store->shard_bits;
+        if(shard_n_ids > n_ids)n_ids = shard_n_ids;
+        stringstore_unlock(store, shard);
+    }
+    return store->base.n_entries + n_ids;
 }
 
 const char *stringstore_get_donate(stringstore_t *store, char *data){
@@ -79,20 +687,242 @@ const char *stringstore_get_donate(stringstore_t *store, char *data){
     unless there's an error! Then caller still owns data. */
     if(!data)return NULL;
 
-    const char *found_data = stringstore_find(store, data);
-    if(found_data){
+    /* We never keep data itself, since the store packs its strings into
+    slabs. But caller passed us ownership of data, so we must free it. */
+    size_t len = strlen(data);
+    stringstore_key_t key = {
+        .n_parts = 1,
+        .parts = (const char **)&data,
+        .part_lens = &len,
+    };
+    const char *const_data = stringstore_get_key(store, &key, true);
+    if(!const_data)return NULL;
+    free(data);
+    return const_data;
+}
 
-        /* We don't need data, since we already had a copy of this string
-        in the store.
-        But caller passed us ownership of data, so we must free it if we're
-        not going to store it. */
-        free(data);
+void stringstore_get_stats(stringstore_t *store, stringstore_stats_t *stats){
+    /* Sums the counters of all shards, and computes the current sizes of
+    the store's strings and tables */
+    memset(stats, 0, sizeof(*stats));
 
-        return found_data;
+    stringstore_base_t *base = &store->base;
+    for(uint32_t i = 0; i < base->n_entries; i++){
+        if(base->dropped[i])continue;
+        stats->n_strings++;
+        stats->string_bytes += base->entries[i].len + 1;
     }
+    stats->base_bytes = base->map_size;
 
-    stringstore_entry_t *entry;
-    int err = stringstore_add_donate(store, data, &entry);
-    if(err)return NULL;
-    return entry->data;
+    for(int i = 0; i < store->n_shards; i++){
+        stringstore_shard_t *shard = stringstore_get_shard(store, i);
+        stringstore_lock(store, shard);
+        stringstore_stats_t *shard_stats = &shard->stats;
+        stats->lookups += shard_stats->lookups;
+        stats->hits += shard_stats->hits;
+        stats->misses += shard_stats->misses;
+        stats->probes += shard_stats->probes;
+        if(shard_stats->max_probes > stats->max_probes){
+            stats->max_probes = shard_stats->max_probes;
+        }
+        stats->donated += shard_stats->donated;
+        stats->donated_dups += shard_stats->donated_dups;
+        stats->swept += shard_stats->swept;
+        stats->slabs_freed += shard_stats->slabs_freed;
+
+        ARRAY_FOR(stringstore_entry_t, shard->entries, entry){
+            if(!entry->data)continue;
+            stats->n_strings++;
+            stats->string_bytes += entry->len + 1;
+        }
+        ARRAY_FOR(stringstore_slab_t, shard->slabs, slab){
+            stats->slab_bytes += slab->size;
+            stats->slab_bytes_used += slab->len;
+        }
+        stats->index_bytes += shard->index_size * sizeof(*shard->index);
+        stringstore_unlock(store, shard);
+    }
+}
+
+
+/* Reclaiming strings.
+Strings which are no longer used (e.g. the names of fields of a type which
+has since been redefined) can be dropped from the store by "marking" every
+string which is still in use, with stringstore_mark, and then calling
+stringstore_sweep.
+For instance:
+
+    compiler_mark_strings(&compiler);
+    err = tokentree_mark_strings(&tokentree, &store);
+    if(!err)err = stringstore_sweep(&store);
+
+Live strings are never moved, so pointers to them (and their ids) remain
+valid. Slabs are freed once none of their strings are live; ids of dropped
+strings are reused by strings added later.
+Strings in the base (see stringstore_load_base) are never freed, but those
+which are dropped aren't saved by stringstore_save, so a snapshot only
+grows with strings which are still in use. */
+
+void stringstore_mark(stringstore_t *store, const char *data){
+    /* Marks data as live, so that it survives the next stringstore_sweep.
+    data MUST be NULL, or a string returned by one of the stringstore_get*
+    functions for this store (as for stringstore_id). */
+    if(!data)return;
+    stringstore_base_t *base = &store->base;
+    uint32_t id = stringstore_id(store, data);
+    if(id < base->n_entries){
+        stringstore_shard_t *shard = stringstore_get_shard(store,
+            stringstore_hash_shard(store, base->entries[id].hash));
+        stringstore_lock(store, shard);
+        base->marked[id] = true;
+        stringstore_unlock(store, shard);
+        return;
+    }
+    id -= base->n_entries;
+
+    stringstore_shard_t *shard = stringstore_get_shard(store,
+        id & (store->n_shards - 1));
+    stringstore_lock(store, shard);
+    shard->entries.elems[id >> store->shard_bits].marked = true;
+    stringstore_unlock(store, shard);
+}
+
+typedef struct stringstore_slab_ref {
+    const char *data;
+    size_t size;
+    size_t i; /* Index into shard->slabs */
+} stringstore_slab_ref_t;
+
+static int stringstore_slab_ref_cmp(const void *a, const void *b){
+    uintptr_t data_a = (uintptr_t)((const stringstore_slab_ref_t *)a)->data;
+    uintptr_t data_b = (uintptr_t)((const stringstore_slab_ref_t *)b)->data;
+    return data_a < data_b? -1: data_a > data_b? 1: 0;
+}
+
+static size_t stringstore_find_slab(stringstore_slab_ref_t *refs,
+    size_t n_refs, const char *data
+){
+    /* Binary search for the slab containing data, given refs sorted by
+    address */
+    size_t lo = 0, hi = n_refs;
+    while(hi - lo > 1){
+        size_t mid = lo + (hi - lo) / 2;
+        if((uintptr_t)refs[mid].data <= (uintptr_t)data)lo = mid;
+        else hi = mid;
+    }
+    return refs[lo].i;
+}
+
+static int stringstore_sweep_shard(stringstore_shard_t *shard){
+    int err = 0;
+
+    /* We're going to push onto free_ids; make sure that can't fail halfway
+    through */
+    size_t max_free_ids = shard->free_ids.len;
+    ARRAY_FOR(stringstore_entry_t, shard->entries, entry){
+        if(entry->data && !entry->marked)max_free_ids++;
+    }
+    while(shard->free_ids.size < max_free_ids){
+        ARRAY_GROW(uint32_t, shard->free_ids)
+    }
+
+    /* The index shrinks along with the number of strings */
+    size_t n_marked = shard->entries.len - max_free_ids;
+    size_t index_size = 0;
+    if(shard->index_size){
+        index_size = INITIAL_INDEX_SIZE;
+        while(index_size < (n_marked + 1) * 2)index_size *= 2;
+    }
+
+    size_t n_slabs = shard->slabs.len;
+    stringstore_slab_ref_t *refs = calloc(n_slabs, sizeof(*refs));
+    size_t *n_live = calloc(n_slabs, sizeof(*n_live));
+    size_t *index = calloc(index_size, sizeof(*index));
+    if(
+        (n_slabs && (!refs || !n_live)) ||
+        (index_size && !index)
+    ){
+        err = 1;
+        goto done;
+    }
+
+    for(size_t i = 0; i < n_slabs; i++){
+        stringstore_slab_t *slab = &shard->slabs.elems[i];
+        refs[i].data = slab->data;
+        refs[i].size = slab->size;
+        refs[i].i = i;
+    }
+    if(n_slabs)qsort(refs, n_slabs, sizeof(*refs), stringstore_slab_ref_cmp);
+
+    /* Drop unmarked strings, and count each slab's live strings */
+    for(size_t j = 0; j < shard->entries.len; j++){
+        stringstore_entry_t *entry = &shard->entries.elems[j];
+        if(!entry->data)continue;
+        if(entry->marked){
+            entry->marked = false;
+            n_live[stringstore_find_slab(refs, n_slabs, entry->data)]++;
+        }else{
+            entry->data = NULL;
+            shard->free_ids.elems[shard->free_ids.len++] = j;
+            shard->stats.swept++;
+        }
+    }
+
+    /* Free slabs without live strings, keeping the others in order (so the
+    last one is still the one being filled, if it survived) */
+    size_t n_kept = 0;
+    for(size_t i = 0; i < n_slabs; i++){
+        stringstore_slab_t *slab = &shard->slabs.elems[i];
+        if(n_live[i]){
+            shard->slabs.elems[n_kept++] = *slab;
+        }else{
+            stringstore_slab_cleanup(slab);
+            shard->stats.slabs_freed++;
+        }
+    }
+    shard->slabs.len = n_kept;
+
+    /* Rebuild the index without the dropped strings */
+    if(index_size){
+        stringstore_rehash(shard, index, index_size);
+        free(shard->index);
+        shard->index = index;
+        shard->index_size = index_size;
+        index = NULL;
+    }
+
+done:
+    free(refs);
+    free(n_live);
+    free(index);
+    return err;
+}
+
+int stringstore_sweep(stringstore_t *store){
+    /* Drops every string which wasn't marked with stringstore_mark since the
+    last sweep, and unmarks the rest.
+    NOTE: caller must make sure no other thread is using the store, and
+    that it holds no pointers to unmarked strings. */
+
+    /* Strings in the base stay where they are, but are no longer saved by
+    stringstore_save */
+    stringstore_base_t *base = &store->base;
+    for(uint32_t i = 0; i < base->n_entries; i++){
+        if(!base->marked[i] && !base->dropped[i]){
+            base->dropped[i] = true;
+            stringstore_get_shard(store,
+                stringstore_hash_shard(store, base->entries[i].hash)
+            )->stats.swept++;
+        }
+        base->marked[i] = false;
+    }
+
+    for(int i = 0; i < store->n_shards; i++){
+        stringstore_shard_t *shard = stringstore_get_shard(store, i);
+        stringstore_lock(store, shard);
+        int err = stringstore_sweep_shard(shard);
+        stringstore_unlock(store, shard);
+        if(err)return err;
+    }
+    return 0;
 }
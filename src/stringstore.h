@@ -2,27 +2,205 @@
 #define _STRINGSTORE_H_
 
 #include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
 
 #include "array.h"
 
+
+/* Maximum number of parts which can be passed to stringstore_get_join */
+#define STRINGSTORE_MAX_JOIN_PARTS 8
+
+/* Returned by stringstore_find_id for strings which aren't in the store */
+#define STRINGSTORE_ID_NONE ((uint32_t)-1)
+
+/* Maximum number of shards for stringstore_init_concurrent */
+#define STRINGSTORE_MAX_SHARDS 256
+
+
+enum stringstore_case {
+    STRINGSTORE_CASE_KEEP,
+    STRINGSTORE_CASE_UPPER,
+    STRINGSTORE_CASE_LOWER
+};
+
 typedef struct stringstore_entry {
-    char *data;
+    /* Weakref: points into one of the shard's slabs.
+    NULL if the entry's string was dropped by stringstore_sweep (in which
+    case its local id is on the shard's free_ids, for reuse). */
+    const char *data;
+
+    size_t len; /* strlen(data) */
+    uint32_t hash; /* stringstore_hash(data, len) */
+
+    bool marked; /* See stringstore_mark */
 } stringstore_entry_t;
 
+/* A large block of memory into which a shard packs its strings
+(including their NUL terminators), one after another */
+typedef struct stringstore_slab {
+    char *data;
+    size_t size;
+    size_t len; /* Number of bytes of data used so far */
+} stringstore_slab_t;
+
+/* On-disk snapshot format (see stringstore_save), in native byte order:
+
+    stringstore_snapshot_header_t header;
+    stringstore_snapshot_entry_t entries[header.n_entries];
+    uint32_t index[header.index_size];
+    char strings[header.strings_size];
+
+Each entry's string lives in strings at its offset, preceded by its id
+(a uint32_t equal to the entry's index) and followed by a NUL, exactly as
+in a slab. Offsets are multiples of 4.
+index is an open-addressing hash index over entries, in the same format
+as a shard's index. */
+#define STRINGSTORE_SNAPSHOT_MAGIC "FUSSTRS1"
+
+typedef struct stringstore_snapshot_header {
+    char magic[8];
+    uint32_t n_entries;
+    uint32_t index_size;
+    uint64_t strings_size;
+} stringstore_snapshot_header_t;
+
+typedef struct stringstore_snapshot_entry {
+    uint32_t offset;
+    uint32_t len;
+    uint32_t hash;
+} stringstore_snapshot_entry_t;
+
+/* A read-only layer of strings mapped into memory from a snapshot file.
+Its strings' ids are 0 through n_entries - 1. */
+typedef struct stringstore_base {
+    void *map;
+    size_t map_size;
+
+    /* Weakrefs into map: */
+    uint32_t n_entries;
+    uint32_t index_size;
+    const stringstore_snapshot_entry_t *entries;
+    const uint32_t *index;
+    const char *strings;
+
+    /* Malloc'd, n_entries of each, indexed by id (see stringstore_mark).
+    The base's strings are never freed, since they live in map; but those
+    dropped by stringstore_sweep aren't saved by stringstore_save, unless
+    they're looked up again first.
+    Like the overlay's entries, each string's flags are only accessed with
+    the lock of the shard its hash maps to. */
+    bool *marked;
+    bool *dropped;
+} stringstore_base_t;
+
+/* Counters & sizes reported by stringstore_get_stats */
+typedef struct stringstore_stats {
+    /* Lookups made by stringstore_get* and stringstore_find.
+    For stringstore_get*, each miss adds a new string to the store. */
+    uint64_t lookups;
+    uint64_t hits;
+    uint64_t misses;
+
+    /* Number of index slots examined by lookups (in the base and then in
+    a shard), in total and by the longest single lookup */
+    uint64_t probes;
+    uint64_t max_probes;
+
+    /* Strings passed to stringstore_get_donate, and how many of those were
+    already in the store (so were freed without adding anything) */
+    uint64_t donated;
+    uint64_t donated_dups;
+
+    /* Strings dropped by stringstore_sweep, and slabs freed as a result */
+    uint64_t swept;
+    uint64_t slabs_freed;
+
+    /* The following are computed by stringstore_get_stats from the store's
+    current contents, rather than counted */
+    uint64_t n_strings; /* In the base (unless dropped) and the overlay */
+    uint64_t string_bytes; /* Sum of (len + 1) over all strings */
+    uint64_t slab_bytes; /* Allocated for the overlay's slabs */
+    uint64_t slab_bytes_used;
+    uint64_t index_bytes; /* Allocated for the overlay's indexes */
+    uint64_t base_bytes; /* Size of the base's snapshot file */
+} stringstore_stats_t;
+
+/* Strings are distributed over a store's shards by hash.
+Each shard is a self-contained hash table with its own lock, which is only
+used if the store was initialized with stringstore_init_concurrent. */
+typedef struct stringstore_shard {
+    /* Each entry's index is its "local id" within the shard
+    (see stringstore_id) */
+    ARRAYOF(stringstore_entry_t) entries;
+    ARRAYOF(uint32_t) free_ids;
+
+    /* The last slab is the one currently being filled */
+    ARRAYOF(stringstore_slab_t) slabs;
+
+    /* Open-addressing hash index over entries.
+    Each slot is either 0 (empty) or an index into entries, plus 1.
+    index_size is always 0 or a power of 2. */
+    size_t index_size;
+    size_t *index;
+
+    /* Only the counters are kept up to date (see stringstore_get_stats) */
+    stringstore_stats_t stats;
+
+    pthread_mutex_t lock;
+} stringstore_shard_t;
+
 typedef struct stringstore {
-    ARRAYOF(stringstore_entry_t *) entries;
+    /* Strings loaded with stringstore_load_base.
+    Strings which aren't in the base are added to the shards (which are
+    an "overlay" on top of the base), and their ids start after the
+    base's. */
+    stringstore_base_t base;
+
+    /* Whether shards are locked while being accessed, so that several
+    threads (e.g. several lexers) may share the store */
+    bool concurrent;
+
+    /* n_shards is always a power of 2.
+    If n_shards == 1, then the only shard is "shard", and "shards" is
+    NULL. */
+    int n_shards;
+    int shard_bits; /* log2(n_shards) */
+    stringstore_shard_t *shards;
+    stringstore_shard_t shard;
 } stringstore_t;
 
 void stringstore_entry_cleanup(stringstore_entry_t *entry);
+void stringstore_slab_cleanup(stringstore_slab_t *slab);
+void stringstore_shard_cleanup(stringstore_shard_t *shard);
+void stringstore_base_cleanup(stringstore_base_t *base);
 void stringstore_cleanup(stringstore_t *store);
+void stringstore_stats_dump(stringstore_stats_t *stats, FILE *f);
 void stringstore_dump(stringstore_t *store, FILE *f);
 void stringstore_init(stringstore_t *store);
+int stringstore_init_concurrent(stringstore_t *store, int n_shards);
+uint32_t stringstore_hash(const char *data, size_t len);
 int stringstore_add(stringstore_t *store, const char *data,
     stringstore_entry_t **entry_ptr);
 int stringstore_add_donate(stringstore_t *store, char *data,
     stringstore_entry_t **entry_ptr);
 const char *stringstore_find(stringstore_t *store, const char *data);
 const char *stringstore_get(stringstore_t *store, const char *data);
+const char *stringstore_get_n(stringstore_t *store, const char *data,
+    size_t len);
+const char *stringstore_get_join(stringstore_t *store, int strcase,
+    int n_parts, const char **parts);
 const char *stringstore_get_donate(stringstore_t *store, char *data);
+uint32_t stringstore_id(stringstore_t *store, const char *data);
+uint32_t stringstore_find_id(stringstore_t *store, const char *data);
+const char *stringstore_string(stringstore_t *store, uint32_t id);
+bool stringstore_owns(stringstore_t *store, const char *data);
+uint32_t stringstore_n_ids(stringstore_t *store);
+void stringstore_get_stats(stringstore_t *store, stringstore_stats_t *stats);
+void stringstore_mark(stringstore_t *store, const char *data);
+int stringstore_sweep(stringstore_t *store);
+int stringstore_save(stringstore_t *store, const char *filename);
+int stringstore_load_base(stringstore_t *store, const char *filename);
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,336 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "array.h"
+#include "stringstore.h"
+
+
+/* Saving & loading of stringstore snapshots.
+See stringstore.h for a description of the file format. */
+
+
+#define ID_SIZE sizeof(uint32_t)
+
+
+void stringstore_base_cleanup(stringstore_base_t *base){
+    if(base->map)munmap(base->map, base->map_size);
+    free(base->marked);
+    free(base->dropped);
+    memset(base, 0, sizeof(*base));
+}
+
+
+/* A string to be saved */
+typedef struct stringstore_saved {
+    const char *data;
+    size_t len;
+    uint32_t hash;
+} stringstore_saved_t;
+
+typedef ARRAYOF(stringstore_saved_t) arrayof_saved_t;
+
+static int stringstore_collect_strings(stringstore_t *store,
+    arrayof_saved_t *saved
+){
+    /* Collects all of the store's strings which weren't dropped by
+    stringstore_sweep (from the base, and then from the overlay), in the
+    order in which they will be saved.
+    Their index in saved is their id in the snapshot, which need not be
+    the same as their id in store. */
+    stringstore_base_t *base = &store->base;
+    for(uint32_t i = 0; i < base->n_entries; i++){
+        if(base->dropped[i])continue;
+        const stringstore_snapshot_entry_t *entry = &base->entries[i];
+        ARRAY_PUSH(stringstore_saved_t, *saved, saved_string)
+        saved_string->data = base->strings + entry->offset;
+        saved_string->len = entry->len;
+        saved_string->hash = entry->hash;
+    }
+    for(int i = 0; i < store->n_shards; i++){
+        stringstore_shard_t *shard = store->shards?
+            &store->shards[i]: &store->shard;
+        ARRAY_FOR(stringstore_entry_t, shard->entries, entry){
+            if(!entry->data)continue;
+            ARRAY_PUSH(stringstore_saved_t, *saved, saved_string)
+            saved_string->data = entry->data;
+            saved_string->len = entry->len;
+            saved_string->hash = entry->hash;
+        }
+    }
+    if(saved->len > UINT32_MAX / 4){
+        fprintf(stderr, "%s: Too many strings to save\n", __func__);
+        return 2;
+    }
+    return 0;
+}
+
+static int stringstore_write_snapshot(arrayof_saved_t *saved, FILE *file){
+    uint32_t n_entries = saved->len;
+
+    uint32_t index_size = 1;
+    while(index_size < n_entries * 2)index_size *= 2;
+
+    stringstore_snapshot_entry_t *entries = calloc(n_entries,
+        sizeof(*entries));
+    uint32_t *index = calloc(index_size, sizeof(*index));
+    if(!entries || !index){
+        free(entries);
+        free(index);
+        return 1;
+    }
+
+    /* Lay out the strings, and build the index */
+    uint64_t offset = 0;
+    for(uint32_t i = 0; i < n_entries; i++){
+        stringstore_snapshot_entry_t *entry = &entries[i];
+        entry->len = saved->elems[i].len;
+        entry->hash = saved->elems[i].hash;
+
+        offset += ID_SIZE;
+        if(offset > UINT32_MAX){
+            fprintf(stderr, "%s: Too much string data to save\n", __func__);
+            free(entries);
+            free(index);
+            return 2;
+        }
+        entry->offset = offset;
+        offset += entry->len + 1;
+        offset = (offset + ID_SIZE - 1) / ID_SIZE * ID_SIZE;
+
+        uint32_t mask = index_size - 1;
+        uint32_t j = entry->hash & mask;
+        while(index[j])j = (j + 1) & mask;
+        index[j] = i + 1;
+    }
+
+    stringstore_snapshot_header_t header = {
+        .n_entries = n_entries,
+        .index_size = index_size,
+        .strings_size = offset,
+    };
+    memcpy(header.magic, STRINGSTORE_SNAPSHOT_MAGIC, sizeof(header.magic));
+
+    bool ok =
+        fwrite(&header, sizeof(header), 1, file) == 1 &&
+        fwrite(entries, sizeof(*entries), n_entries, file) == n_entries &&
+        fwrite(index, sizeof(*index), index_size, file) == index_size;
+
+    /* Write the strings, each preceded by its id and padded with NULs */
+    static const char zeros[ID_SIZE + 1] = {0};
+    for(uint32_t i = 0; ok && i < n_entries; i++){
+        stringstore_snapshot_entry_t *entry = &entries[i];
+        const char *data = saved->elems[i].data;
+        size_t size = ID_SIZE + entry->len + 1;
+        size_t padding = (ID_SIZE - size % ID_SIZE) % ID_SIZE;
+        ok =
+            fwrite(&i, ID_SIZE, 1, file) == 1 &&
+            fwrite(data, 1, entry->len, file) == entry->len &&
+            fwrite(zeros, 1, 1 + padding, file) == 1 + padding;
+    }
+
+    free(entries);
+    free(index);
+    return ok? 0: 1;
+}
+
+int stringstore_save(stringstore_t *store, const char *filename){
+    /* Writes all of the store's strings (from both its base and its
+    overlay, except those dropped by stringstore_sweep) to a snapshot file, which may be loaded by a later process
+    with stringstore_load_base.
+    NOTE: no other thread may add strings to the store while it is being
+    saved. */
+    int err;
+
+    /* We write to a temporary file, and then rename it, since filename
+    may be the file our base is mapped from */
+    size_t filename_len = strlen(filename);
+    char *tmp_filename = malloc(filename_len + 5);
+    if(!tmp_filename)return 1;
+    memcpy(tmp_filename, filename, filename_len);
+    strcpy(tmp_filename + filename_len, ".tmp");
+
+    arrayof_saved_t saved = {0};
+    err = stringstore_collect_strings(store, &saved);
+    if(err)goto done;
+
+    FILE *file = fopen(tmp_filename, "wb");
+    if(!file){
+        perror("fopen");
+        fprintf(stderr, "Could not open file for writing: %s\n",
+            tmp_filename);
+        err = 1;
+        goto done;
+    }
+
+    err = stringstore_write_snapshot(&saved, file);
+    if(fclose(file))err = 1;
+    if(!err && rename(tmp_filename, filename)){
+        perror("rename");
+        err = 1;
+    }
+    if(err){
+        fprintf(stderr, "Could not write string snapshot: %s\n", filename);
+        remove(tmp_filename);
+    }
+
+done:
+    free(saved.elems);
+    free(tmp_filename);
+    return err;
+}
+
+static int stringstore_base_check_index(stringstore_base_t *base,
+    bool *valid_ptr
+){
+    /* Checks that the index has at least one empty slot, and that every
+    entry appears in it exactly once, in a slot which can be reached from
+    its hash's "home" slot without crossing an empty slot.
+    So stringstore_base_lookup finds every entry, and always stops. */
+    uint32_t mask = base->index_size - 1;
+    bool *seen = calloc(base->n_entries, sizeof(*seen));
+    if(base->n_entries && !seen)return 1;
+
+    uint32_t start = 0;
+    while(start <= mask && base->index[start])start++;
+    bool valid = start <= mask;
+
+    /* Walk the index (wrapping around) from just after that empty slot,
+    keeping track of where the current run of full slots starts */
+    uint32_t n_seen = 0;
+    uint32_t run_start = (start + 1) & mask;
+    for(uint32_t k = 1; valid && k <= base->index_size; k++){
+        uint32_t i = (start + k) & mask;
+        uint32_t slot = base->index[i];
+        if(!slot){
+            run_start = (i + 1) & mask;
+            continue;
+        }
+        if(slot > base->n_entries || seen[slot - 1]){
+            valid = false;
+            break;
+        }
+        seen[slot - 1] = true;
+        n_seen++;
+        uint32_t home = base->entries[slot - 1].hash & mask;
+        if(((i - home) & mask) > ((i - run_start) & mask))valid = false;
+    }
+    if(n_seen != base->n_entries)valid = false;
+
+    free(seen);
+    *valid_ptr = valid;
+    return 0;
+}
+
+int stringstore_load_base(stringstore_t *store, const char *filename){
+    /* Maps a snapshot file written by stringstore_save into memory, and uses
+    it as the store's (read-only) base.
+    Must be called before any strings are added to the store, since the
+    ids of strings in the base start at 0. */
+
+    if(store->base.map || stringstore_n_ids(store)){
+        fprintf(stderr, "%s: Store is not empty\n", __func__);
+        return 2;
+    }
+
+    int fd = open(filename, O_RDONLY);
+    if(fd < 0){
+        perror("open");
+        fprintf(stderr, "Could not open file: %s\n", filename);
+        return 1;
+    }
+
+    struct stat st;
+    if(fstat(fd, &st)){
+        perror("fstat");
+        close(fd);
+        return 1;
+    }
+    size_t map_size = st.st_size;
+    if(map_size < sizeof(stringstore_snapshot_header_t)){
+        close(fd);
+        goto err_format;
+    }
+
+    void *map = mmap(NULL, map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(map == MAP_FAILED){
+        perror("mmap");
+        fprintf(stderr, "Could not map file: %s\n", filename);
+        return 1;
+    }
+
+    const stringstore_snapshot_header_t *header = map;
+    uint64_t n_entries = header->n_entries;
+    uint64_t index_size = header->index_size;
+    uint64_t entries_offset = sizeof(*header);
+    uint64_t index_offset = entries_offset +
+        n_entries * sizeof(stringstore_snapshot_entry_t);
+    uint64_t strings_offset = index_offset + index_size * sizeof(uint32_t);
+    if(
+        memcmp(header->magic, STRINGSTORE_SNAPSHOT_MAGIC,
+            sizeof(header->magic)) ||
+        index_size == 0 ||
+        (index_size & (index_size - 1)) ||
+        index_size < n_entries * 2 ||
+        strings_offset + header->strings_size != map_size
+    ){
+        munmap(map, map_size);
+        goto err_format;
+    }
+
+    stringstore_base_t *base = &store->base;
+    base->map = map;
+    base->map_size = map_size;
+    base->n_entries = n_entries;
+    base->index_size = index_size;
+    base->entries = (const void *)((const char *)map + entries_offset);
+    base->index = (const void *)((const char *)map + index_offset);
+    base->strings = (const char *)map + strings_offset;
+
+    /* Check that every entry's string lies within the mapped file, is
+    preceded by its id, and has the hash stored on the entry */
+    for(uint32_t i = 0; i < base->n_entries; i++){
+        const stringstore_snapshot_entry_t *entry = &base->entries[i];
+        uint32_t id;
+        if(
+            entry->offset < ID_SIZE ||
+            (uint64_t)entry->offset + entry->len >= header->strings_size ||
+            base->strings[entry->offset + entry->len] != '\0' ||
+            (memcpy(&id, base->strings + entry->offset - ID_SIZE, ID_SIZE),
+                id != i) ||
+            stringstore_hash(base->strings + entry->offset, entry->len) !=
+                entry->hash
+        ){
+            stringstore_base_cleanup(base);
+            goto err_format;
+        }
+    }
+
+    bool valid;
+    int err = stringstore_base_check_index(base, &valid);
+    if(err || !valid){
+        stringstore_base_cleanup(base);
+        if(err)return err;
+        goto err_format;
+    }
+
+    base->marked = calloc(base->n_entries, sizeof(*base->marked));
+    base->dropped = calloc(base->n_entries, sizeof(*base->dropped));
+    if(base->n_entries && (!base->marked || !base->dropped)){
+        stringstore_base_cleanup(base);
+        return 1;
+    }
+
+    return 0;
+err_format:
+    fprintf(stderr, "Not a valid string snapshot: %s\n", filename);
+    return 2;
+}
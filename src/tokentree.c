@@ -5,41 +5,181 @@
 #include <string.h>
 
 #include "tokentree.h"
+#include "arena.h"
 #include "lexer.h"
 #include "lexer_macros.h"
 #include "writer.h"
+#include "stringstore.h"
 
 
 
 void tokentree_cleanup(tokentree_t *tokentree) {
-    switch(tokentree->tag) {
-        case TOKENTREE_TAG_ARR: {
-            ARRAY_FOR(tokentree_t, tokentree->u.array_f, elem) {
-                tokentree_cleanup(elem);
+    /* Frees tokentree's arrays, without recursing (so that arbitrarily
+    deep tokentrees can be freed).
+    We walk the tree as if tokentree were the only element of an array,
+    and on descending into an ARR, we overwrite it (it's about to be freed,
+    after all) with a link back to its parent ARR and its index within its
+    parent's elems. */
+    tokentree_t *parent = NULL;
+    tokentree_t *elems = tokentree;
+    size_t i = 0, len = 1;
+    while (1) {
+        if (i < len) {
+            tokentree_t *elem = &elems[i];
+            if (elem->tag == TOKENTREE_TAG_ARR) {
+                tokentree_t *child_elems = elem->u.array_f.elems;
+                size_t child_len = elem->u.array_f.len;
+                elem->u.array_f.elems = parent;
+                elem->u.array_f.len = i;
+                elem->u.array_f.size = len;
+                parent = elem;
+                elems = child_elems;
+                i = 0;
+                len = child_len;
+                continue;
             }
-            free(tokentree->u.array_f.elems);
+            if (elem->tag == TOKENTREE_TAG_INTS) free(elem->u.ints_f.elems);
+            i++;
+        } else {
+            if (!parent) break;
+            free(elems);
+
+            /* Follow the link back up to parent's parent */
+            i = parent->u.array_f.len;
+            len = parent->u.array_f.size;
+            elems = parent - i;
+            parent = parent->u.array_f.elems;
+            i++;
         }
-        default: break;
     }
 }
 
 
-int tokentree_parse(tokentree_t *tokentree, lexer_t *lexer) {
+/* State of a call to tokentree_parse*.
+Each ARR's elements (and each INTS node's ints) are gathered on a scratch
+stack while being parsed, and then copied into an array of exactly the
+right size, allocated from arena (or with malloc, if arena is NULL), or
+looked up in pool (if non-NULL).
+For each ARR still being parsed, arr_starts holds the index into elems
+of its first element. */
+typedef struct tokentree_parser {
+    lexer_t *lexer;
+    arena_t *arena;
+    tokentree_pool_t *pool;
+    arrayof_inplace_tokentree_t elems;
+    arrayof_int_t ints;
+    arrayof_size_t arr_starts;
+} tokentree_parser_t;
+
+static void *tokentree_parser_alloc(tokentree_parser_t *parser, size_t size) {
+    if (size == 0) return NULL;
+    return parser->arena? arena_alloc(parser->arena, size): malloc(size);
+}
+
+static bool tokentree_parser_mallocs(tokentree_parser_t *parser) {
+    /* Whether the tokentrees we parse should be freed with
+    tokentree_cleanup */
+    return !parser->arena && !parser->pool;
+}
+
+static int tokentree_parser_push_elem(tokentree_parser_t *parser,
+    tokentree_t *elem
+) {
+    ARRAY_PUSH(tokentree_t, parser->elems, new_elem)
+    *new_elem = *elem;
+    return 0;
+}
+
+static int tokentree_parser_push_arr_start(tokentree_parser_t *parser) {
+    ARRAY_PUSH(size_t, parser->arr_starts, start)
+    *start = parser->elems.len;
+    return 0;
+}
+
+static int tokentree_parse_ints(tokentree_parser_t *parser,
+    tokentree_t *tokentree
+) {
+    /* Parses a run of INT tokens within an ARR, as either an INT or (if
+    there are several) an INTS node.
+    The run is read in bulk by lexer_get_ints. */
     int err;
+    lexer_t *lexer = parser->lexer;
 
     memset(tokentree, 0, sizeof(*tokentree));
     tokentree->tag = TOKENTREE_TAG_UNDEFINED;
 
-    if (GOT_OPEN) {
-        tokentree->tag = TOKENTREE_TAG_ARR;
-        NEXT
-        while (!DONE && !GOT_CLOSE) {
-            ARRAY_PUSH(tokentree_t, tokentree->u.array_f, elem)
-            err = tokentree_parse(elem, lexer);
-            if (err) return err;
+    parser->ints.len = 0;
+    GET_INTS(parser->ints)
+    if (parser->ints.len == 1) {
+        tokentree->tag = TOKENTREE_TAG_INT;
+        tokentree->u.int_f = parser->ints.elems[0];
+        return 0;
+    }
+
+    size_t len = parser->ints.len;
+    int *elems;
+    if (parser->pool) {
+        err = tokentree_pool_get_ints(parser->pool, parser->ints.elems, len,
+            &elems);
+        if (err) return err;
+    } else {
+        elems = tokentree_parser_alloc(parser, len * sizeof(*elems));
+        if (!elems) return 1;
+        memcpy(elems, parser->ints.elems, len * sizeof(*elems));
+    }
+    tokentree->tag = TOKENTREE_TAG_INTS;
+    tokentree->u.ints_f.elems = elems;
+    tokentree->u.ints_f.len = len;
+    tokentree->u.ints_f.size = len;
+    return 0;
+}
+
+static int tokentree_parse_arr(tokentree_parser_t *parser,
+    tokentree_t *tokentree
+) {
+    /* Parses the CLOSE of the innermost ARR being parsed, and pops its
+    elements off the scratch stack into tokentree */
+    int err;
+    lexer_t *lexer = parser->lexer;
+
+    memset(tokentree, 0, sizeof(*tokentree));
+    tokentree->tag = TOKENTREE_TAG_UNDEFINED;
+
+    GET_CLOSE
+
+    size_t elems_start = parser->arr_starts.elems[--parser->arr_starts.len];
+    size_t len = parser->elems.len - elems_start;
+    tokentree_t *elems;
+    if (parser->pool) {
+        err = tokentree_pool_get_arr(parser->pool,
+            parser->elems.elems + elems_start, len, &elems);
+        if (err) return err;
+    } else {
+        elems = tokentree_parser_alloc(parser, len * sizeof(*elems));
+        if (len) {
+            if (!elems) return 1;
+            memcpy(elems, parser->elems.elems + elems_start,
+                len * sizeof(*elems));
         }
-        GET_CLOSE
-    } else if (GOT_INT) {
+    }
+    parser->elems.len = elems_start;
+    tokentree->tag = TOKENTREE_TAG_ARR;
+    tokentree->u.array_f.elems = elems;
+    tokentree->u.array_f.len = len;
+    tokentree->u.array_f.size = len;
+    return 0;
+}
+
+static int tokentree_parse_leaf(tokentree_parser_t *parser,
+    tokentree_t *tokentree
+) {
+    int err;
+    lexer_t *lexer = parser->lexer;
+
+    memset(tokentree, 0, sizeof(*tokentree));
+    tokentree->tag = TOKENTREE_TAG_UNDEFINED;
+
+    if (GOT_INT) {
         int i;
         GET_INT(i)
         tokentree->tag = TOKENTREE_TAG_INT;
@@ -60,18 +200,198 @@ int tokentree_parse(tokentree_t *tokentree, lexer_t *lexer) {
         tokentree->tag = TOKENTREE_TAG_STR;
         tokentree->u.string_f = string;
     } else {
-        return UNEXPECTED(
-            "one of: INT (e.g. 123, -10), "
-            "NAME (e.g. x, x2, hello_world, SomeName), "
-            "OP (e.g. +, --, =>), "
-            "STR (e.g. \"hello world\", \"a \\\"quoted\\\" thing\", \"two\\nlines\"), "
-            "ARR (e.g. (1 2 3))");
+        return tokentree_unexpected(lexer);
     }
     return 0;
 }
 
-int tokentree_write(tokentree_t *tokentree, writer_t *writer) {
+static int _tokentree_parse(tokentree_parser_t *parser,
+    tokentree_t *tokentree
+) {
+    /* Parses a tokentree without recursing: each OPEN pushes an entry
+    onto parser->arr_starts, and each tokentree we finish (a leaf, or an
+    ARR whose CLOSE we just got) is pushed onto the scratch stack as an
+    element of the innermost open ARR, if there is one */
     int err;
+    lexer_t *lexer = parser->lexer;
+
+    memset(tokentree, 0, sizeof(*tokentree));
+    tokentree->tag = TOKENTREE_TAG_UNDEFINED;
+
+    while (1) {
+        bool in_arr = parser->arr_starts.len > 0;
+        if (GOT_OPEN) {
+            NEXT
+            err = tokentree_parser_push_arr_start(parser);
+            if (err) return err;
+            continue;
+        }
+
+        tokentree_t elem;
+        err =
+            in_arr && (DONE || GOT_CLOSE)? tokentree_parse_arr(parser, &elem):
+            in_arr && GOT_INT? tokentree_parse_ints(parser, &elem):
+            tokentree_parse_leaf(parser, &elem);
+        if (err) return err;
+
+        if (!parser->arr_starts.len) {
+            *tokentree = elem;
+            return 0;
+        }
+
+        err = tokentree_parser_push_elem(parser, &elem);
+        if (err) {
+            if (tokentree_parser_mallocs(parser)) tokentree_cleanup(&elem);
+            return err;
+        }
+    }
+}
+
+int tokentree_unexpected(lexer_t *lexer) {
+    /* Reports that lexer's current token can't start a tokentree */
+    return UNEXPECTED(
+        "one of: INT (e.g. 123, -10), "
+        "NAME (e.g. x, x2, hello_world, SomeName), "
+        "OP (e.g. +, --, =>), "
+        "STR (e.g. \"hello world\", \"a \\\"quoted\\\" thing\", \"two\\nlines\"), "
+        "ARR (e.g. (1 2 3))");
+}
+
+static int tokentree_parse_with(tokentree_parser_t *parser,
+    tokentree_t *tokentree
+) {
+    int err = _tokentree_parse(parser, tokentree);
+    if (err && tokentree_parser_mallocs(parser)) {
+        /* Free our ancestors' elements, which were left on the stack */
+        ARRAY_FOR(tokentree_t, parser->elems, elem) tokentree_cleanup(elem);
+    }
+    free(parser->elems.elems);
+    free(parser->ints.elems);
+    free(parser->arr_starts.elems);
+    return err;
+}
+
+int tokentree_parse_arena(tokentree_t *tokentree, lexer_t *lexer,
+    arena_t *arena
+) {
+    /* Like tokentree_parse, but tokentree's arrays are allocated from
+    arena, so that the whole tree is freed at once by arena_cleanup.
+    Such a tokentree must NOT be passed to tokentree_cleanup.
+    (The tree's root, i.e. *tokentree itself, belongs to the caller.) */
+    tokentree_parser_t parser = {.lexer = lexer, .arena = arena};
+    return tokentree_parse_with(&parser, tokentree);
+}
+
+int tokentree_parse_pool(tokentree_t *tokentree, lexer_t *lexer,
+    tokentree_pool_t *pool
+) {
+    /* Like tokentree_parse, but tokentree's arrays are shared with any
+    identical ones already in pool (see tokentree_pool_t), e.g. those of
+    other tokentrees parsed into the same pool.
+    Such a tokentree must NOT be modified, or passed to tokentree_cleanup.
+    (The tree's root, i.e. *tokentree itself, belongs to the caller.) */
+    tokentree_parser_t parser = {.lexer = lexer, .pool = pool};
+    return tokentree_parse_with(&parser, tokentree);
+}
+
+int tokentree_parse(tokentree_t *tokentree, lexer_t *lexer) {
+    /* Parses a tokentree from lexer.
+    Its arrays are malloc'd (at their exact sizes), and are freed by
+    tokentree_cleanup. */
+    return tokentree_parse_arena(tokentree, lexer, NULL);
+}
+
+bool tokentree_shallow_equal(const tokentree_t *a, const tokentree_t *b) {
+    /* Compares a and b's tags and immediate values (for ARRs and INTS
+    nodes, their elems pointers and lens).
+    For tokentrees parsed into the same tokentree_pool_t, this is the same
+    as comparing them structurally (except that strs copied into an arena,
+    see lexer->str_arena, are compared by pointer). */
+    if (a->tag != b->tag) return false;
+    switch (a->tag) {
+        case TOKENTREE_TAG_INT:
+            return a->u.int_f == b->u.int_f;
+        case TOKENTREE_TAG_NAME:
+        case TOKENTREE_TAG_OP:
+        case TOKENTREE_TAG_STR:
+            return a->u.string_f == b->u.string_f;
+        case TOKENTREE_TAG_ARR:
+            return a->u.array_f.elems == b->u.array_f.elems &&
+                a->u.array_f.len == b->u.array_f.len;
+        case TOKENTREE_TAG_INTS:
+            return a->u.ints_f.elems == b->u.ints_f.elems &&
+                a->u.ints_f.len == b->u.ints_f.len;
+        default: return true;
+    }
+}
+
+/* An ARR being walked by tokentree_mark_strings or tokentree_write, and
+the index of its next element to be visited */
+typedef struct tokentree_walk_frame {
+    tokentree_t *arr;
+    size_t i;
+} tokentree_walk_frame_t;
+
+typedef ARRAYOF(tokentree_walk_frame_t) arrayof_inplace_tokentree_walk_frame_t;
+
+static int tokentree_walk_push(arrayof_inplace_tokentree_walk_frame_t *frames,
+    tokentree_t *arr
+) {
+    ARRAY_PUSH(tokentree_walk_frame_t, *frames, frame)
+    frame->arr = arr;
+    frame->i = 0;
+    return 0;
+}
+
+static tokentree_t *tokentree_walk_next(
+    arrayof_inplace_tokentree_walk_frame_t *frames
+) {
+    /* Returns the next element of the innermost ARR being walked, or NULL
+    if there are no more (in which case the caller should pop it) */
+    tokentree_walk_frame_t *frame = &frames->elems[frames->len - 1];
+    if (frame->i >= frame->arr->u.array_f.len) return NULL;
+    return &frame->arr->u.array_f.elems[frame->i++];
+}
+
+static void tokentree_mark_string(tokentree_t *tokentree,
+    stringstore_t *store
+) {
+    if (tokentree->tag == TOKENTREE_TAG_STR) {
+        /* Strs may not be in the store at all (see lexer->str_arena), so
+        we only mark them if the store owns them */
+        const char *string = tokentree->u.string_f;
+        if (stringstore_owns(store, string)) {
+            stringstore_mark(store, string);
+        }
+    } else if (tokentree_tag_is_string(tokentree->tag)) {
+        stringstore_mark(store, tokentree->u.string_f);
+    }
+}
+
+int tokentree_mark_strings(tokentree_t *tokentree, stringstore_t *store) {
+    /* Marks tokentree's strings, so that they survive stringstore_sweep.
+    Its names and ops MUST have come from store (e.g. tokentree was parsed
+    by a lexer using store). */
+    int err = 0;
+    if (tokentree->tag != TOKENTREE_TAG_ARR) {
+        tokentree_mark_string(tokentree, store);
+        return 0;
+    }
+
+    arrayof_inplace_tokentree_walk_frame_t frames = {0};
+    err = tokentree_walk_push(&frames, tokentree);
+    while (!err && frames.len) {
+        tokentree_t *elem = tokentree_walk_next(&frames);
+        if (!elem) frames.len--;
+        else if (elem->tag == TOKENTREE_TAG_ARR) {
+            err = tokentree_walk_push(&frames, elem);
+        } else tokentree_mark_string(elem, store);
+    }
+    free(frames.elems);
+    return err;
+}
+
+static int tokentree_write_leaf(tokentree_t *tokentree, writer_t *writer) {
     switch(tokentree->tag) {
         case TOKENTREE_TAG_INT:
             return writer_write_int(writer, tokentree->u.int_f);
@@ -81,15 +401,9 @@ int tokentree_write(tokentree_t *tokentree, writer_t *writer) {
             return writer_write_op(writer, tokentree->u.string_f);
         case TOKENTREE_TAG_STR:
             return writer_write_str(writer, tokentree->u.string_f);
-        case TOKENTREE_TAG_ARR: {
-            err = writer_write_open(writer);
-            if (err) return err;
-            ARRAY_FOR(tokentree_t, tokentree->u.array_f, elem) {
-                err = tokentree_write(elem, writer);
-                if (err) return err;
-            }
-            return writer_write_close(writer);
-        }
+        case TOKENTREE_TAG_INTS:
+            return writer_write_ints(writer, tokentree->u.ints_f.elems,
+                tokentree->u.ints_f.len);
         case TOKENTREE_TAG_UNDEFINED:
             fprintf(stderr, "%s: Encountered UNDEFINED tokentree node\n",
                 __func__);
@@ -100,3 +414,30 @@ int tokentree_write(tokentree_t *tokentree, writer_t *writer) {
             return 2;
     }
 }
+
+int tokentree_write(tokentree_t *tokentree, writer_t *writer) {
+    /* Writes tokentree, without recursing (so that arbitrarily deep
+    tokentrees can be written) */
+    int err;
+    if (tokentree->tag != TOKENTREE_TAG_ARR) {
+        return tokentree_write_leaf(tokentree, writer);
+    }
+
+    arrayof_inplace_tokentree_walk_frame_t frames = {0};
+    err = writer_write_open(writer);
+    if (!err) err = tokentree_walk_push(&frames, tokentree);
+    while (!err && frames.len) {
+        tokentree_t *elem = tokentree_walk_next(&frames);
+        if (!elem) {
+            frames.len--;
+            err = writer_write_close(writer);
+        } else if (elem->tag == TOKENTREE_TAG_ARR) {
+            err = writer_write_open(writer);
+            if (!err) err = tokentree_walk_push(&frames, elem);
+        } else {
+            err = tokentree_write_leaf(elem, writer);
+        }
+    }
+    free(frames.elems);
+    return err;
+}
@@ -3,14 +3,17 @@
 
 #include <stdio.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdbool.h>
 
 #include "array.h"
+#include "arena.h"
+#include "lexer.h"
 
 
 /* Expected from other translation units */
-typedef struct lexer lexer_t;
 typedef struct writer writer_t;
+typedef struct stringstore stringstore_t;
 
 
 typedef struct tokentree tokentree_t;
@@ -24,6 +27,7 @@ enum tokentree_tag {
     TOKENTREE_TAG_OP,
     TOKENTREE_TAG_STR,
     TOKENTREE_TAG_ARR,
+    TOKENTREE_TAG_INTS,
     TOKENTREE_TAG_UNDEFINED,
     TOKENTREE_TAGS
 };
@@ -41,12 +45,122 @@ struct tokentree {
         int int_f;
         const char *string_f;
         arrayof_inplace_tokentree_t array_f;
+
+        /* A run of 2 or more consecutive INTs within an ARR, packed into
+        a single node (so e.g. (1 2 3 x 4) is an ARR with 3 elements:
+        an INTS, a NAME, and an INT).
+        Never empty. */
+        arrayof_int_t ints_f;
     } u;
 };
 
+/* A node of a flat tokentree (see tokentree_flat_t) */
+typedef struct tokentree_flat_node {
+    uint32_t tag; /* enum tokentree_tag (never INTS or UNDEFINED) */
+    union {
+        int int_f;
+
+        /* For ARRs: the number of nodes in the subtree, including the ARR
+        itself (so its elements are the following span - 1 nodes) */
+        uint32_t span;
+
+        /* For NAMEs, OPs and STRs: see stringstore_id */
+        uint32_t string_id;
+    } u;
+} tokentree_flat_node_t;
+
+/* A compact alternative to tokentree_t: a sequence of tokentrees, stored
+as one contiguous array of nodes, in pre-order.
+Each node is 8 bytes (as opposed to 32 for a tokentree_t), and nodes are
+visited in order by tokentree_flat_write and lexer_load_tokentree_flat,
+rather than by following pointers.
+Runs of ints are stored as separate INT nodes. */
+typedef struct tokentree_flat {
+    stringstore_t *store; /* Weakref: owns the nodes' strings */
+    ARRAYOF(tokentree_flat_node_t) nodes;
+
+    /* If non-NULL, the flat tokentrees were loaded from a file by
+    tokentree_flat_load, and are read-only: their nodes and strings point
+    into the file's (caller-owned) data, and the nodes' string ids are
+    indexes into string_offsets, rather than ids in store. */
+    const uint64_t *string_offsets;
+    const char *strings;
+} tokentree_flat_t;
+
+/* On-disk format of flat tokentrees (see tokentree_flat_save), in native
+byte order:
+
+    tokentree_file_header_t header;
+    tokentree_flat_node_t nodes[header.n_nodes];
+    uint64_t string_offsets[header.n_strings];
+    char strings[header.strings_size];
+
+The nodes' string ids are indexes into string_offsets, and string i is
+the NUL-terminated string at strings + string_offsets[i].
+So once the file is mapped into memory, its tokentrees may be walked in
+place, without any parsing. */
+#define TOKENTREE_FILE_MAGIC "FUSTREE1"
+
+/* A set of tokentree arrays (the elems of ARRs and INTS nodes), each
+stored once: tokentrees parsed by tokentree_parse_pool share identical
+subtrees, rather than each having its own copy.
+Since an ARR's elements are themselves pooled, two ARRs are identical
+iff their elems pointers (and lens) are equal, so hashing and comparing
+an array only ever looks at its immediate elements. See also
+tokentree_shallow_equal.
+Pooled tokentrees are immutable, and are freed all at once by
+tokentree_pool_cleanup (they must NOT be passed to tokentree_cleanup). */
+typedef struct tokentree_pool_entry {
+    uint32_t hash;
+    int tag; /* TOKENTREE_TAG_ARR or TOKENTREE_TAG_INTS */
+    size_t len;
+    void *elems; /* NULL if this slot is empty */
+} tokentree_pool_entry_t;
+
+typedef struct tokentree_pool {
+    arena_t arena; /* Owns the arrays */
+
+    /* Hash table (open addressing, kept at most half full) */
+    tokentree_pool_entry_t *entries;
+    size_t entries_size;
+    size_t n_entries;
+} tokentree_pool_t;
+
+typedef struct tokentree_file_header {
+    char magic[8];
+    uint64_t n_nodes;
+    uint64_t n_strings;
+    uint64_t strings_size;
+} tokentree_file_header_t;
+
 void tokentree_cleanup(tokentree_t *tokentree);
 int tokentree_parse(tokentree_t *tokentree, lexer_t *lexer);
+int tokentree_parse_arena(tokentree_t *tokentree, lexer_t *lexer,
+    arena_t *arena);
+int tokentree_parse_pool(tokentree_t *tokentree, lexer_t *lexer,
+    tokentree_pool_t *pool);
 int tokentree_write(tokentree_t *tokentree, writer_t *writer);
+bool tokentree_shallow_equal(const tokentree_t *a, const tokentree_t *b);
+int tokentree_mark_strings(tokentree_t *tokentree, stringstore_t *store);
+int tokentree_unexpected(lexer_t *lexer);
+
+void tokentree_pool_cleanup(tokentree_pool_t *pool);
+void tokentree_pool_init(tokentree_pool_t *pool);
+int tokentree_pool_get_arr(tokentree_pool_t *pool, tokentree_t *elems,
+    size_t len, tokentree_t **elems_ptr);
+int tokentree_pool_get_ints(tokentree_pool_t *pool, int *elems,
+    size_t len, int **elems_ptr);
+
+void tokentree_flat_cleanup(tokentree_flat_t *flat);
+void tokentree_flat_init(tokentree_flat_t *flat, stringstore_t *store);
+size_t tokentree_flat_span(tokentree_flat_t *flat, size_t i);
+const char *tokentree_flat_string(tokentree_flat_t *flat, size_t i);
+int tokentree_flat_parse(tokentree_flat_t *flat, lexer_t *lexer);
+int tokentree_flat_write(tokentree_flat_t *flat, size_t i, writer_t *writer);
+int tokentree_flat_save(tokentree_flat_t *flat, FILE *file);
+bool tokentree_flat_is_file(const char *data, size_t size);
+int tokentree_flat_load(tokentree_flat_t *flat, const char *data,
+    size_t size, const char *filename);
 
 
 #endif
\ No newline at end of file
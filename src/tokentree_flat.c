@@ -0,0 +1,415 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "tokentree.h"
+#include "lexer.h"
+#include "lexer_macros.h"
+#include "writer.h"
+#include "stringstore.h"
+
+
+/* Flat tokentrees: see tokentree_flat_t */
+
+
+void tokentree_flat_cleanup(tokentree_flat_t *flat) {
+    if (!flat->strings) free(flat->nodes.elems);
+    memset(flat, 0, sizeof(*flat));
+}
+
+void tokentree_flat_init(tokentree_flat_t *flat, stringstore_t *store) {
+    memset(flat, 0, sizeof(*flat));
+    flat->store = store;
+}
+
+size_t tokentree_flat_span(tokentree_flat_t *flat, size_t i) {
+    /* Returns the number of nodes in the subtree at node i, so that the
+    next tokentree (or the next element of the same ARR) is at node
+    i + span */
+    tokentree_flat_node_t *node = &flat->nodes.elems[i];
+    return node->tag == TOKENTREE_TAG_ARR? node->u.span: 1;
+}
+
+static const char *tokentree_flat_string_by_id(tokentree_flat_t *flat,
+    uint32_t string_id
+) {
+    if (flat->strings) return flat->strings + flat->string_offsets[string_id];
+    return stringstore_string(flat->store, string_id);
+}
+
+const char *tokentree_flat_string(tokentree_flat_t *flat, size_t i) {
+    /* Returns the string of node i, which must be a NAME, OP or STR */
+    return tokentree_flat_string_by_id(flat, flat->nodes.elems[i].u.string_id);
+}
+
+static int tokentree_flat_push(tokentree_flat_t *flat, int tag,
+    tokentree_flat_node_t **node_ptr
+) {
+    ARRAY_PUSH(tokentree_flat_node_t, flat->nodes, node)
+    node->tag = tag;
+    *node_ptr = node;
+    return 0;
+}
+
+static int tokentree_flat_push_string(tokentree_flat_t *flat, int tag,
+    lexer_t *lexer, const char *string
+) {
+    /* Strings are stored by their id in flat->store, so if string came
+    from a different store, we intern it in ours */
+    int err;
+    if (lexer->store != flat->store) {
+        string = stringstore_get(flat->store, string);
+        if (!string) return 1;
+    }
+    tokentree_flat_node_t *node;
+    err = tokentree_flat_push(flat, tag, &node);
+    if (err) return err;
+    node->u.string_id = stringstore_id(flat->store, string);
+    return 0;
+}
+
+static int _tokentree_flat_parse(tokentree_flat_t *flat, lexer_t *lexer,
+    arrayof_size_t *open_arrs
+) {
+    int err;
+    tokentree_flat_node_t *node;
+
+    do {
+        if (GOT_OPEN) {
+            NEXT
+            ARRAY_PUSH(size_t, *open_arrs, open_arr)
+            *open_arr = flat->nodes.len;
+            err = tokentree_flat_push(flat, TOKENTREE_TAG_ARR, &node);
+            if (err) return err;
+        } else if (open_arrs->len && (DONE || GOT_CLOSE)) {
+            GET_CLOSE
+
+            /* Now that we know how many nodes the ARR has, fill in its
+            span */
+            size_t i = open_arrs->elems[--open_arrs->len];
+            size_t span = flat->nodes.len - i;
+            if (span > UINT32_MAX) {
+                lexer_err_info(lexer);
+                fprintf(stderr, "Array is too large for a flat tokentree "
+                    "(%zu nodes)\n", span);
+                return 2;
+            }
+            flat->nodes.elems[i].u.span = span;
+        } else if (GOT_INT) {
+            int i;
+            GET_INT(i)
+            err = tokentree_flat_push(flat, TOKENTREE_TAG_INT, &node);
+            if (err) return err;
+            node->u.int_f = i;
+        } else if (GOT_NAME || GOT_OP) {
+            int tag = GOT_NAME? TOKENTREE_TAG_NAME: TOKENTREE_TAG_OP;
+            const char *string;
+            GET_CONST_STRING(string)
+            err = tokentree_flat_push_string(flat, tag, lexer, string);
+            if (err) return err;
+        } else if (GOT_STR) {
+            /* Strs are interned in flat->store regardless of
+            lexer->str_arena, since nodes refer to strings by id */
+            const char *s;
+            size_t len;
+            GET_STR_VIEW(s, len)
+            const char *string = stringstore_get_n(flat->store, s, len);
+            if (!string) return 1;
+            err = tokentree_flat_push(flat, TOKENTREE_TAG_STR, &node);
+            if (err) return err;
+            node->u.string_id = stringstore_id(flat->store, string);
+        } else {
+            return tokentree_unexpected(lexer);
+        }
+    } while (open_arrs->len);
+    return 0;
+}
+
+int tokentree_flat_parse(tokentree_flat_t *flat, lexer_t *lexer) {
+    /* Parses a tokentree from lexer, appending its nodes to flat.
+    The nodes are appended in the order in which the lexer returns their
+    tokens, so there is no recursion: we only keep a stack of the ARRs
+    which are still open. */
+    if (flat->strings) {
+        fprintf(stderr, "%s: Flat tokentrees loaded from a file are "
+            "read-only\n", __func__);
+        return 2;
+    }
+
+    arrayof_size_t open_arrs = {0};
+    size_t start = flat->nodes.len;
+    int err = _tokentree_flat_parse(flat, lexer, &open_arrs);
+    if (err) flat->nodes.len = start;
+    free(open_arrs.elems);
+    return err;
+}
+
+static int _tokentree_flat_write(tokentree_flat_t *flat, size_t i,
+    writer_t *writer, arrayof_size_t *arr_ends
+) {
+    int err;
+
+    size_t end = i + tokentree_flat_span(flat, i);
+    for (; i < end; i++) {
+        tokentree_flat_node_t *node = &flat->nodes.elems[i];
+        switch (node->tag) {
+            case TOKENTREE_TAG_INT:
+                err = writer_write_int(writer, node->u.int_f);
+                break;
+            case TOKENTREE_TAG_NAME:
+                err = writer_write_name(writer,
+                    tokentree_flat_string(flat, i));
+                break;
+            case TOKENTREE_TAG_OP:
+                err = writer_write_op(writer, tokentree_flat_string(flat, i));
+                break;
+            case TOKENTREE_TAG_STR:
+                err = writer_write_str(writer,
+                    tokentree_flat_string(flat, i));
+                break;
+            case TOKENTREE_TAG_ARR: {
+                ARRAY_PUSH(size_t, *arr_ends, arr_end)
+                *arr_end = i + node->u.span;
+                err = writer_write_open(writer);
+                break;
+            }
+            default:
+                fprintf(stderr, "%s: Unrecognized tokentree tag: %i\n",
+                    __func__, (int)node->tag);
+                return 2;
+        }
+        if (err) return err;
+
+        /* Close the ARRs which end after this node */
+        while (
+            arr_ends->len &&
+            arr_ends->elems[arr_ends->len - 1] == i + 1
+        ) {
+            arr_ends->len--;
+            err = writer_write_close(writer);
+            if (err) return err;
+        }
+    }
+    return 0;
+}
+
+int tokentree_flat_write(tokentree_flat_t *flat, size_t i, writer_t *writer) {
+    /* Writes the subtree at node i, visiting its nodes in order */
+    arrayof_size_t arr_ends = {0};
+    int err = _tokentree_flat_write(flat, i, writer, &arr_ends);
+    free(arr_ends.elems);
+    return err;
+}
+
+
+typedef ARRAYOF(uint32_t) arrayof_uint32_t;
+
+static bool tokentree_flat_node_has_string(tokentree_flat_node_t *node) {
+    return tokentree_tag_is_string(node->tag);
+}
+
+static int tokentree_flat_collect_strings(tokentree_flat_t *flat,
+    uint32_t *local_ids, arrayof_uint32_t *string_ids
+) {
+    /* Gives each distinct string id used by flat's nodes a "local id" (its
+    index within the file's string table, plus 1), in order of first use */
+    ARRAY_FOR(tokentree_flat_node_t, flat->nodes, node) {
+        if (!tokentree_flat_node_has_string(node)) continue;
+        uint32_t string_id = node->u.string_id;
+        if (local_ids[string_id]) continue;
+        ARRAY_PUSH(uint32_t, *string_ids, new_string_id)
+        *new_string_id = string_id;
+        local_ids[string_id] = string_ids->len;
+    }
+    return 0;
+}
+
+static int tokentree_flat_write_file(tokentree_flat_t *flat,
+    uint32_t *local_ids, arrayof_uint32_t *string_ids, FILE *file
+) {
+    /* Work out where each string goes.
+    NOTE: string_offsets has an extra entry at the end, so that each
+    string's size is the difference between its offset and the next. */
+    size_t n_strings = string_ids->len;
+    uint64_t *string_offsets = malloc(
+        (n_strings + 1) * sizeof(*string_offsets));
+    const char **strings = malloc((n_strings + 1) * sizeof(*strings));
+    if (!string_offsets || !strings) {
+        free(string_offsets);
+        free(strings);
+        return 1;
+    }
+    uint64_t strings_size = 0;
+    for (size_t i = 0; i < n_strings; i++) {
+        strings[i] = tokentree_flat_string_by_id(flat, string_ids->elems[i]);
+        string_offsets[i] = strings_size;
+        strings_size += strlen(strings[i]) + 1;
+    }
+    string_offsets[n_strings] = strings_size;
+
+    tokentree_file_header_t header = {
+        .n_nodes = flat->nodes.len,
+        .n_strings = n_strings,
+        .strings_size = strings_size,
+    };
+    memcpy(header.magic, TOKENTREE_FILE_MAGIC, sizeof(header.magic));
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    /* Write the nodes, with their string ids made local */
+    ARRAY_FOR(tokentree_flat_node_t, flat->nodes, node) {
+        if (!ok) break;
+        tokentree_flat_node_t file_node = *node;
+        if (tokentree_flat_node_has_string(node)) {
+            file_node.u.string_id = local_ids[node->u.string_id] - 1;
+        }
+        ok = fwrite(&file_node, sizeof(file_node), 1, file) == 1;
+    }
+
+    ok = ok &&
+        fwrite(string_offsets, sizeof(*string_offsets), n_strings,
+            file) == n_strings;
+    for (size_t i = 0; ok && i < n_strings; i++) {
+        size_t size = string_offsets[i + 1] - string_offsets[i];
+        ok = fwrite(strings[i], 1, size, file) == size;
+    }
+
+    free(string_offsets);
+    free(strings);
+    return ok? 0: 1;
+}
+
+int tokentree_flat_save(tokentree_flat_t *flat, FILE *file) {
+    /* Writes flat's tokentrees to file, in the format described by
+    TOKENTREE_FILE_MAGIC.
+    Only the strings which flat's nodes use are written. */
+    int err;
+
+    uint32_t max_string_id = 0;
+    ARRAY_FOR(tokentree_flat_node_t, flat->nodes, node) {
+        if (!tokentree_flat_node_has_string(node)) continue;
+        if (node->u.string_id > max_string_id) {
+            max_string_id = node->u.string_id;
+        }
+    }
+
+    uint32_t *local_ids = calloc((size_t)max_string_id + 1,
+        sizeof(*local_ids));
+    if (!local_ids) return 1;
+    arrayof_uint32_t string_ids = {0};
+
+    err = tokentree_flat_collect_strings(flat, local_ids, &string_ids);
+    if (!err) err = tokentree_flat_write_file(flat, local_ids, &string_ids,
+        file);
+    if (err == 1) perror("fwrite");
+
+    free(local_ids);
+    free(string_ids.elems);
+    return err;
+}
+
+bool tokentree_flat_is_file(const char *data, size_t size) {
+    /* Whether data (e.g. a file's text, as loaded by map_file) starts like
+    a file written by tokentree_flat_save */
+    return
+        size >= sizeof(tokentree_file_header_t) &&
+        !memcmp(data, TOKENTREE_FILE_MAGIC,
+            sizeof(((tokentree_file_header_t *)NULL)->magic));
+}
+
+static int tokentree_flat_check_nodes(tokentree_flat_t *flat,
+    uint64_t n_strings, arrayof_size_t *arr_ends
+) {
+    /* Checks that the nodes are well-formed, so that they may be walked
+    without any further checks: tags are valid, string ids are in range,
+    and each ARR's span lies within the ARR containing it */
+    tokentree_flat_node_t *nodes = flat->nodes.elems;
+    size_t n_nodes = flat->nodes.len;
+    for (size_t i = 0; i < n_nodes; i++) {
+        while (arr_ends->len && arr_ends->elems[arr_ends->len - 1] == i) {
+            arr_ends->len--;
+        }
+        size_t end = arr_ends->len?
+            arr_ends->elems[arr_ends->len - 1]: n_nodes;
+
+        tokentree_flat_node_t *node = &nodes[i];
+        switch (node->tag) {
+            case TOKENTREE_TAG_INT: break;
+            case TOKENTREE_TAG_NAME:
+            case TOKENTREE_TAG_OP:
+            case TOKENTREE_TAG_STR:
+                if (node->u.string_id >= n_strings) return 2;
+                break;
+            case TOKENTREE_TAG_ARR: {
+                if (node->u.span < 1 || node->u.span > end - i) return 2;
+                ARRAY_PUSH(size_t, *arr_ends, arr_end)
+                *arr_end = i + node->u.span;
+                break;
+            }
+            default: return 2;
+        }
+    }
+    return 0;
+}
+
+int tokentree_flat_load(tokentree_flat_t *flat, const char *data,
+    size_t size, const char *filename
+) {
+    /* Loads flat tokentrees from data, the contents of a file written by
+    tokentree_flat_save (e.g. mapped into memory by map_file).
+    Nothing is copied: flat's nodes and strings point into data, which
+    must outlive flat (and must be 8-byte aligned, as mapped memory is).
+    The file is checked, so that a corrupt one is reported here, rather
+    than being walked off the end of. */
+    int err;
+
+    tokentree_flat_init(flat, NULL);
+    if (!tokentree_flat_is_file(data, size)) goto err_format;
+    if ((uintptr_t)data % sizeof(uint64_t)) {
+        fprintf(stderr, "%s: Data is misaligned: %s\n", __func__, filename);
+        return 2;
+    }
+
+    tokentree_file_header_t header;
+    memcpy(&header, data, sizeof(header));
+    uint64_t max_n = size / sizeof(uint64_t);
+    if (header.n_nodes > max_n || header.n_strings > max_n) {
+        goto err_format;
+    }
+    uint64_t nodes_offset = sizeof(header);
+    uint64_t string_offsets_offset = nodes_offset +
+        header.n_nodes * sizeof(tokentree_flat_node_t);
+    uint64_t strings_offset = string_offsets_offset +
+        header.n_strings * sizeof(uint64_t);
+    if (
+        strings_offset > size ||
+        header.strings_size != size - strings_offset ||
+        (header.strings_size && data[size - 1] != '\0')
+    ) goto err_format;
+
+    const uint64_t *string_offsets =
+        (const void *)(data + string_offsets_offset);
+    for (uint64_t i = 0; i < header.n_strings; i++) {
+        if (string_offsets[i] >= header.strings_size) goto err_format;
+    }
+
+    flat->nodes.elems = (void *)(data + nodes_offset);
+    flat->nodes.len = header.n_nodes;
+    flat->nodes.size = header.n_nodes;
+    flat->string_offsets = string_offsets;
+    flat->strings = data + strings_offset;
+
+    arrayof_size_t arr_ends = {0};
+    err = tokentree_flat_check_nodes(flat, header.n_strings, &arr_ends);
+    free(arr_ends.elems);
+    if (err) {
+        tokentree_flat_init(flat, NULL);
+        if (err == 2) goto err_format;
+        return err;
+    }
+    return 0;
+err_format:
+    fprintf(stderr, "Not a valid tokentree file: %s\n", filename);
+    return 2;
+}
@@ -0,0 +1,194 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "tokentree.h"
+#include "arena.h"
+
+
+/* Hash-consed tokentrees: see tokentree_pool_t */
+
+
+#define INITIAL_ENTRIES_SIZE 256
+
+#define FNV_OFFSET_BASIS 14695981039346656037ull
+#define FNV_PRIME 1099511628211ull
+
+
+void tokentree_pool_cleanup(tokentree_pool_t *pool) {
+    arena_cleanup(&pool->arena);
+    free(pool->entries);
+    memset(pool, 0, sizeof(*pool));
+}
+
+void tokentree_pool_init(tokentree_pool_t *pool) {
+    memset(pool, 0, sizeof(*pool));
+    arena_init(&pool->arena);
+}
+
+static uint64_t tokentree_pool_hash_value(uint64_t hash, uint64_t value) {
+    /* FNV-1a (64-bit), but a whole value at a time rather than a byte at
+    a time */
+    return (hash ^ value) * FNV_PRIME;
+}
+
+static uint64_t tokentree_pool_hash_elem(uint64_t hash,
+    const tokentree_t *elem
+) {
+    /* Hashes elem's tag and immediate value, i.e. whatever
+    tokentree_shallow_equal compares */
+    hash = tokentree_pool_hash_value(hash, elem->tag);
+    switch (elem->tag) {
+        case TOKENTREE_TAG_INT:
+            return tokentree_pool_hash_value(hash, (uint32_t)elem->u.int_f);
+        case TOKENTREE_TAG_NAME:
+        case TOKENTREE_TAG_OP:
+        case TOKENTREE_TAG_STR:
+            return tokentree_pool_hash_value(hash,
+                (uintptr_t)elem->u.string_f);
+        case TOKENTREE_TAG_ARR:
+            hash = tokentree_pool_hash_value(hash,
+                (uintptr_t)elem->u.array_f.elems);
+            return tokentree_pool_hash_value(hash, elem->u.array_f.len);
+        case TOKENTREE_TAG_INTS:
+            hash = tokentree_pool_hash_value(hash,
+                (uintptr_t)elem->u.ints_f.elems);
+            return tokentree_pool_hash_value(hash, elem->u.ints_f.len);
+        default: return hash;
+    }
+}
+
+static uint32_t tokentree_pool_hash(int tag, const void *elems, size_t len) {
+    uint64_t hash = tokentree_pool_hash_value(FNV_OFFSET_BASIS, tag);
+    if (tag == TOKENTREE_TAG_INTS) {
+        const int *ints = elems;
+        for (size_t i = 0; i < len; i++) {
+            hash = tokentree_pool_hash_value(hash, (uint32_t)ints[i]);
+        }
+    } else {
+        const tokentree_t *tokentrees = elems;
+        for (size_t i = 0; i < len; i++) {
+            hash = tokentree_pool_hash_elem(hash, &tokentrees[i]);
+        }
+    }
+
+    /* Multiplying only carries upwards, so fold the high bits (which
+    depend on all of the bits we hashed) into the low bits (which are
+    used to index the hash table) */
+    return (uint32_t)(hash ^ (hash >> 32));
+}
+
+static bool tokentree_pool_entry_eq(tokentree_pool_entry_t *entry,
+    uint32_t hash, int tag, const void *elems, size_t len
+) {
+    if (entry->hash != hash || entry->tag != tag || entry->len != len) {
+        return false;
+    }
+    if (tag == TOKENTREE_TAG_INTS) {
+        return !memcmp(entry->elems, elems, len * sizeof(int));
+    }
+    const tokentree_t *a = entry->elems, *b = elems;
+    for (size_t i = 0; i < len; i++) {
+        if (!tokentree_shallow_equal(&a[i], &b[i])) return false;
+    }
+    return true;
+}
+
+static tokentree_pool_entry_t *tokentree_pool_find_slot(
+    tokentree_pool_entry_t *entries, size_t entries_size,
+    uint32_t hash, int tag, const void *elems, size_t len
+) {
+    /* Returns the entry equal to the given array, or the empty slot where
+    it would be inserted.
+    If elems is NULL, just returns the first empty slot for hash. */
+    size_t mask = entries_size - 1;
+    size_t i = hash & mask;
+    while (1) {
+        tokentree_pool_entry_t *entry = &entries[i];
+        if (!entry->elems) return entry;
+        if (elems && tokentree_pool_entry_eq(entry, hash, tag, elems, len)) {
+            return entry;
+        }
+        i = (i + 1) & mask;
+    }
+}
+
+static int tokentree_pool_grow(tokentree_pool_t *pool) {
+    size_t new_size = pool->entries_size?
+        pool->entries_size * 2: INITIAL_ENTRIES_SIZE;
+    tokentree_pool_entry_t *new_entries = calloc(new_size,
+        sizeof(*new_entries));
+    if (!new_entries) return 1;
+
+    for (size_t i = 0; i < pool->entries_size; i++) {
+        tokentree_pool_entry_t *entry = &pool->entries[i];
+        if (!entry->elems) continue;
+        *tokentree_pool_find_slot(new_entries, new_size, entry->hash,
+            0, NULL, 0) = *entry;
+    }
+
+    free(pool->entries);
+    pool->entries = new_entries;
+    pool->entries_size = new_size;
+    return 0;
+}
+
+static int tokentree_pool_get(tokentree_pool_t *pool, int tag,
+    const void *elems, size_t len, size_t elem_size, void **elems_ptr
+) {
+    /* Sets *elems_ptr to the pool's copy of the given array (adding a copy
+    to the pool if it doesn't have one yet) */
+    int err;
+    if (len == 0) {
+        *elems_ptr = NULL;
+        return 0;
+    }
+
+    if ((pool->n_entries + 1) * 2 > pool->entries_size) {
+        err = tokentree_pool_grow(pool);
+        if (err) return err;
+    }
+
+    uint32_t hash = tokentree_pool_hash(tag, elems, len);
+    tokentree_pool_entry_t *entry = tokentree_pool_find_slot(pool->entries,
+        pool->entries_size, hash, tag, elems, len);
+    if (!entry->elems) {
+        void *copy = arena_alloc(&pool->arena, len * elem_size);
+        if (!copy) return 1;
+        memcpy(copy, elems, len * elem_size);
+        entry->hash = hash;
+        entry->tag = tag;
+        entry->len = len;
+        entry->elems = copy;
+        pool->n_entries++;
+    }
+    *elems_ptr = entry->elems;
+    return 0;
+}
+
+int tokentree_pool_get_arr(tokentree_pool_t *pool, tokentree_t *elems,
+    size_t len, tokentree_t **elems_ptr
+) {
+    /* Sets *elems_ptr to the pool's copy of the given ARR elements, whose
+    own arrays MUST already be from the pool */
+    void *pooled;
+    int err = tokentree_pool_get(pool, TOKENTREE_TAG_ARR, elems, len,
+        sizeof(*elems), &pooled);
+    if (err) return err;
+    *elems_ptr = pooled;
+    return 0;
+}
+
+int tokentree_pool_get_ints(tokentree_pool_t *pool, int *elems,
+    size_t len, int **elems_ptr
+) {
+    /* Sets *elems_ptr to the pool's copy of the given INTS elements */
+    void *pooled;
+    int err = tokentree_pool_get(pool, TOKENTREE_TAG_INTS, elems, len,
+        sizeof(*elems), &pooled);
+    if (err) return err;
+    *elems_ptr = pooled;
+    return 0;
+}
@@ -53,3 +53,46 @@ void type_func_cleanup(type_func_t *func_f) {
 void type_def_cleanup(type_def_t *def) {
     type_cleanup(&def->type);
 }
+
+
+/* Marking of strings in use, see stringstore_sweep.
+NOTE: referenced defs (e.g. the def of a field's type) are not marked
+recursively; every def is expected to be marked by its owner (i.e. by
+compiler_mark_strings). */
+
+void type_mark_strings(type_t *type, stringstore_t *store) {
+    switch (type->tag) {
+        case TYPE_TAG_ARRAY:
+            type_mark_strings(&type->u.array_f.subtype_ref->type, store);
+            break;
+        case TYPE_TAG_STRUCT: case TYPE_TAG_UNION: {
+            type_struct_t *struct_f = &type->u.struct_f;
+            stringstore_mark(store, struct_f->tags_name);
+            ARRAY_FOR(type_field_t, struct_f->fields, field) {
+                stringstore_mark(store, field->name);
+                stringstore_mark(store, field->tag_name);
+                type_mark_strings(&field->ref.type, store);
+            }
+            break;
+        }
+        case TYPE_TAG_FUNC: {
+            type_func_t *func_f = &type->u.func_f;
+            type_mark_strings(func_f->ret, store);
+            ARRAY_FOR(type_arg_t, func_f->args, arg) {
+                stringstore_mark(store, arg->name);
+                type_mark_strings(&arg->type, store);
+            }
+            break;
+        }
+        case TYPE_TAG_EXTERN:
+            stringstore_mark(store, type->u.extern_f.extern_name);
+            break;
+        default: break;
+    }
+}
+
+void type_def_mark_strings(type_def_t *def, stringstore_t *store) {
+    stringstore_mark(store, def->name);
+    stringstore_mark(store, def->name_upper);
+    type_mark_strings(&def->type, store);
+}
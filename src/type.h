@@ -3,6 +3,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 
 #include "array.h"
@@ -173,6 +174,7 @@ struct type_ref {
 /* Represents a field of a struct/union */
 struct type_field {
     const char *name;
+    uint32_t name_id; /* stringstore_id of name */
     type_ref_t ref;
 
     /* E.g. if parent struct's name is "my_struct", and field's name is
@@ -183,6 +185,7 @@ struct type_field {
 /* Represents a function argument */
 struct type_arg {
     const char *name;
+    uint32_t name_id; /* stringstore_id of name */
 
     /* Whether this is an "out argument", that is, a pointer to type */
     int
@@ -197,6 +200,7 @@ Also used to represent struct/union tags, see type_{array,struct,union}_t's
 "def" field */
 struct type_def {
     const char *name;
+    uint32_t name_id; /* stringstore_id of name */
     const char *name_upper; /* name converted to uppercase */
     type_t type;
 
@@ -207,6 +211,10 @@ struct type_def {
 };
 
 
+void type_mark_strings(type_t *type, stringstore_t *store);
+void type_def_mark_strings(type_def_t *def, stringstore_t *store);
+
+
 static type_def_t *type_get_def(type_t *type) {
     switch (type->tag) {
         case TYPE_TAG_ARRAY:
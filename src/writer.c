@@ -103,10 +103,54 @@ int writer_write_blockstr(writer_t *writer, const char *s) {
     return 0;
 }
 
+/* Longest possible result of writer_format_int, e.g. "-2147483648" */
+#define WRITER_INT_MAX_LEN 11
+
+static int writer_format_int(char *buf, int i) {
+    /* Writes i in decimal to buf (without a NUL terminator), returning the
+    number of characters written */
+    char digits[WRITER_INT_MAX_LEN];
+    int n_digits = 0;
+    int len = 0;
+    unsigned int u = i < 0? 0u - (unsigned int)i: (unsigned int)i;
+    if (i < 0) buf[len++] = '-';
+    do {
+        digits[n_digits++] = '0' + u % 10;
+        u /= 10;
+    } while (u);
+    while (n_digits) buf[len++] = digits[--n_digits];
+    return len;
+}
+
 int writer_write_int(writer_t *writer, int i) {
     int err = writer_write_separator(writer);
     if (err) return err;
-    _FPRINTF("%i", i)
+    char buf[WRITER_INT_MAX_LEN];
+    int len = writer_format_int(buf, i);
+    if (fwrite(buf, 1, len, writer->file) != len) return 1;
+    writer->needs_space = true;
+    return 0;
+}
+
+int writer_write_ints(writer_t *writer, const int *ints, size_t n_ints) {
+    /* Like calling writer_write_int for each of ints, but they're formatted
+    into a buffer, which is written out a chunk at a time */
+    if (!n_ints) return 0;
+    int err = writer_write_separator(writer);
+    if (err) return err;
+
+    char buf[4096];
+    size_t len = 0;
+    for (size_t i = 0; i < n_ints; i++) {
+        if (len > sizeof(buf) - (WRITER_INT_MAX_LEN + 1)) {
+            if (fwrite(buf, 1, len, writer->file) != len) return 1;
+            len = 0;
+        }
+        if (i) buf[len++] = ' ';
+        len += writer_format_int(buf + len, ints[i]);
+    }
+    if (fwrite(buf, 1, len, writer->file) != len) return 1;
+
     writer->needs_space = true;
     return 0;
 }
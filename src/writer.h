@@ -40,6 +40,7 @@ int writer_write_op(writer_t *writer, const char *op);
 int writer_write_str(writer_t *writer, const char *s);
 int writer_write_blockstr(writer_t *writer, const char *s);
 int writer_write_int(writer_t *writer, int i);
+int writer_write_ints(writer_t *writer, const int *ints, size_t n_ints);
 int writer_write_open(writer_t *writer);
 int writer_write_close(writer_t *writer);
 